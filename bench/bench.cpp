@@ -0,0 +1,192 @@
+#include "bench.hpp"
+#include <json-glib/json-glib.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+
+// ============ Allocation Counting ============
+
+static std::atomic<uint64_t> alloc_count{0};
+static std::atomic<uint64_t> alloc_bytes{0};
+
+static void* counted_alloc(size_t size) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size) { return counted_alloc(size); }
+void* operator new[](size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace Bench {
+
+// A batch runs at least this long, so timer resolution doesn't matter
+static const gint64 MIN_BATCH_US = 20000;
+
+// Batches timed per case; the median is reported
+static const int BATCHES = 5;
+
+static std::string git_commit(const std::string& source_dir) {
+    if (source_dir.empty()) return "unknown";
+
+    const gchar* argv[] = {"git", "-C", source_dir.c_str(), "describe", "--always", "--dirty", nullptr};
+    g_autofree gchar* out = nullptr;
+    gint status = 0;
+    if (!g_spawn_sync(nullptr, const_cast<gchar**>(argv), nullptr, G_SPAWN_SEARCH_PATH | G_SPAWN_STDERR_TO_DEV_NULL,
+                      nullptr, nullptr, &out, nullptr, &status, nullptr) || status != 0 || !out) {
+        return "unknown";
+    }
+    return g_strstrip(out);
+}
+
+Suite::Suite(const char* name, int argc, char** argv)
+    : name_(name), results_dir_("bench-results") {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--results") == 0) {
+            results_dir_ = argv[i + 1];
+        } else if (strcmp(argv[i], "--source") == 0) {
+            source_dir_ = argv[i + 1];
+        } else if (strcmp(argv[i], "--filter") == 0) {
+            filter_ = argv[i + 1];
+        } else {
+            g_printerr("Unknown argument %s\n", argv[i]);
+        }
+    }
+
+    printf("%-40s %12s %14s %10s %10s %12s\n", name, "ns/op", "items/s", "MB/s", "allocs/op", "bytes/op");
+}
+
+void Suite::run(const std::string& name, const std::function<void()>& op, double items, size_t bytes) {
+    if (!filter_.empty() && name.find(filter_) == std::string::npos) return;
+
+    // Warm up and size the batch
+    op();
+    uint64_t iterations = 1;
+    while (true) {
+        gint64 start = g_get_monotonic_time();
+        for (uint64_t i = 0; i < iterations; i++) op();
+        gint64 elapsed = g_get_monotonic_time() - start;
+        if (elapsed >= MIN_BATCH_US) break;
+        iterations *= elapsed > 0 ? std::min<uint64_t>(10, MIN_BATCH_US * 2 / elapsed + 1) : 10;
+    }
+
+    std::vector<double> ns_per_op;
+    uint64_t allocs_before = alloc_count.load();
+    uint64_t bytes_before = alloc_bytes.load();
+    for (int batch = 0; batch < BATCHES; batch++) {
+        gint64 start = g_get_monotonic_time();
+        for (uint64_t i = 0; i < iterations; i++) op();
+        ns_per_op.push_back((g_get_monotonic_time() - start) * 1000.0 / iterations);
+    }
+    double calls = static_cast<double>(iterations) * BATCHES;
+
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+    Result result;
+    result.name = name;
+    result.ns_per_op = ns_per_op[BATCHES / 2];
+    result.items_per_sec = items * 1e9 / result.ns_per_op;
+    result.mb_per_sec = bytes * 1e9 / result.ns_per_op / (1024.0 * 1024.0);
+    result.allocs_per_op = (alloc_count.load() - allocs_before) / calls;
+    result.alloc_bytes_per_op = (alloc_bytes.load() - bytes_before) / calls;
+    results_.push_back(result);
+
+    printf("%-40s %12.0f %14.0f %10.1f %10.1f %12.0f\n", name.c_str(), result.ns_per_op,
+           result.items_per_sec, result.mb_per_sec, result.allocs_per_op, result.alloc_bytes_per_op);
+    fflush(stdout);
+}
+
+static std::map<std::string, std::pair<double, double>> read_previous(const std::string& path,
+                                                                      std::string* commit) {
+    std::map<std::string, std::pair<double, double>> previous;
+    g_autoptr(JsonParser) parser = json_parser_new();
+    if (!json_parser_load_from_file(parser, path.c_str(), nullptr)) return previous;
+
+    JsonNode* root = json_parser_get_root(parser);
+    if (!JSON_NODE_HOLDS_OBJECT(root)) return previous;
+    JsonObject* obj = json_node_get_object(root);
+    *commit = json_object_get_string_member_with_default(obj, "commit", "unknown");
+
+    JsonArray* results = json_object_get_array_member(obj, "results");
+    for (guint i = 0; results && i < json_array_get_length(results); i++) {
+        JsonObject* result = json_array_get_object_element(results, i);
+        previous[json_object_get_string_member_with_default(result, "name", "")] = {
+            json_object_get_double_member_with_default(result, "ns_per_op", 0),
+            json_object_get_double_member_with_default(result, "allocs_per_op", 0),
+        };
+    }
+    return previous;
+}
+
+int Suite::finish() {
+    g_mkdir_with_parents(results_dir_.c_str(), 0755);
+    std::string commit = git_commit(source_dir_);
+    std::string latest = results_dir_ + "/" + name_ + "-latest.json";
+
+    std::string previous_commit;
+    auto previous = read_previous(latest, &previous_commit);
+    if (!previous.empty()) {
+        printf("\ncompared with %s\n", previous_commit.c_str());
+        for (const auto& result : results_) {
+            auto it = previous.find(result.name);
+            if (it == previous.end() || it->second.first <= 0) continue;
+            printf("%-40s %+8.1f%% time %+10.1f allocs/op\n", result.name.c_str(),
+                   (result.ns_per_op / it->second.first - 1.0) * 100.0,
+                   result.allocs_per_op - it->second.second);
+        }
+    }
+
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "suite");
+    json_builder_add_string_value(builder, name_.c_str());
+    json_builder_set_member_name(builder, "commit");
+    json_builder_add_string_value(builder, commit.c_str());
+    json_builder_set_member_name(builder, "time");
+    json_builder_add_int_value(builder, g_get_real_time() / G_USEC_PER_SEC);
+    json_builder_set_member_name(builder, "results");
+    json_builder_begin_array(builder);
+    for (const auto& result : results_) {
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "name");
+        json_builder_add_string_value(builder, result.name.c_str());
+        json_builder_set_member_name(builder, "ns_per_op");
+        json_builder_add_double_value(builder, result.ns_per_op);
+        json_builder_set_member_name(builder, "items_per_sec");
+        json_builder_add_double_value(builder, result.items_per_sec);
+        json_builder_set_member_name(builder, "mb_per_sec");
+        json_builder_add_double_value(builder, result.mb_per_sec);
+        json_builder_set_member_name(builder, "allocs_per_op");
+        json_builder_add_double_value(builder, result.allocs_per_op);
+        json_builder_set_member_name(builder, "alloc_bytes_per_op");
+        json_builder_add_double_value(builder, result.alloc_bytes_per_op);
+        json_builder_end_object(builder);
+    }
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+    json_generator_set_pretty(generator, TRUE);
+
+    for (const std::string& path : {results_dir_ + "/" + name_ + "-" + commit + ".json", latest}) {
+        g_autoptr(GError) error = nullptr;
+        if (!json_generator_to_file(generator, path.c_str(), &error)) {
+            g_printerr("Failed to write %s: %s\n", path.c_str(), error->message);
+            return 1;
+        }
+    }
+    printf("\nresults written to %s\n", latest.c_str());
+    return 0;
+}
+
+} // namespace Bench
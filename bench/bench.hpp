@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+/**
+ * Runs timed cases and reports time, throughput and C++ heap allocations
+ * per operation (operator new is counted; GLib's g_malloc, used inside
+ * json-glib, is not).
+ *
+ * Results are written to <results>/<suite>-<commit>.json and
+ * <suite>-latest.json, and compared against the previous latest run.
+ * Arguments: --results DIR (default bench-results), --source DIR (the
+ * git checkout the commit is read from), --filter SUBSTRING.
+ */
+class Suite {
+public:
+    Suite(const char* name, int argc, char** argv);
+
+    /**
+     * Time op, called repeatedly. items is how many things one call
+     * handles (entries, lookups) and bytes how much input it reads,
+     * for the throughput columns.
+     */
+    void run(const std::string& name, const std::function<void()>& op,
+             double items = 1, size_t bytes = 0);
+
+    /**
+     * Print the comparison and store the results; returns the exit code
+     */
+    int finish();
+
+private:
+    struct Result {
+        std::string name;
+        double ns_per_op;
+        double items_per_sec;
+        double mb_per_sec;
+        double allocs_per_op;
+        double alloc_bytes_per_op;
+    };
+
+    std::string name_;
+    std::string results_dir_;
+    std::string source_dir_;
+    std::string filter_;
+    std::vector<Result> results_;
+};
+
+/**
+ * Keep the compiler from dropping a result nobody reads
+ */
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace Bench
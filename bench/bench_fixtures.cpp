@@ -0,0 +1,303 @@
+#include "bench_fixtures.hpp"
+#include <glib/gstdio.h>
+
+const char *GENRES[] = {
+    "Action", "Adventure", "Animation", "Comedy", "Crime", "Documentary", "Drama",
+    "Family", "Fantasy", "History", "Horror", "Music", "Mystery", "Romance",
+    "Sci-Fi", "Sport", "Thriller", "War", "Western",
+};
+
+void write_json(JsonBuilder *builder, const std::string& path) {
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+
+    g_autoptr(GError) error = nullptr;
+    if (!json_generator_to_file(generator, path.c_str(), &error)) {
+        g_error("Failed to write %s: %s", path.c_str(), error->message);
+    }
+}
+
+void add_strings(JsonBuilder *builder, const char *name, const std::vector<std::string>& values) {
+    json_builder_set_member_name(builder, name);
+    json_builder_begin_array(builder);
+    for (const auto& value : values) json_builder_add_string_value(builder, value.c_str());
+    json_builder_end_array(builder);
+}
+
+// Addons shaped like popular catalog addons: a dozen catalogs each with
+// genre, skip and search extras
+void write_addons(const std::string& path, int count) {
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "version");
+    json_builder_add_int_value(builder, 1);
+    json_builder_set_member_name(builder, "addons");
+    json_builder_begin_array(builder);
+
+    for (int i = 0; i < count; i++) {
+        std::string id = "org.bench.addon" + std::to_string(i);
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "transport_url");
+        json_builder_add_string_value(builder, ("https://addon" + std::to_string(i) + ".example.com/manifest.json").c_str());
+
+        json_builder_set_member_name(builder, "manifest");
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "id");
+        json_builder_add_string_value(builder, id.c_str());
+        json_builder_set_member_name(builder, "version");
+        json_builder_add_string_value(builder, "1.0.0");
+        json_builder_set_member_name(builder, "name");
+        json_builder_add_string_value(builder, ("Bench Addon " + std::to_string(i)).c_str());
+        json_builder_set_member_name(builder, "description");
+        json_builder_add_string_value(builder, "Generated for the startup benchmark");
+        add_strings(builder, "types", {"movie", "series"});
+        add_strings(builder, "resources", {"catalog", "meta", "stream"});
+        add_strings(builder, "idPrefixes", {"tt"});
+
+        json_builder_set_member_name(builder, "catalogs");
+        json_builder_begin_array(builder);
+        for (int c = 0; c < 12; c++) {
+            json_builder_begin_object(builder);
+            json_builder_set_member_name(builder, "type");
+            json_builder_add_string_value(builder, c % 2 ? "series" : "movie");
+            json_builder_set_member_name(builder, "id");
+            json_builder_add_string_value(builder, ("catalog" + std::to_string(c)).c_str());
+            json_builder_set_member_name(builder, "name");
+            json_builder_add_string_value(builder, ("Catalog " + std::to_string(c)).c_str());
+
+            json_builder_set_member_name(builder, "extra");
+            json_builder_begin_array(builder);
+            json_builder_begin_object(builder);
+            json_builder_set_member_name(builder, "name");
+            json_builder_add_string_value(builder, "genre");
+            json_builder_set_member_name(builder, "options");
+            json_builder_begin_array(builder);
+            for (const char *genre : GENRES) json_builder_add_string_value(builder, genre);
+            json_builder_end_array(builder);
+            json_builder_end_object(builder);
+            for (const char *name : {"skip", "search"}) {
+                json_builder_begin_object(builder);
+                json_builder_set_member_name(builder, "name");
+                json_builder_add_string_value(builder, name);
+                json_builder_end_object(builder);
+            }
+            json_builder_end_array(builder);
+            json_builder_end_object(builder);
+        }
+        json_builder_end_array(builder);
+        json_builder_end_object(builder);
+
+        json_builder_set_member_name(builder, "enabled");
+        json_builder_add_boolean_value(builder, TRUE);
+        json_builder_set_member_name(builder, "order");
+        json_builder_add_int_value(builder, i);
+        json_builder_set_member_name(builder, "installed_at");
+        json_builder_add_string_value(builder, "2024-01-01T00:00:00Z");
+        json_builder_end_object(builder);
+    }
+
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+    write_json(builder, path);
+}
+
+// Mostly series episodes, as a long-time user's history is
+void write_history(const std::string& path, int count) {
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_array(builder);
+
+    for (int i = 0; i < count; i++) {
+        bool movie = i % 10 == 0;
+        std::string meta_id = "tt" + std::to_string(1000000 + i / 20);
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "meta_id");
+        json_builder_add_string_value(builder, meta_id.c_str());
+        json_builder_set_member_name(builder, "meta_type");
+        json_builder_add_string_value(builder, movie ? "movie" : "series");
+        json_builder_set_member_name(builder, "video_id");
+        json_builder_add_string_value(builder, (movie ? meta_id : meta_id + ":1:" + std::to_string(i % 20 + 1)).c_str());
+        json_builder_set_member_name(builder, "title");
+        json_builder_add_string_value(builder, ("Episode " + std::to_string(i)).c_str());
+        json_builder_set_member_name(builder, "poster_url");
+        json_builder_add_string_value(builder, ("https://images.example.com/poster/" + meta_id + ".jpg").c_str());
+        if (!movie) {
+            json_builder_set_member_name(builder, "series_title");
+            json_builder_add_string_value(builder, ("Series " + meta_id).c_str());
+            json_builder_set_member_name(builder, "season");
+            json_builder_add_int_value(builder, 1);
+            json_builder_set_member_name(builder, "episode");
+            json_builder_add_int_value(builder, i % 20 + 1);
+        }
+        json_builder_set_member_name(builder, "position");
+        json_builder_add_double_value(builder, 600.0 + i % 1800);
+        json_builder_set_member_name(builder, "duration");
+        json_builder_add_double_value(builder, 2700.0);
+        json_builder_set_member_name(builder, "last_watched");
+        json_builder_add_int_value(builder, 1700000000 + i * 60);
+        json_builder_end_object(builder);
+    }
+
+    json_builder_end_array(builder);
+    write_json(builder, path);
+}
+
+void remove_tree(const std::string& path) {
+    if (GDir *dir = g_dir_open(path.c_str(), 0, nullptr)) {
+        while (const char *name = g_dir_read_name(dir)) {
+            remove_tree(path + "/" + name);
+        }
+        g_dir_close(dir);
+    }
+    g_remove(path.c_str());
+}
+
+std::string make_scratch_home() {
+    g_autoptr(GError) error = nullptr;
+    g_autofree gchar *root = g_dir_make_tmp("madari-bench-XXXXXX", &error);
+    if (!root) g_error("Failed to create a scratch dir: %s", error->message);
+    g_setenv("XDG_DATA_HOME", root, TRUE);
+    g_setenv("XDG_CACHE_HOME", root, TRUE);
+    return root;
+}
+
+static std::string to_json(JsonBuilder *builder) {
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+    g_autofree gchar *json = json_generator_to_data(generator, nullptr);
+    return json;
+}
+
+static void add_string(JsonBuilder *builder, const char *name, const std::string& value) {
+    json_builder_set_member_name(builder, name);
+    json_builder_add_string_value(builder, value.c_str());
+}
+
+static std::string imdb_id(int i) {
+    return "tt" + std::to_string(1000000 + i * 37);
+}
+
+static std::vector<std::string> genres_for(int i) {
+    return {GENRES[i % 19], GENRES[(i * 7 + 3) % 19]};
+}
+
+static const char *DESCRIPTION =
+    "When a retired detective is pulled back for one last case, the trail leads "
+    "through a small coastal town where everyone remembers a different version "
+    "of the night the lighthouse went dark.";
+
+std::string catalog_json(int count) {
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "metas");
+    json_builder_begin_array(builder);
+
+    for (int i = 0; i < count; i++) {
+        std::string id = imdb_id(i);
+        json_builder_begin_object(builder);
+        add_string(builder, "id", id);
+        add_string(builder, "type", "movie");
+        add_string(builder, "name", "Movie Title " + std::to_string(i));
+        add_string(builder, "poster", "https://images.metahub.space/poster/small/" + id + "/img");
+        add_string(builder, "background", "https://images.metahub.space/background/medium/" + id + "/img");
+        add_string(builder, "logo", "https://images.metahub.space/logo/medium/" + id + "/img");
+        add_string(builder, "description", DESCRIPTION);
+        add_string(builder, "releaseInfo", std::to_string(1980 + i % 45));
+        add_string(builder, "imdbRating", std::to_string(5 + i % 5) + "." + std::to_string(i % 10));
+        add_strings(builder, "genres", genres_for(i));
+        add_strings(builder, "director", {"Director " + std::to_string(i % 50)});
+        add_strings(builder, "cast", {"Actor " + std::to_string(i % 80), "Actor " + std::to_string(i % 80 + 1),
+                                      "Actor " + std::to_string(i % 80 + 2)});
+        json_builder_end_object(builder);
+    }
+
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+    return to_json(builder);
+}
+
+std::string meta_json(int videos) {
+    std::string id = imdb_id(7);
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "meta");
+    json_builder_begin_object(builder);
+    add_string(builder, "id", id);
+    add_string(builder, "type", "series");
+    add_string(builder, "name", "Series Title");
+    add_string(builder, "poster", "https://images.metahub.space/poster/small/" + id + "/img");
+    add_string(builder, "background", "https://images.metahub.space/background/medium/" + id + "/img");
+    add_string(builder, "logo", "https://images.metahub.space/logo/medium/" + id + "/img");
+    add_string(builder, "description", DESCRIPTION);
+    add_string(builder, "releaseInfo", "2008-2013");
+    add_string(builder, "imdbRating", "9.5");
+    add_string(builder, "runtime", "49 min");
+    add_string(builder, "country", "United States");
+    add_strings(builder, "genres", {"Crime", "Drama", "Thriller"});
+    add_strings(builder, "director", {"Director One"});
+    add_strings(builder, "writer", {"Writer One", "Writer Two"});
+    add_strings(builder, "cast", {"Actor One", "Actor Two", "Actor Three", "Actor Four"});
+
+    json_builder_set_member_name(builder, "videos");
+    json_builder_begin_array(builder);
+    for (int i = 0; i < videos; i++) {
+        int season = i / 20 + 1;
+        int episode = i % 20 + 1;
+        json_builder_begin_object(builder);
+        add_string(builder, "id", id + ":" + std::to_string(season) + ":" + std::to_string(episode));
+        add_string(builder, "title", "Episode " + std::to_string(episode));
+        add_string(builder, "released", "2010-0" + std::to_string(1 + i % 9) + "-1" + std::to_string(i % 10) + "T00:00:00.000Z");
+        add_string(builder, "thumbnail", "https://episodes.metahub.space/" + id + "/" + std::to_string(season) + "/" +
+                                         std::to_string(episode) + "/w780.jpg");
+        add_string(builder, "overview", DESCRIPTION);
+        json_builder_set_member_name(builder, "season");
+        json_builder_add_int_value(builder, season);
+        json_builder_set_member_name(builder, "episode");
+        json_builder_add_int_value(builder, episode);
+        json_builder_end_object(builder);
+    }
+    json_builder_end_array(builder);
+
+    json_builder_end_object(builder);
+    json_builder_end_object(builder);
+    return to_json(builder);
+}
+
+std::string streams_json(int count) {
+    static const char *QUALITIES[] = {"2160p", "1080p", "720p", "480p"};
+    static const char *SOURCES[] = {"ThePirateBay", "RARBG", "1337x", "YTS", "EZTV"};
+
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "streams");
+    json_builder_begin_array(builder);
+
+    for (int i = 0; i < count; i++) {
+        const char *quality = QUALITIES[i % 4];
+        std::string file = std::string("Series.Title.S01E05.") + quality + ".WEB-DL.x265.10bit-GROUP" +
+                           std::to_string(i) + ".mkv";
+        g_autofree gchar *hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, file.c_str(), -1);
+
+        json_builder_begin_object(builder);
+        add_string(builder, "name", std::string("Torrentio\n") + quality);
+        add_string(builder, "title", file + "\n\xf0\x9f\x91\xa4 " + std::to_string(500 - i % 500) + " \xf0\x9f\x92\xbe " +
+                                     std::to_string(1 + i % 9) + ".4 GB \xe2\x9a\x99\xef\xb8\x8f " + SOURCES[i % 5]);
+        add_string(builder, "infoHash", hash);
+        json_builder_set_member_name(builder, "fileIdx");
+        json_builder_add_int_value(builder, i % 8);
+        json_builder_set_member_name(builder, "behaviorHints");
+        json_builder_begin_object(builder);
+        add_string(builder, "bingeGroup", std::string("torrentio|") + quality + "|WEB-DL");
+        add_string(builder, "filename", file);
+        json_builder_set_member_name(builder, "videoSize");
+        json_builder_add_int_value(builder, (1 + i % 9) * G_GINT64_CONSTANT(1073741824));
+        json_builder_end_object(builder);
+        add_strings(builder, "sources", {"tracker:udp://tracker.opentrackr.org:1337/announce", "dht:" + std::string(hash)});
+        json_builder_end_object(builder);
+    }
+
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+    return to_json(builder);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * Generated inputs shared by the benchmarks: service files shaped like a
+ * long-time user's, and addon responses shaped like Cinemeta's and
+ * Torrentio's, at any size.
+ */
+
+#include <json-glib/json-glib.h>
+#include <string>
+#include <vector>
+
+extern const char *GENRES[19];
+
+void write_json(JsonBuilder *builder, const std::string& path);
+void add_strings(JsonBuilder *builder, const char *name, const std::vector<std::string>& values);
+
+/**
+ * addons.json with count catalog addons, a dozen catalogs each
+ */
+void write_addons(const std::string& path, int count);
+
+/**
+ * watch_history.json with count entries, mostly series episodes
+ */
+void write_history(const std::string& path, int count);
+
+void remove_tree(const std::string& path);
+
+/**
+ * Point XDG_DATA_HOME and XDG_CACHE_HOME at a new scratch dir, so services
+ * keep their files there; returns the dir
+ */
+std::string make_scratch_home();
+
+/**
+ * A catalog page with count metas
+ */
+std::string catalog_json(int count);
+
+/**
+ * A series meta with count episodes
+ */
+std::string meta_json(int videos);
+
+/**
+ * A stream list with count torrent streams
+ */
+std::string streams_json(int count);
@@ -0,0 +1,88 @@
+/**
+ * Watch history benchmarks at 10k entries: progress updates as the player
+ * sends them, lookups as the detail and catalog views make them, and saves.
+ *
+ * Usage: bench-history [--results DIR] [--source DIR] [--filter SUBSTRING]
+ */
+
+#include "bench.hpp"
+#include "bench_fixtures.hpp"
+#include "watch_history.hpp"
+
+using namespace Madari;
+
+static const int ENTRIES = 10000;
+
+// Same ids as write_history writes
+static std::string meta_id(int i) {
+    return "tt" + std::to_string(1000000 + i / 20);
+}
+
+static std::string video_id(int i) {
+    return i % 10 == 0 ? meta_id(i) : meta_id(i) + ":1:" + std::to_string(i % 20 + 1);
+}
+
+int main(int argc, char **argv) {
+    Bench::Suite suite("history", argc, argv);
+
+    std::string root = make_scratch_home();
+    std::string data_dir = root + "/madari";
+    g_mkdir_with_parents(data_dir.c_str(), 0755);
+    write_history(data_dir + "/watch_history.json", ENTRIES);
+
+    // Spread over the list: recent entries are found early, old ones late
+    std::vector<std::pair<std::string, std::string>> keys;
+    for (int i = 0; i < ENTRIES; i += ENTRIES / 100) {
+        keys.emplace_back(meta_id(i), video_id(i));
+    }
+    size_t next = 0;
+
+    // Lookups first, on the order as saved: update_progress moves entries
+    // to the front, which would shift where the keys are found
+    {
+        WatchHistoryService history;
+        history.load();
+
+        suite.run("get_entry/hit", [&]() {
+            const auto& [meta, video] = keys[next++ % keys.size()];
+            Bench::keep(history.get_entry(meta, video));
+        });
+        suite.run("get_entry/miss", [&]() {
+            Bench::keep(history.get_entry("tt9999999", "tt9999999:1:1"));
+        });
+        suite.run("get_latest_for_series", [&]() {
+            Bench::keep(history.get_latest_for_series(keys[next++ % keys.size()].first));
+        });
+        suite.run("get_continue_watching", [&]() {
+            Bench::keep(history.get_continue_watching());
+        });
+    }
+
+    // Changes schedule a save on the main loop, which never runs here, so
+    // the update cases time the update alone
+    WatchHistoryService history;
+    history.load();
+
+    suite.run("update_position", [&]() {
+        const auto& [meta, video] = keys[next++ % keys.size()];
+        history.update_position(meta, video, 1200.0, 2700.0);
+    });
+
+    // Updating an existing entry moves it to the front
+    suite.run("update_progress/existing", [&]() {
+        const auto& [meta, video] = keys[next++ % keys.size()];
+        WatchHistoryEntry entry{};
+        entry.meta_id = meta;
+        entry.meta_type = "series";
+        entry.video_id = video;
+        entry.title = "Episode";
+        entry.position = 1200.0;
+        entry.duration = 2700.0;
+        history.update_progress(entry);
+    });
+
+    suite.run("save", [&]() { history.save(); }, ENTRIES);
+
+    remove_tree(root);
+    return suite.finish();
+}
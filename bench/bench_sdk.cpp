@@ -0,0 +1,151 @@
+/**
+ * Stremio SDK benchmarks: response parsing at increasing sizes, stream
+ * ranking up to thousands of streams, addon lookup with 50 installed
+ * addons, local search over a full index, and request URL building.
+ *
+ * Usage: bench-sdk [--results DIR] [--source DIR] [--filter SUBSTRING]
+ */
+
+#include "bench.hpp"
+#include "bench_fixtures.hpp"
+#include "stremio/stremio_addon_service.hpp"
+#include "stremio/stremio_client.hpp"
+#include "stremio/stremio_local_index.hpp"
+#include "stremio/stremio_parser.hpp"
+#include "stremio/stremio_stream_ranker.hpp"
+
+using namespace Stremio;
+
+static void bench_parser(Bench::Suite& suite) {
+    // Sizes from a short list page to a big catalog, a long-running series,
+    // and a popular episode's stream list
+    for (int count : {20, 100, 500}) {
+        std::string json = catalog_json(count);
+        suite.run("parse_catalog/" + std::to_string(count), [&]() {
+            Bench::keep(Parser::parse_catalog(json));
+        }, count, json.size());
+    }
+
+    for (int count : {10, 100, 1000}) {
+        std::string json = meta_json(count);
+        suite.run("parse_meta/" + std::to_string(count), [&]() {
+            Bench::keep(Parser::parse_meta(json));
+        }, 1, json.size());
+    }
+
+    for (int count : {10, 100, 500}) {
+        std::string json = streams_json(count);
+        suite.run("parse_streams/" + std::to_string(count), [&]() {
+            Bench::keep(Parser::parse_streams(json));
+        }, count, json.size());
+    }
+}
+
+static void bench_ranker(Bench::Suite& suite) {
+    const int ADDONS = 10;
+
+    std::vector<Manifest> addons(ADDONS + 1);
+    for (int i = 0; i <= ADDONS; i++) {
+        addons[i].id = "addon." + std::to_string(i);
+        addons[i].name = "Addon " + std::to_string(i);
+    }
+
+    // A popular episode with many addons installed: streams spread over
+    // the addons as they answer, then a mirror re-offering every fourth
+    // one, which takes the duplicate path
+    for (int count : {100, 1000, 5000}) {
+        auto response = Parser::parse_streams(streams_json(count));
+        std::vector<std::vector<Stream>> batches(ADDONS + 1);
+        for (int i = 0; i < count; i++) {
+            const Stream& stream = response->streams[i];
+            batches[i % ADDONS].push_back(stream);
+            if (i % 4 == 0) batches[ADDONS].push_back(stream);
+        }
+
+        suite.run("rank_streams/" + std::to_string(count), [&]() {
+            StreamRanker ranker;
+            for (int i = 0; i <= ADDONS; i++) {
+                ranker.add_batch(addons[i], batches[i]);
+            }
+            Bench::keep(ranker.size());
+        }, count);
+    }
+}
+
+static void bench_addons(Bench::Suite& suite) {
+    std::string root = make_scratch_home();
+    std::string data_dir = root + "/madari";
+    g_mkdir_with_parents(data_dir.c_str(), 0755);
+    write_addons(data_dir + "/addons.json", 50);
+
+    AddonService service;
+    service.load();
+
+    suite.run("get_addons_for_resource/meta", [&]() {
+        Bench::keep(service.get_addons_for_resource("meta", "series", "tt0903747"));
+    });
+    suite.run("get_addons_for_resource/stream", [&]() {
+        Bench::keep(service.get_addons_for_resource("stream", "movie", "tt0111161"));
+    });
+    suite.run("get_addons_for_resource/no_match", [&]() {
+        Bench::keep(service.get_addons_for_resource("subtitles", "movie", "kitsu:1"));
+    });
+
+    remove_tree(root);
+}
+
+static void bench_local_index(Bench::Suite& suite) {
+    const int DOCUMENTS = 20000;
+
+    // The index makes its cache dir; it never saves without load()
+    std::string root = make_scratch_home();
+    LocalIndex index(DOCUMENTS);
+    index.add(Parser::parse_catalog(catalog_json(DOCUMENTS))->metas);
+
+    // Titles end in their number, so one leading digit covers ~11k terms:
+    // the fuzzy case checks every one of similar length
+    suite.run("local_index_search/prefix", [&]() {
+        Bench::keep(index.search("123"));
+    });
+    suite.run("local_index_search/fuzzy", [&]() {
+        Bench::keep(index.search("12x45"));
+    });
+    suite.run("local_index_search/multi_word", [&]() {
+        Bench::keep(index.search("movie title 1234"));
+    });
+
+    remove_tree(root);
+}
+
+static void bench_urls(Bench::Suite& suite) {
+    Manifest manifest;
+    manifest.transport_url = "https://v3-cinemeta.strem.io/manifest.json";
+
+    ExtraArgs empty;
+    ExtraArgs page;
+    page.genre = "Sci-Fi";
+    page.skip = 100;
+    ExtraArgs search;
+    search.search = "the lord of the rings: return of the king";
+
+    suite.run("to_path_segment/empty", [&]() { Bench::keep(empty.to_path_segment()); });
+    suite.run("to_path_segment/genre_skip", [&]() { Bench::keep(page.to_path_segment()); });
+    suite.run("to_path_segment/search", [&]() { Bench::keep(search.to_path_segment()); });
+
+    suite.run("catalog_url/first_page", [&]() {
+        Bench::keep(Client::catalog_url(manifest, "movie", "top", empty));
+    });
+    suite.run("catalog_url/genre_skip", [&]() {
+        Bench::keep(Client::catalog_url(manifest, "movie", "top", page));
+    });
+}
+
+int main(int argc, char **argv) {
+    Bench::Suite suite("sdk", argc, argv);
+    bench_parser(suite);
+    bench_ranker(suite);
+    bench_addons(suite);
+    bench_local_index(suite);
+    bench_urls(suite);
+    return suite.finish();
+}
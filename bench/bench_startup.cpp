@@ -0,0 +1,134 @@
+/**
+ * Startup benchmark: how long the main thread is held by service loading
+ * with large addon and history files, loading one service after another
+ * (the old startup) against loading them on workers.
+ *
+ * Usage: bench-startup [addons] [history-entries] [runs]
+ */
+
+#include "stremio/stremio_addon_service.hpp"
+#include "trakt/trakt_service.hpp"
+#include "watch_history.hpp"
+#include "source_stats.hpp"
+#include "bench_fixtures.hpp"
+#include <glib/gstdio.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static double elapsed_ms(gint64 since) {
+    return (g_get_monotonic_time() - since) / 1000.0;
+}
+
+struct Services {
+    Stremio::AddonService *addons = new Stremio::AddonService();
+    Madari::WatchHistoryService *history = new Madari::WatchHistoryService();
+    Madari::SourceStatsService *stats = new Madari::SourceStatsService();
+    Trakt::TraktService *trakt = new Trakt::TraktService();
+
+    ~Services() {
+        delete trakt;
+        delete stats;
+        delete history;
+        delete addons;
+    }
+};
+
+// Old startup: each file parsed on the main thread before the window shows
+static double run_sequential() {
+    Services services;
+    gint64 start = g_get_monotonic_time();
+    services.addons->load();
+    services.history->load();
+    services.stats->load();
+    services.trakt->load();
+    return elapsed_ms(start);
+}
+
+struct ParallelRun {
+    double blocked_ms;      // Until the window could be presented
+    double addons_ms;       // Until catalogs could be laid out
+    double all_ms;          // Until every service was ready
+};
+
+static ParallelRun run_parallel() {
+    Services services;
+    ParallelRun run{};
+    int pending = 3;
+
+    g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, FALSE);
+    gint64 start = g_get_monotonic_time();
+    services.addons->load_async();
+    services.history->load_async();
+    services.stats->load_async();
+    services.trakt->load_async();
+    run.blocked_ms = elapsed_ms(start);
+
+    auto done = [&]() {
+        if (--pending == 0) {
+            run.all_ms = elapsed_ms(start);
+            g_main_loop_quit(loop);
+        }
+    };
+    services.addons->when_ready([&]() {
+        run.addons_ms = elapsed_ms(start);
+        done();
+    });
+    services.history->when_ready(done);
+    services.trakt->when_ready(done);
+
+    g_main_loop_run(loop);
+
+    // Let the search index read finish before the services go away
+    while (g_main_context_iteration(nullptr, FALSE)) {}
+    return run;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main(int argc, char **argv) {
+    int addon_count = argc > 1 ? std::atoi(argv[1]) : 50;
+    int history_count = argc > 2 ? std::atoi(argv[2]) : 20000;
+    int runs = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    // Services keep their files under the XDG dirs; point them at scratch
+    g_autoptr(GError) error = nullptr;
+    g_autofree gchar *root = g_dir_make_tmp("madari-bench-XXXXXX", &error);
+    if (!root) g_error("Failed to create a scratch dir: %s", error->message);
+    g_setenv("XDG_DATA_HOME", root, TRUE);
+    g_setenv("XDG_CACHE_HOME", root, TRUE);
+
+    std::string data_dir = std::string(root) + "/madari";
+    g_mkdir_with_parents(data_dir.c_str(), 0755);
+    write_addons(data_dir + "/addons.json", addon_count);
+    write_history(data_dir + "/watch_history.json", history_count);
+
+    GStatBuf addons_stat, history_stat;
+    g_stat((data_dir + "/addons.json").c_str(), &addons_stat);
+    g_stat((data_dir + "/watch_history.json").c_str(), &history_stat);
+    printf("addons.json: %d addons, %.1f KiB\n", addon_count, addons_stat.st_size / 1024.0);
+    printf("watch_history.json: %d entries, %.1f KiB\n", history_count, history_stat.st_size / 1024.0);
+
+    std::vector<double> sequential, blocked, addons_ready, all_ready;
+    for (int i = 0; i < runs; i++) {
+        sequential.push_back(run_sequential());
+        ParallelRun run = run_parallel();
+        blocked.push_back(run.blocked_ms);
+        addons_ready.push_back(run.addons_ms);
+        all_ready.push_back(run.all_ms);
+    }
+
+    printf("median of %d runs\n", runs);
+    printf("  sequential load, main thread blocked: %8.2f ms\n", median(sequential));
+    printf("  worker load, main thread blocked:     %8.2f ms\n", median(blocked));
+    printf("  worker load, addons ready:            %8.2f ms\n", median(addons_ready));
+    printf("  worker load, all services ready:      %8.2f ms\n", median(all_ready));
+
+    remove_tree(root);
+    return 0;
+}
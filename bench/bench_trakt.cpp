@@ -0,0 +1,30 @@
+/**
+ * Trakt benchmarks: Stremio id parsing, done for every scrobble and
+ * history sync item.
+ *
+ * Usage: bench-trakt [--results DIR] [--source DIR] [--filter SUBSTRING]
+ */
+
+#include "bench.hpp"
+#include "trakt/trakt_types.hpp"
+
+int main(int argc, char **argv) {
+    Bench::Suite suite("trakt", argc, argv);
+
+    const std::pair<const char*, const char*> IDS[] = {
+        {"imdb_movie", "tt0111161"},
+        {"imdb_episode", "tt0903747:5:14"},
+        {"tmdb_episode", "tmdb:1396:5:14"},
+        {"kitsu_episode", "kitsu:7442:12"},
+        {"unknown", "yt_id:UCxyz"},
+    };
+
+    for (const auto& [name, id] : IDS) {
+        std::string value = id;
+        suite.run(std::string("parse_stremio_id/") + name, [&]() {
+            Bench::keep(Trakt::parse_stremio_id(value));
+        });
+    }
+
+    return suite.finish();
+}
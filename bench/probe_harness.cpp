@@ -0,0 +1,258 @@
+/**
+ * Stream probe harness: runs StreamProbe against a local SoupServer whose
+ * endpoints answer fast, late, throttled, stalled, never or with an error,
+ * and checks the TTFB, throughput and deadline behaviour it reports.
+ *
+ * Usage: probe-harness
+ */
+
+#include "stremio/stremio_stream_probe.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Stremio;
+
+static const size_t RANGE_BYTES = 256 * 1024;
+static const guint DEADLINE_MS = 2000;
+static const guint HEADERS_DELAY_MS = 300;
+static const gsize THROTTLE_CHUNK = 32 * 1024;
+static const guint THROTTLE_INTERVAL_MS = 100;     // 320 KiB/s
+
+// ============ Server ============
+
+static void pause_message([[maybe_unused]] SoupServer *server, SoupServerMessage *msg) {
+#if SOUP_CHECK_VERSION(3, 2, 0)
+    soup_server_message_pause(msg);
+#else
+    soup_server_pause_message(server, msg);
+#endif
+}
+
+static void unpause_message([[maybe_unused]] SoupServer *server, SoupServerMessage *msg) {
+#if SOUP_CHECK_VERSION(3, 2, 0)
+    soup_server_message_unpause(msg);
+#else
+    soup_server_unpause_message(server, msg);
+#endif
+}
+
+// A response sent a chunk at a time, on a timer
+struct Trickle {
+    SoupServer *server;
+    SoupServerMessage *msg;
+    gsize left;
+    gsize chunk;
+    bool stall;         // Send one chunk, then nothing more
+    bool finished = false;
+};
+
+static void append_zeros(SoupServerMessage *msg, gsize size) {
+    std::string zeros(size, '\0');
+    soup_message_body_append(soup_server_message_get_response_body(msg),
+                             SOUP_MEMORY_COPY, zeros.data(), zeros.size());
+}
+
+static gboolean on_trickle(gpointer user_data) {
+    auto *trickle = static_cast<Trickle *>(user_data);
+    if (trickle->finished) return G_SOURCE_REMOVE;
+
+    gsize size = std::min(trickle->chunk, trickle->left);
+    append_zeros(trickle->msg, size);
+    trickle->left -= size;
+    if (trickle->left == 0) {
+        soup_message_body_complete(soup_server_message_get_response_body(trickle->msg));
+    }
+    unpause_message(trickle->server, trickle->msg);
+    return trickle->left > 0 && !trickle->stall ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+static void start_trickle(SoupServer *server, SoupServerMessage *msg, gsize chunk, bool stall) {
+    soup_server_message_set_status(msg, 206, nullptr);
+    soup_message_headers_set_encoding(soup_server_message_get_response_headers(msg),
+                                      SOUP_ENCODING_CHUNKED);
+
+    auto *trickle = new Trickle{server, msg, RANGE_BYTES, chunk, stall};
+    // The client may hang up first; stop appending to a dead message
+    g_signal_connect_swapped(msg, "finished", G_CALLBACK(+[](Trickle *t) { t->finished = true; }), trickle);
+    g_object_set_data_full(G_OBJECT(msg), "trickle", trickle,
+                           [](gpointer t) { delete static_cast<Trickle *>(t); });
+
+    pause_message(server, msg);
+    on_trickle(trickle);
+    if (!stall && trickle->left > 0) {
+        g_object_ref(msg);
+        g_timeout_add_full(G_PRIORITY_DEFAULT, THROTTLE_INTERVAL_MS, on_trickle, trickle,
+                           [](gpointer t) { g_object_unref(static_cast<Trickle *>(t)->msg); });
+    }
+}
+
+static void send_range(SoupServerMessage *msg) {
+    soup_server_message_set_status(msg, 206, nullptr);
+    append_zeros(msg, RANGE_BYTES);
+}
+
+static void on_request(SoupServer *server, SoupServerMessage *msg, const char *path,
+                       [[maybe_unused]] GHashTable *query, [[maybe_unused]] gpointer user_data) {
+    SoupMessageHeaders *headers = soup_server_message_get_request_headers(msg);
+
+    // Every probe must ask for a range, or it would pull whole files
+    if (!soup_message_headers_get_one(headers, "Range")) {
+        soup_server_message_set_status(msg, 400, nullptr);
+        return;
+    }
+
+    std::string name = path;
+    if (name == "/fast") {
+        send_range(msg);
+    } else if (name == "/late") {
+        pause_message(server, msg);
+        g_object_set_data(G_OBJECT(msg), "server", server);
+        g_object_ref(msg);
+        g_timeout_add_full(G_PRIORITY_DEFAULT, HEADERS_DELAY_MS, [](gpointer m) -> gboolean {
+            auto *msg = static_cast<SoupServerMessage *>(m);
+            send_range(msg);
+            unpause_message(static_cast<SoupServer *>(g_object_get_data(G_OBJECT(msg), "server")), msg);
+            return G_SOURCE_REMOVE;
+        }, msg, g_object_unref);
+    } else if (name == "/throttled") {
+        start_trickle(server, msg, THROTTLE_CHUNK, false);
+    } else if (name == "/stalled") {
+        start_trickle(server, msg, THROTTLE_CHUNK, true);
+    } else if (name == "/silent") {
+        // Headers never come; the probe deadline has to end it
+        pause_message(server, msg);
+    } else if (name == "/error") {
+        soup_server_message_set_status(msg, 503, nullptr);
+    } else if (name == "/headers") {
+        const char *token = soup_message_headers_get_one(headers, "X-Probe-Token");
+        if (token && g_str_equal(token, "secret")) {
+            send_range(msg);
+        } else {
+            soup_server_message_set_status(msg, 403, nullptr);
+        }
+    } else {
+        soup_server_message_set_status(msg, 404, nullptr);
+    }
+}
+
+// ============ Checks ============
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    printf("  %s %s\n", condition ? "ok  " : "FAIL", what.c_str());
+    if (!condition) failures++;
+}
+
+static std::string ms(double value) {
+    char buf[32];
+    g_snprintf(buf, sizeof(buf), "%.0f ms", value);
+    return buf;
+}
+
+int main() {
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(SoupServer) server = soup_server_new(nullptr, nullptr);
+    soup_server_add_handler(server, nullptr, on_request, nullptr, nullptr);
+    if (!soup_server_listen_local(server, 0, SOUP_SERVER_LISTEN_IPV4_ONLY, &error)) {
+        g_error("Failed to start the test server: %s", error->message);
+    }
+
+    GSList *uris = soup_server_get_uris(server);
+    g_autofree gchar *base = g_uri_to_string(static_cast<GUri *>(uris->data));
+    g_slist_free_full(uris, reinterpret_cast<GDestroyNotify>(g_uri_unref));
+    std::string root = base;
+    if (!root.empty() && root.back() == '/') root.pop_back();
+
+    const char *PATHS[] = {"/fast", "/late", "/throttled", "/stalled", "/silent", "/error", "/headers", "/missing"};
+    std::vector<Stream> streams;
+    for (const char *path : PATHS) {
+        Stream stream;
+        stream.url = root + path;
+        streams.push_back(std::move(stream));
+    }
+    streams[6].behavior_hints.proxy_headers_request["X-Probe-Token"] = "secret";
+
+    // Not HTTP: must be skipped, not probed
+    Stream torrent;
+    torrent.info_hash = "0123456789abcdef0123456789abcdef01234567";
+    streams.push_back(torrent);
+
+    ProbeOptions options;
+    options.max_streams = streams.size();
+    options.range_bytes = RANGE_BYTES;
+    options.timeout_ms = DEADLINE_MS;
+
+    std::map<std::string, ProbeResult> results;
+    std::map<std::string, double> finished_ms;
+    std::vector<ProbeResult> order;
+
+    StreamProbe probe;
+    g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, FALSE);
+    gint64 start = g_get_monotonic_time();
+    probe.probe(streams, options,
+        [&](const ProbeResult& result) {
+            std::string name = PATHS[result.index] + 1;
+            results[name] = result;
+            finished_ms[name] = (g_get_monotonic_time() - start) / 1000.0;
+        },
+        [&](const std::vector<ProbeResult>& sorted) {
+            order = sorted;
+            g_main_loop_quit(loop);
+        });
+    g_main_loop_run(loop);
+
+    for (const auto& [name, result] : results) {
+        printf("%-10s %-24s %7lld bytes  done at %s\n", name.c_str(), StreamProbe::describe(result).c_str(),
+               static_cast<long long>(result.bytes), ms(finished_ms[name]).c_str());
+    }
+
+    double throttle_rate = THROTTLE_CHUNK * 1000.0 / THROTTLE_INTERVAL_MS;
+    double deadline = DEADLINE_MS;
+
+    printf("checks\n");
+    check(results.size() == 8, "every HTTP stream probed, the torrent skipped");
+
+    const ProbeResult& fast = results["fast"];
+    check(fast.ok && fast.bytes == static_cast<int64_t>(RANGE_BYTES), "fast: whole range read");
+    check(fast.ttfb_us >= 0 && fast.ttfb_us < 200000, "fast: TTFB under 200 ms");
+
+    const ProbeResult& late = results["late"];
+    check(late.ok, "late: succeeds");
+    check(late.ttfb_us >= HEADERS_DELAY_MS * 1000 && late.ttfb_us < (HEADERS_DELAY_MS + 500) * 1000,
+          "late: TTFB includes the " + ms(HEADERS_DELAY_MS) + " header delay");
+
+    const ProbeResult& throttled = results["throttled"];
+    check(throttled.ok && throttled.bytes == static_cast<int64_t>(RANGE_BYTES), "throttled: whole range read");
+    check(throttled.bytes_per_second > throttle_rate / 2 && throttled.bytes_per_second < throttle_rate * 2,
+          "throttled: throughput within 2x of the server's rate");
+    check(fast.bytes_per_second > throttled.bytes_per_second, "fast measures faster than throttled");
+
+    const ProbeResult& stalled = results["stalled"];
+    check(stalled.ok && stalled.bytes == static_cast<int64_t>(THROTTLE_CHUNK),
+          "stalled: partial read kept when the deadline hits");
+    check(finished_ms["stalled"] >= deadline && finished_ms["stalled"] < deadline + 500,
+          "stalled: ends at the deadline");
+
+    const ProbeResult& silent = results["silent"];
+    check(!silent.ok && silent.error == "Timed out", "silent: reported as timed out");
+    check(finished_ms["silent"] >= deadline && finished_ms["silent"] < deadline + 500,
+          "silent: ends at the deadline");
+
+    check(!results["error"].ok && results["error"].error == "HTTP error: 503", "error: HTTP status reported");
+    check(results["headers"].ok, "headers: proxy request headers sent");
+    check(!results["missing"].ok, "missing: 404 fails");
+
+    auto rank = [&](size_t index) {
+        return std::find_if(order.begin(), order.end(),
+                            [&](const ProbeResult& r) { return r.index == index; }) - order.begin();
+    };
+    check(rank(0) < rank(2) && rank(2) < rank(3), "sorted fast, then throttled, then stalled");
+    check(!order.empty() && !order.back().ok, "failures sorted last");
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -1,13 +1,23 @@
 #include "application.hpp"
 #include "window.hpp"
 #include "preferences_window.hpp"
+#include "image_loader.hpp"
+#include "profiler.hpp"
+
+// Decoded textures kept for reuse after a low memory warning; shown ones
+// stay alive through their pictures either way
+static const gsize LOW_MEMORY_IMAGE_CACHE_BYTES = 24 * 1024 * 1024;
 
 struct _MadariApplication {
     AdwApplication parent_instance;
     
     Stremio::AddonService *addon_service;
     Madari::WatchHistoryService *watch_history;
+    Madari::SourceStatsService *source_stats;
     Trakt::TraktService *trakt_service;
+    Madari::CatalogRefresher *catalog_refresher;
+    GMemoryMonitor *memory_monitor;
+    Madari::Diagnostics *diagnostics;
 };
 
 G_DEFINE_TYPE(MadariApplication, madari_application, ADW_TYPE_APPLICATION)
@@ -15,6 +25,34 @@ G_DEFINE_TYPE(MadariApplication, madari_application, ADW_TYPE_APPLICATION)
 static void on_preferences_action(GSimpleAction *action, GVariant *parameter, gpointer user_data);
 static void on_about_action(GSimpleAction *action, GVariant *parameter, gpointer user_data);
 
+/**
+ * Give memory back in steps: parsed responses and spare textures first,
+ * then the textures of every page and home row that is not on screen.
+ * Everything dropped reloads from the disk caches when needed again.
+ */
+static void on_low_memory_warning([[maybe_unused]] GMemoryMonitor *monitor,
+                                  GMemoryMonitorWarningLevel level,
+                                  MadariApplication *self) {
+    gsize parsed = self->addon_service ? self->addon_service->trim_memory() : 0;
+    gsize pages = 0;
+    gsize cached = 0;
+
+    if (level >= G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM) {
+        for (GList *l = gtk_application_get_windows(GTK_APPLICATION(self)); l; l = l->next) {
+            if (MADARI_IS_WINDOW(l->data)) {
+                pages += madari_window_release_hidden_images(MADARI_WINDOW(l->data));
+            }
+        }
+        cached = madari_image_trim_cache(0);
+    } else {
+        cached = madari_image_trim_cache(LOW_MEMORY_IMAGE_CACHE_BYTES);
+    }
+
+    g_message("Low memory warning (level %d): released ~%zu KiB of parsed data, "
+              "%zu KiB of hidden textures, %zu KiB of cached textures",
+              static_cast<int>(level), parsed / 1024, pages / 1024, cached / 1024);
+}
+
 static void madari_application_activate(GApplication *app) {
     GtkWindow *window;
 
@@ -23,6 +61,7 @@ static void madari_application_activate(GApplication *app) {
     window = gtk_application_get_active_window(GTK_APPLICATION(app));
 
     if (window == nullptr) {
+        Madari::ProfileSpan span("create window", "startup");
         window = GTK_WINDOW(madari_window_new(MADARI_APPLICATION(app)));
     }
 
@@ -30,7 +69,12 @@ static void madari_application_activate(GApplication *app) {
 }
 
 static void madari_application_startup(GApplication *app) {
-    G_APPLICATION_CLASS(madari_application_parent_class)->startup(app);
+    Madari::ProfileSpan span("application startup", "startup");
+    
+    {
+        Madari::ProfileSpan gtk_span("gtk startup", "startup");
+        G_APPLICATION_CLASS(madari_application_parent_class)->startup(app);
+    }
     
     MadariApplication *self = MADARI_APPLICATION(app);
     
@@ -44,17 +88,35 @@ static void madari_application_startup(GApplication *app) {
     );
     g_object_unref(css_provider);
     
+    // Services read their files on worker threads so the window can show
+    // right away; it fills in as each one reports ready
+    
     // Initialize addon service
     self->addon_service = new Stremio::AddonService();
-    self->addon_service->load();
+    self->addon_service->load_async();
+    
+    // Revalidate catalogs the user has looked at while the app is idle
+    self->catalog_refresher = new Madari::CatalogRefresher(self->addon_service);
     
     // Initialize watch history service
     self->watch_history = new Madari::WatchHistoryService();
-    self->watch_history->load();
+    self->watch_history->load_async();
+    
+    // Initialize playback outcome stats used for stream ranking
+    self->source_stats = new Madari::SourceStatsService();
+    self->source_stats->load_async();
     
     // Initialize Trakt service
     self->trakt_service = new Trakt::TraktService();
-    self->trakt_service->load();
+    self->trakt_service->load_async();
+    
+    // Shed caches when the system runs low on memory
+    self->memory_monitor = g_memory_monitor_dup_default();
+    g_signal_connect(self->memory_monitor, "low-memory-warning",
+                     G_CALLBACK(on_low_memory_warning), self);
+    
+    // Main loop latency probe and figures for the diagnostics page
+    self->diagnostics = new Madari::Diagnostics(self);
     
     // Add actions
     static const GActionEntry app_actions[] = {
@@ -72,11 +134,31 @@ static void madari_application_startup(GApplication *app) {
 static void madari_application_shutdown(GApplication *app) {
     MadariApplication *self = MADARI_APPLICATION(app);
     
+    if (self->diagnostics) {
+        delete self->diagnostics;
+        self->diagnostics = nullptr;
+    }
+    
+    if (self->memory_monitor) {
+        g_signal_handlers_disconnect_by_data(self->memory_monitor, self);
+        g_clear_object(&self->memory_monitor);
+    }
+    
+    if (self->catalog_refresher) {
+        delete self->catalog_refresher;
+        self->catalog_refresher = nullptr;
+    }
+    
     if (self->trakt_service) {
         delete self->trakt_service;
         self->trakt_service = nullptr;
     }
     
+    if (self->source_stats) {
+        delete self->source_stats;
+        self->source_stats = nullptr;
+    }
+    
     if (self->watch_history) {
         delete self->watch_history;
         self->watch_history = nullptr;
@@ -87,6 +169,8 @@ static void madari_application_shutdown(GApplication *app) {
         self->addon_service = nullptr;
     }
     
+    Madari::Profiler::stop();
+    
     G_APPLICATION_CLASS(madari_application_parent_class)->shutdown(app);
 }
 
@@ -96,7 +180,8 @@ static void on_preferences_action([[maybe_unused]] GSimpleAction *action,
     MadariApplication *self = MADARI_APPLICATION(user_data);
     GtkWindow *window = gtk_application_get_active_window(GTK_APPLICATION(self));
     
-    MadariPreferencesWindow *prefs = madari_preferences_window_new(window, self->addon_service, self->trakt_service);
+    MadariPreferencesWindow *prefs = madari_preferences_window_new(window, self->addon_service, self->trakt_service,
+                                                                     self->diagnostics);
     gtk_window_present(GTK_WINDOW(prefs));
 }
 
@@ -133,9 +218,17 @@ static void madari_application_class_init(MadariApplicationClass *klass) {
 }
 
 static void madari_application_init(MadariApplication *self) {
+    // Handled in main() by Profiler::init, listed here for --help
+    g_application_add_main_option(G_APPLICATION(self), "profile", 0, G_OPTION_FLAG_NONE, G_OPTION_ARG_NONE,
+                                  "Record a Chrome trace of startup and interaction, written on exit", nullptr);
+    
     self->addon_service = nullptr;
     self->watch_history = nullptr;
+    self->source_stats = nullptr;
     self->trakt_service = nullptr;
+    self->catalog_refresher = nullptr;
+    self->memory_monitor = nullptr;
+    self->diagnostics = nullptr;
 }
 
 MadariApplication *madari_application_new(void) {
@@ -157,7 +250,22 @@ Madari::WatchHistoryService* madari_application_get_watch_history(MadariApplicat
     return app->watch_history;
 }
 
+Madari::SourceStatsService* madari_application_get_source_stats(MadariApplication *app) {
+    g_return_val_if_fail(MADARI_IS_APPLICATION(app), nullptr);
+    return app->source_stats;
+}
+
 Trakt::TraktService* madari_application_get_trakt_service(MadariApplication *app) {
     g_return_val_if_fail(MADARI_IS_APPLICATION(app), nullptr);
     return app->trakt_service;
 }
+
+Madari::CatalogRefresher* madari_application_get_catalog_refresher(MadariApplication *app) {
+    g_return_val_if_fail(MADARI_IS_APPLICATION(app), nullptr);
+    return app->catalog_refresher;
+}
+
+Madari::Diagnostics* madari_application_get_diagnostics(MadariApplication *app) {
+    g_return_val_if_fail(MADARI_IS_APPLICATION(app), nullptr);
+    return app->diagnostics;
+}
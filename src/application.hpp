@@ -4,6 +4,9 @@
 #include "stremio/stremio.hpp"
 #include "trakt/trakt.hpp"
 #include "watch_history.hpp"
+#include "source_stats.hpp"
+#include "catalog_refresher.hpp"
+#include "diagnostics.hpp"
 
 G_BEGIN_DECLS
 
@@ -17,6 +20,12 @@ Stremio::AddonService* madari_application_get_addon_service(MadariApplication *a
 
 Madari::WatchHistoryService* madari_application_get_watch_history(MadariApplication *app);
 
+Madari::SourceStatsService* madari_application_get_source_stats(MadariApplication *app);
+
 Trakt::TraktService* madari_application_get_trakt_service(MadariApplication *app);
 
+Madari::CatalogRefresher* madari_application_get_catalog_refresher(MadariApplication *app);
+
+Madari::Diagnostics* madari_application_get_diagnostics(MadariApplication *app);
+
 G_END_DECLS
@@ -0,0 +1,159 @@
+#include "catalog_refresher.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace Madari {
+
+// How often a refresh round starts; catalog TTLs are an hour by default,
+// so most rounds only find a few pages stale
+static const guint REFRESH_INTERVAL_S = 5 * 60;
+
+// Catalogs not shown for this long stop being refreshed and are forgotten
+static const gint64 RECENTLY_VIEWED_US = 6 * G_TIME_SPAN_HOUR;
+
+// Pages revalidated per round at most, most recently viewed first
+static const size_t MAX_PER_ROUND = 24;
+
+CatalogRefresher::CatalogRefresher(Stremio::AddonService* service)
+    : service_(service),
+      network_monitor_(g_network_monitor_get_default()),
+      power_monitor_(g_power_profile_monitor_dup_default()),
+      cancellable_(g_cancellable_new()),
+      idle_source_(0),
+      in_flight_(false),
+      paused_(false) {
+    round_source_ = g_timeout_add_seconds_full(G_PRIORITY_LOW, REFRESH_INTERVAL_S,
+        [](gpointer data) -> gboolean {
+            static_cast<CatalogRefresher*>(data)->start_round();
+            return G_SOURCE_CONTINUE;
+        }, this, nullptr);
+}
+
+CatalogRefresher::~CatalogRefresher() {
+    g_clear_handle_id(&round_source_, g_source_remove);
+    g_clear_handle_id(&idle_source_, g_source_remove);
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+    g_clear_object(&power_monitor_);
+}
+
+std::string CatalogRefresher::make_key(const std::string& addon_id, const std::string& type,
+                                       const std::string& catalog_id, const Stremio::ExtraArgs& extra) {
+    return Stremio::CatalogCache::make_key(addon_id, type, catalog_id, extra);
+}
+
+void CatalogRefresher::track(const std::string& addon_id, const std::string& type,
+                             const std::string& catalog_id, const Stremio::ExtraArgs& extra) {
+    Tracked& tracked = tracked_[make_key(addon_id, type, catalog_id, extra)];
+    tracked.addon_id = addon_id;
+    tracked.type = type;
+    tracked.catalog_id = catalog_id;
+    tracked.extra = extra;
+    tracked.last_viewed = g_get_monotonic_time();
+}
+
+void CatalogRefresher::set_paused(bool paused) {
+    if (paused == paused_) return;
+    paused_ = paused;
+    if (!paused) return;
+
+    // Drop the round; whatever was on the wire gives its bandwidth back
+    queue_.clear();
+    g_clear_handle_id(&idle_source_, g_source_remove);
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+    cancellable_ = g_cancellable_new();
+    in_flight_ = false;
+}
+
+void CatalogRefresher::on_updated(UpdatedCallback callback) {
+    callbacks_.push_back(std::move(callback));
+}
+
+bool CatalogRefresher::can_refresh() const {
+    if (paused_) return false;
+    if (!g_network_monitor_get_network_available(network_monitor_)) return false;
+    if (g_network_monitor_get_network_metered(network_monitor_)) return false;
+    if (power_monitor_ && g_power_profile_monitor_get_power_saver_enabled(power_monitor_)) return false;
+    return true;
+}
+
+void CatalogRefresher::start_round() {
+    if (!queue_.empty() || in_flight_ || !can_refresh()) return;
+
+    gint64 now = g_get_monotonic_time();
+    std::vector<std::pair<gint64, std::string>> recent;
+    for (auto it = tracked_.begin(); it != tracked_.end();) {
+        if (now - it->second.last_viewed > RECENTLY_VIEWED_US) {
+            it = tracked_.erase(it);
+            continue;
+        }
+        recent.emplace_back(it->second.last_viewed, it->first);
+        ++it;
+    }
+
+    std::sort(recent.begin(), recent.end(), std::greater<>());
+    if (recent.size() > MAX_PER_ROUND) recent.resize(MAX_PER_ROUND);
+
+    // Popped from the back, so the most recently viewed goes last in
+    for (auto it = recent.rbegin(); it != recent.rend(); ++it) {
+        queue_.push_back(it->second);
+    }
+    schedule_next();
+}
+
+void CatalogRefresher::schedule_next() {
+    if (queue_.empty() || idle_source_) return;
+
+    idle_source_ = g_idle_add_full(G_PRIORITY_LOW,
+        [](gpointer data) -> gboolean {
+            auto* self = static_cast<CatalogRefresher*>(data);
+            self->idle_source_ = 0;
+            self->refresh_next();
+            return G_SOURCE_REMOVE;
+        }, this, nullptr);
+}
+
+void CatalogRefresher::refresh_next() {
+    // Conditions may have changed mid-round; the next round checks again
+    if (!can_refresh()) {
+        queue_.clear();
+        return;
+    }
+
+    while (!queue_.empty()) {
+        std::string key = std::move(queue_.back());
+        queue_.pop_back();
+
+        auto it = tracked_.find(key);
+        if (it == tracked_.end()) continue;
+
+        Stremio::RequestOptions options;
+        options.priority = G_PRIORITY_LOW;
+        options.cancellable = cancellable_;
+
+        in_flight_ = true;
+        GCancellable* cancellable = G_CANCELLABLE(g_object_ref(cancellable_));
+        const Tracked& tracked = it->second;
+        service_->revalidate_catalog(tracked.addon_id, tracked.type, tracked.catalog_id, tracked.extra,
+            [this, key, cancellable](std::optional<Stremio::CatalogResponse> changed, const std::string& error) {
+                bool cancelled = g_cancellable_is_cancelled(cancellable);
+                g_object_unref(cancellable);
+                if (cancelled) return;
+
+                in_flight_ = false;
+                if (changed) {
+                    g_debug("Catalog %s changed on background refresh", key.c_str());
+                    for (const auto& callback : callbacks_) {
+                        callback(key, *changed);
+                    }
+                } else if (!error.empty()) {
+                    g_debug("Background refresh of %s failed: %s", key.c_str(), error.c_str());
+                }
+                schedule_next();
+            }, options);
+        return;
+    }
+}
+
+} // namespace Madari
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "stremio/stremio.hpp"
+#include <gio/gio.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Madari {
+
+/**
+ * Keeps the catalogs the user looks at fresh in the background.
+ * Catalogs are tracked when shown (home rows, "See All" pages) and
+ * revalidated one at a time from low priority idle callbacks, so cached
+ * pages are current by the time they are shown again. Nothing runs while
+ * paused (during playback), offline, on a metered connection or in power
+ * saver mode.
+ */
+class CatalogRefresher {
+public:
+    using UpdatedCallback = std::function<void(const std::string& key, const Stremio::CatalogResponse& response)>;
+
+    explicit CatalogRefresher(Stremio::AddonService* service);
+    ~CatalogRefresher();
+
+    /**
+     * Key of a catalog page, as passed to UpdatedCallback
+     */
+    static std::string make_key(const std::string& addon_id, const std::string& type,
+                                const std::string& catalog_id, const Stremio::ExtraArgs& extra = {});
+
+    /**
+     * Note that a catalog page is on screen
+     */
+    void track(const std::string& addon_id, const std::string& type,
+               const std::string& catalog_id, const Stremio::ExtraArgs& extra = {});
+
+    /**
+     * Stop refreshing, cancelling any request on the wire, until unpaused
+     */
+    void set_paused(bool paused);
+
+    /**
+     * Register for pages whose content changed on refresh
+     */
+    void on_updated(UpdatedCallback callback);
+
+private:
+    struct Tracked {
+        std::string addon_id;
+        std::string type;
+        std::string catalog_id;
+        Stremio::ExtraArgs extra;
+        gint64 last_viewed = 0;     // Monotonic, microseconds
+    };
+
+    Stremio::AddonService* service_;
+    std::map<std::string, Tracked> tracked_;
+    std::vector<std::string> queue_;          // Keys left in the current round
+    std::vector<UpdatedCallback> callbacks_;
+    GNetworkMonitor* network_monitor_;        // Not owned
+    GPowerProfileMonitor* power_monitor_;
+    GCancellable* cancellable_;
+    guint round_source_;
+    guint idle_source_;
+    bool in_flight_;
+    bool paused_;
+
+    bool can_refresh() const;
+    void start_round();
+    void refresh_next();
+    void schedule_next();
+};
+
+} // namespace Madari
@@ -0,0 +1,617 @@
+#include "catalog_view.hpp"
+#include "window.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Pages with their items in memory at once; farther ones are dropped and
+// refetched if the user scrolls back to them
+static const size_t MAX_RESIDENT_PAGES = 6;
+
+// Genres on either side of the selected chip whose first page is warmed
+static const int PREFETCH_ADJACENT_GENRES = 1;
+
+// Grid item: a catalog entry, or a placeholder while its page is not in memory
+#define MADARI_TYPE_CATALOG_ITEM (madari_catalog_item_get_type())
+G_DECLARE_FINAL_TYPE(MadariCatalogItem, madari_catalog_item, MADARI, CATALOG_ITEM, GObject)
+
+struct _MadariCatalogItem {
+    GObject parent_instance;
+    Stremio::MetaPreview *meta;     // nullptr for a placeholder
+};
+
+G_DEFINE_TYPE(MadariCatalogItem, madari_catalog_item, G_TYPE_OBJECT)
+
+static void madari_catalog_item_finalize(GObject *object) {
+    delete MADARI_CATALOG_ITEM(object)->meta;
+    G_OBJECT_CLASS(madari_catalog_item_parent_class)->finalize(object);
+}
+
+static void madari_catalog_item_class_init(MadariCatalogItemClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = madari_catalog_item_finalize;
+}
+
+static void madari_catalog_item_init(MadariCatalogItem *self) {
+    self->meta = nullptr;
+}
+
+static MadariCatalogItem *madari_catalog_item_new(const Stremio::MetaPreview *meta) {
+    MadariCatalogItem *self = MADARI_CATALOG_ITEM(g_object_new(MADARI_TYPE_CATALOG_ITEM, nullptr));
+    if (meta) self->meta = new Stremio::MetaPreview(*meta);
+    return self;
+}
+
+// ============= Paged Model =============
+
+/**
+ * One response of the catalog. The ids it contributed are kept for good, so
+ * positions and dedupe stay stable; the metas themselves may be dropped.
+ */
+struct CatalogPage {
+    int skip = 0;                               // Offset it was requested with
+    guint first = 0;                            // Model position of its first item
+    std::vector<std::string> ids;               // Items new in this page, in order
+    std::vector<Stremio::MetaPreview> metas;    // Parallel to ids; empty while dropped
+    bool loading = false;
+};
+
+#define MADARI_TYPE_CATALOG_MODEL (madari_catalog_model_get_type())
+G_DECLARE_FINAL_TYPE(MadariCatalogModel, madari_catalog_model, MADARI, CATALOG_MODEL, GObject)
+
+struct _MadariCatalogModel {
+    GObject parent_instance;
+
+    Stremio::AddonService *service;
+    std::string *addon_id;
+    std::string *type;
+    std::string *catalog_id;
+    Stremio::ExtraArgs *extra;              // Arguments besides skip
+
+    std::vector<CatalogPage> *pages;
+    std::unordered_set<std::string> *seen_ids;
+    guint n_items;
+    int next_skip;                          // Offset of the next page to request
+    gboolean loading_next;
+    gboolean exhausted;                     // Last page was empty or all duplicates
+    guint last_position;                    // Most recently requested item, to pick pages to drop
+    GCancellable *cancellable;
+
+    // Called after each page request; error is empty on success
+    std::function<void(const std::string& error)> *on_page_loaded;
+};
+
+static void madari_catalog_model_list_model_init(GListModelInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(MadariCatalogModel, madari_catalog_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL, madari_catalog_model_list_model_init))
+
+static void fetch_page(MadariCatalogModel *self, size_t index);
+
+static GType madari_catalog_model_get_item_type([[maybe_unused]] GListModel *list) {
+    return MADARI_TYPE_CATALOG_ITEM;
+}
+
+static guint madari_catalog_model_get_n_items(GListModel *list) {
+    return MADARI_CATALOG_MODEL(list)->n_items;
+}
+
+// Index of the page holding position
+static size_t page_for_position(MadariCatalogModel *self, guint position) {
+    auto it = std::upper_bound(self->pages->begin(), self->pages->end(), position,
+        [](guint pos, const CatalogPage& page) { return pos < page.first; });
+    return static_cast<size_t>(it - self->pages->begin()) - 1;
+}
+
+// Free the items of the resident pages farthest from where the user is
+static void drop_far_pages(MadariCatalogModel *self) {
+    std::vector<size_t> resident;
+    for (size_t i = 0; i < self->pages->size(); i++) {
+        if (!(*self->pages)[i].metas.empty()) resident.push_back(i);
+    }
+    if (resident.size() <= MAX_RESIDENT_PAGES) return;
+
+    size_t current = page_for_position(self, std::min(self->last_position, self->n_items - 1));
+    std::sort(resident.begin(), resident.end(), [current](size_t a, size_t b) {
+        size_t da = a > current ? a - current : current - a;
+        size_t db = b > current ? b - current : current - b;
+        return da > db;
+    });
+
+    for (size_t i = 0; i + MAX_RESIDENT_PAGES < resident.size(); i++) {
+        CatalogPage& page = (*self->pages)[resident[i]];
+        page.metas.clear();
+        page.metas.shrink_to_fit();
+    }
+}
+
+static gpointer madari_catalog_model_get_item(GListModel *list, guint position) {
+    MadariCatalogModel *self = MADARI_CATALOG_MODEL(list);
+    if (position >= self->n_items) return nullptr;
+
+    self->last_position = position;
+
+    size_t index = page_for_position(self, position);
+    CatalogPage& page = (*self->pages)[index];
+
+    if (page.metas.empty()) {
+        // Dropped earlier: show a placeholder and bring the page back. Not
+        // from here, as a cache hit would change the model mid get_item.
+        if (!page.loading) {
+            page.loading = true;
+            struct PendingFetch { MadariCatalogModel *model; size_t index; };
+            g_idle_add_full(G_PRIORITY_DEFAULT_IDLE,
+                [](gpointer data) -> gboolean {
+                    auto *pending = static_cast<PendingFetch*>(data);
+                    if (!g_cancellable_is_cancelled(pending->model->cancellable)) {
+                        fetch_page(pending->model, pending->index);
+                    }
+                    return G_SOURCE_REMOVE;
+                },
+                new PendingFetch{MADARI_CATALOG_MODEL(g_object_ref(self)), index},
+                [](gpointer data) {
+                    auto *pending = static_cast<PendingFetch*>(data);
+                    g_object_unref(pending->model);
+                    delete pending;
+                });
+        }
+        return madari_catalog_item_new(nullptr);
+    }
+
+    const Stremio::MetaPreview& meta = page.metas[position - page.first];
+    return madari_catalog_item_new(meta.id.empty() ? nullptr : &meta);
+}
+
+static void madari_catalog_model_list_model_init(GListModelInterface *iface) {
+    iface->get_item_type = madari_catalog_model_get_item_type;
+    iface->get_n_items = madari_catalog_model_get_n_items;
+    iface->get_item = madari_catalog_model_get_item;
+}
+
+// Refetch a dropped page, matching items to the ids it had before. Usually
+// a cache hit; the model keeps the first answer and ignores a revalidation.
+static void fetch_page(MadariCatalogModel *self, size_t index) {
+    CatalogPage& page = (*self->pages)[index];
+    page.loading = true;
+
+    Stremio::ExtraArgs extra = *self->extra;
+    if (page.skip > 0) extra.skip = page.skip;
+
+    Stremio::RequestOptions options;
+    options.cancellable = self->cancellable;
+
+    auto answered = std::make_shared<bool>(false);
+    g_object_ref(self);
+    self->service->fetch_catalog_cached(*self->addon_id, *self->type, *self->catalog_id, extra,
+        [self, index, answered](std::optional<Stremio::CatalogResponse> response,
+                                [[maybe_unused]] const std::string& error, [[maybe_unused]] bool from_cache) {
+            if (*answered) return;
+            *answered = true;
+
+            CatalogPage& page = (*self->pages)[index];
+            page.loading = false;
+
+            if (response && !g_cancellable_is_cancelled(self->cancellable)) {
+                std::vector<Stremio::MetaPreview> metas(page.ids.size());
+                for (auto& meta : response->metas) {
+                    auto it = std::find(page.ids.begin(), page.ids.end(), meta.id);
+                    if (it != page.ids.end()) metas[it - page.ids.begin()] = std::move(meta);
+                }
+                page.metas = std::move(metas);
+
+                // Items the catalog no longer has stay placeholders
+                g_list_model_items_changed(G_LIST_MODEL(self), page.first, page.ids.size(), page.ids.size());
+                drop_far_pages(self);
+            }
+            g_object_unref(self);
+        }, options);
+}
+
+/**
+ * Request the page after the last one. Overlapping pages (addons whose
+ * page boundaries shift between requests) only contribute unseen items.
+ */
+static void madari_catalog_model_load_more(MadariCatalogModel *self) {
+    if (self->loading_next || self->exhausted) return;
+    self->loading_next = TRUE;
+
+    Stremio::ExtraArgs extra = *self->extra;
+    if (self->next_skip > 0) extra.skip = self->next_skip;
+
+    Stremio::RequestOptions options;
+    options.cancellable = self->cancellable;
+
+    // Pages are appended once, so a changed revalidation of a page already
+    // shown is left for the next visit rather than reshuffling the grid
+    auto answered = std::make_shared<bool>(false);
+    g_object_ref(self);
+    self->service->fetch_catalog_cached(*self->addon_id, *self->type, *self->catalog_id, extra,
+        [self, answered](std::optional<Stremio::CatalogResponse> response, const std::string& error,
+                         [[maybe_unused]] bool from_cache) {
+            if (*answered) return;
+            *answered = true;
+
+            self->loading_next = FALSE;
+            if (g_cancellable_is_cancelled(self->cancellable)) {
+                g_object_unref(self);
+                return;
+            }
+
+            if (!response) {
+                // Leave next_skip as is; scrolling again retries
+                if (self->on_page_loaded) (*self->on_page_loaded)(error.empty() ? "Failed to load catalog" : error);
+                g_object_unref(self);
+                return;
+            }
+
+            CatalogPage page;
+            page.skip = self->next_skip;
+            page.first = self->n_items;
+            for (auto& meta : response->metas) {
+                if (meta.id.empty() || !self->seen_ids->insert(meta.id).second) continue;
+                page.ids.push_back(meta.id);
+                page.metas.push_back(std::move(meta));
+            }
+
+            // Nothing new: the end, or an addon that ignores skip
+            if (page.ids.empty()) {
+                self->exhausted = TRUE;
+            } else {
+                self->next_skip += static_cast<int>(response->metas.size());
+                guint added = page.ids.size();
+                self->n_items += added;
+                self->pages->push_back(std::move(page));
+                g_list_model_items_changed(G_LIST_MODEL(self), self->n_items - added, 0, added);
+                drop_far_pages(self);
+            }
+
+            if (self->on_page_loaded) (*self->on_page_loaded)("");
+            g_object_unref(self);
+        }, options);
+}
+
+static void madari_catalog_model_finalize(GObject *object) {
+    MadariCatalogModel *self = MADARI_CATALOG_MODEL(object);
+
+    delete self->addon_id;
+    delete self->type;
+    delete self->catalog_id;
+    delete self->extra;
+    delete self->pages;
+    delete self->seen_ids;
+    delete self->on_page_loaded;
+    g_clear_object(&self->cancellable);
+
+    G_OBJECT_CLASS(madari_catalog_model_parent_class)->finalize(object);
+}
+
+static void madari_catalog_model_class_init(MadariCatalogModelClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = madari_catalog_model_finalize;
+}
+
+static void madari_catalog_model_init(MadariCatalogModel *self) {
+    self->service = nullptr;
+    self->addon_id = new std::string();
+    self->type = new std::string();
+    self->catalog_id = new std::string();
+    self->extra = new Stremio::ExtraArgs();
+    self->pages = new std::vector<CatalogPage>();
+    self->seen_ids = new std::unordered_set<std::string>();
+    self->n_items = 0;
+    self->next_skip = 0;
+    self->loading_next = FALSE;
+    self->exhausted = FALSE;
+    self->last_position = 0;
+    self->cancellable = g_cancellable_new();
+    self->on_page_loaded = nullptr;
+}
+
+static MadariCatalogModel *madari_catalog_model_new(Stremio::AddonService *service,
+                                                    const std::string& addon_id,
+                                                    const std::string& type,
+                                                    const std::string& catalog_id,
+                                                    const Stremio::ExtraArgs& extra) {
+    MadariCatalogModel *self = MADARI_CATALOG_MODEL(g_object_new(MADARI_TYPE_CATALOG_MODEL, nullptr));
+    self->service = service;
+    *self->addon_id = addon_id;
+    *self->type = type;
+    *self->catalog_id = catalog_id;
+    *self->extra = extra;
+    return self;
+}
+
+// ============= Catalog View =============
+
+struct _MadariCatalogView {
+    AdwNavigationPage parent_instance;
+
+    // Template widgets
+    GtkStack *main_stack;
+    AdwStatusPage *status_page;
+    GtkScrolledWindow *grid_scroll;
+    GtkGridView *grid_view;
+    GtkScrolledWindow *genre_bar;
+    GtkBox *genre_box;
+
+    Stremio::AddonService *addon_service;
+    std::string *addon_id;
+    std::string *type;
+    std::string *catalog_id;
+    std::vector<std::string> *genres;       // Chip order; "" is "All"
+    int genre_index;                        // Selected chip
+    guint prefetch_source;
+    MadariCatalogModel *model;
+};
+
+G_DEFINE_TYPE(MadariCatalogView, madari_catalog_view, ADW_TYPE_NAVIGATION_PAGE)
+
+// Ask for the next page once the end is less than a screen away
+static void maybe_load_more(MadariCatalogView *self) {
+    if (!self->model) return;
+
+    GtkAdjustment *adj = gtk_scrolled_window_get_vadjustment(self->grid_scroll);
+    double remaining = gtk_adjustment_get_upper(adj) -
+                       (gtk_adjustment_get_value(adj) + gtk_adjustment_get_page_size(adj));
+    if (remaining <= gtk_adjustment_get_page_size(adj)) {
+        madari_catalog_model_load_more(self->model);
+    }
+}
+
+// Cells are built once per visible slot and rebound as the grid scrolls
+static void on_grid_item_setup([[maybe_unused]] GtkSignalListItemFactory *factory, GtkListItem *list_item,
+                               [[maybe_unused]] gpointer user_data) {
+    gtk_list_item_set_activatable(list_item, FALSE);
+
+    // Items still loading show a placeholder card in the poster's place
+    GtkWidget *stack = gtk_stack_new();
+    gtk_stack_set_hhomogeneous(GTK_STACK(stack), FALSE);
+    gtk_stack_set_vhomogeneous(GTK_STACK(stack), FALSE);
+
+    gtk_stack_add_named(GTK_STACK(stack), madari_window_poster_new(), "poster");
+
+    GtkWidget *placeholder = gtk_frame_new(nullptr);
+    gtk_widget_add_css_class(placeholder, "card");
+    gtk_widget_set_size_request(placeholder, 160, 240);
+    gtk_widget_set_halign(placeholder, GTK_ALIGN_START);
+    gtk_widget_set_valign(placeholder, GTK_ALIGN_START);
+    gtk_stack_add_named(GTK_STACK(stack), placeholder, "placeholder");
+
+    gtk_list_item_set_child(list_item, stack);
+}
+
+static void on_grid_item_bind([[maybe_unused]] GtkSignalListItemFactory *factory, GtkListItem *list_item,
+                              [[maybe_unused]] gpointer user_data) {
+    MadariCatalogItem *item = MADARI_CATALOG_ITEM(gtk_list_item_get_item(list_item));
+    GtkStack *stack = GTK_STACK(gtk_list_item_get_child(list_item));
+
+    if (item->meta) {
+        madari_window_poster_set_meta(gtk_stack_get_child_by_name(stack, "poster"), *item->meta);
+        gtk_stack_set_visible_child_name(stack, "poster");
+    } else {
+        gtk_stack_set_visible_child_name(stack, "placeholder");
+    }
+}
+
+static void setup_grid(MadariCatalogView *self) {
+    GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+    g_signal_connect(factory, "setup", G_CALLBACK(on_grid_item_setup), nullptr);
+    g_signal_connect(factory, "bind", G_CALLBACK(on_grid_item_bind), nullptr);
+    gtk_grid_view_set_factory(self->grid_view, factory);
+    g_object_unref(factory);
+
+    GtkAdjustment *adj = gtk_scrolled_window_get_vadjustment(self->grid_scroll);
+    g_signal_connect_swapped(adj, "value-changed", G_CALLBACK(maybe_load_more), self);
+    // Also after pages arrive: a first page shorter than the window loads the next
+    g_signal_connect_swapped(adj, "changed", G_CALLBACK(maybe_load_more), self);
+}
+
+// Warm the first page of the genres next to the selected one, so flipping
+// through chips shows cached pages; runs once the selected page is in
+static gboolean prefetch_adjacent_genres(gpointer user_data) {
+    MadariCatalogView *self = MADARI_CATALOG_VIEW(user_data);
+    self->prefetch_source = 0;
+
+    Stremio::RequestOptions options;
+    options.cancellable = self->model ? self->model->cancellable : nullptr;
+
+    int count = static_cast<int>(self->genres->size());
+    for (int offset = -PREFETCH_ADJACENT_GENRES; offset <= PREFETCH_ADJACENT_GENRES; offset++) {
+        int index = self->genre_index + offset;
+        if (offset == 0 || index < 0 || index >= count) continue;
+
+        Stremio::ExtraArgs extra;
+        if (!(*self->genres)[index].empty()) extra.genre = (*self->genres)[index];
+        self->addon_service->prefetch_catalog(*self->addon_id, *self->type, *self->catalog_id, extra, options);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+static void load_catalog(MadariCatalogView *self, const Stremio::ExtraArgs& extra) {
+    if (self->model) {
+        g_cancellable_cancel(self->model->cancellable);
+        delete self->model->on_page_loaded;
+        self->model->on_page_loaded = nullptr;
+        g_clear_object(&self->model);
+    }
+
+    gtk_stack_set_visible_child_name(self->main_stack, "loading");
+
+    self->model = madari_catalog_model_new(self->addon_service, *self->addon_id, *self->type,
+                                           *self->catalog_id, extra);
+    self->model->on_page_loaded = new std::function<void(const std::string&)>(
+        [self](const std::string& error) {
+            if (self->model->n_items > 0) {
+                gtk_stack_set_visible_child_name(self->main_stack, "content");
+                if (self->genres->size() > 1 && !self->prefetch_source) {
+                    self->prefetch_source = g_idle_add_full(G_PRIORITY_LOW, prefetch_adjacent_genres, self, nullptr);
+                }
+                return;
+            }
+
+            if (error.empty()) {
+                adw_status_page_set_icon_name(self->status_page, "folder-symbolic");
+                adw_status_page_set_title(self->status_page, "Nothing Here");
+                adw_status_page_set_description(self->status_page, "This catalog is empty");
+            } else {
+                adw_status_page_set_icon_name(self->status_page, "dialog-error-symbolic");
+                adw_status_page_set_title(self->status_page, "Failed to Load");
+                adw_status_page_set_description(self->status_page, error.c_str());
+            }
+            gtk_stack_set_visible_child_name(self->main_stack, "error");
+        });
+
+    // The grid view only takes a selection model; nothing is selectable here
+    GtkNoSelection *selection = gtk_no_selection_new(G_LIST_MODEL(g_object_ref(self->model)));
+    gtk_grid_view_set_model(self->grid_view, GTK_SELECTION_MODEL(selection));
+    g_object_unref(selection);
+
+    madari_catalog_model_load_more(self->model);
+}
+
+static void on_genre_toggled(GtkToggleButton *button, MadariCatalogView *self) {
+    if (!gtk_toggle_button_get_active(button)) return;
+
+    self->genre_index = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(button), "genre-index"));
+    g_clear_handle_id(&self->prefetch_source, g_source_remove);
+
+    Stremio::ExtraArgs extra;
+    const std::string& genre = (*self->genres)[self->genre_index];
+    if (!genre.empty()) extra.genre = genre;
+    load_catalog(self, extra);
+}
+
+/**
+ * Chips for the catalog's genres, if it takes a genre argument. A required
+ * genre has no "All" chip and starts on the first one.
+ */
+static Stremio::ExtraArgs setup_genres(MadariCatalogView *self) {
+    Stremio::ExtraArgs extra;
+
+    auto addon = self->addon_service->get_addon(*self->addon_id);
+    if (!addon) return extra;
+
+    const Stremio::CatalogDefinition *catalog = nullptr;
+    for (const auto& definition : addon->manifest.catalogs) {
+        if (definition.id == *self->catalog_id && definition.type == *self->type) {
+            catalog = &definition;
+            break;
+        }
+    }
+    if (!catalog || catalog->genres.empty()) return extra;
+
+    auto takes = [](const std::vector<std::string>& names) {
+        return std::find(names.begin(), names.end(), "genre") != names.end();
+    };
+    bool required = takes(catalog->extra_required);
+    if (!required && !takes(catalog->extra_supported)) return extra;
+
+    if (!required) self->genres->push_back("");
+    self->genres->insert(self->genres->end(), catalog->genres.begin(), catalog->genres.end());
+
+    GtkToggleButton *group = nullptr;
+    for (size_t i = 0; i < self->genres->size(); i++) {
+        const std::string& genre = (*self->genres)[i];
+        GtkWidget *chip = gtk_toggle_button_new_with_label(genre.empty() ? "All" : genre.c_str());
+        gtk_widget_add_css_class(chip, "pill");
+        gtk_widget_add_css_class(chip, "genre-chip");
+        g_object_set_data(G_OBJECT(chip), "genre-index", GINT_TO_POINTER(static_cast<int>(i)));
+
+        if (group) {
+            gtk_toggle_button_set_group(GTK_TOGGLE_BUTTON(chip), group);
+        } else {
+            group = GTK_TOGGLE_BUTTON(chip);
+            gtk_toggle_button_set_active(group, TRUE);
+        }
+        g_signal_connect(chip, "toggled", G_CALLBACK(on_genre_toggled), self);
+        gtk_box_append(self->genre_box, chip);
+    }
+    gtk_widget_set_visible(GTK_WIDGET(self->genre_bar), TRUE);
+
+    self->genre_index = 0;
+    if (required) extra.genre = self->genres->front();
+    return extra;
+}
+
+static void madari_catalog_view_dispose(GObject *object) {
+    MadariCatalogView *self = MADARI_CATALOG_VIEW(object);
+
+    g_clear_handle_id(&self->prefetch_source, g_source_remove);
+
+    if (self->model) {
+        g_cancellable_cancel(self->model->cancellable);
+        delete self->model->on_page_loaded;
+        self->model->on_page_loaded = nullptr;
+        g_clear_object(&self->model);
+    }
+
+    delete self->addon_id;
+    delete self->type;
+    delete self->catalog_id;
+    delete self->genres;
+    self->addon_id = nullptr;
+    self->type = nullptr;
+    self->catalog_id = nullptr;
+    self->genres = nullptr;
+
+    G_OBJECT_CLASS(madari_catalog_view_parent_class)->dispose(object);
+}
+
+static void madari_catalog_view_class_init(MadariCatalogViewClass *klass) {
+    GObjectClass *object_class = G_OBJECT_CLASS(klass);
+    GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
+
+    object_class->dispose = madari_catalog_view_dispose;
+
+    gtk_widget_class_set_template_from_resource(
+        widget_class,
+        "/media/madari/app/catalog-view.ui"
+    );
+
+    gtk_widget_class_bind_template_child(widget_class, MadariCatalogView, main_stack);
+    gtk_widget_class_bind_template_child(widget_class, MadariCatalogView, status_page);
+    gtk_widget_class_bind_template_child(widget_class, MadariCatalogView, grid_scroll);
+    gtk_widget_class_bind_template_child(widget_class, MadariCatalogView, grid_view);
+    gtk_widget_class_bind_template_child(widget_class, MadariCatalogView, genre_bar);
+    gtk_widget_class_bind_template_child(widget_class, MadariCatalogView, genre_box);
+}
+
+static void madari_catalog_view_init(MadariCatalogView *self) {
+    {
+        Madari::ProfileSpan span("catalog view template init", "ui");
+        gtk_widget_init_template(GTK_WIDGET(self));
+    }
+
+    self->addon_service = nullptr;
+    self->addon_id = nullptr;
+    self->type = nullptr;
+    self->catalog_id = nullptr;
+    self->genres = new std::vector<std::string>();
+    self->genre_index = 0;
+    self->prefetch_source = 0;
+    self->model = nullptr;
+    setup_grid(self);
+}
+
+MadariCatalogView *madari_catalog_view_new(Stremio::AddonService *addon_service,
+                                            const char *addon_id,
+                                            const char *type,
+                                            const char *catalog_id,
+                                            const char *title) {
+    MadariCatalogView *view = MADARI_CATALOG_VIEW(g_object_new(
+        MADARI_TYPE_CATALOG_VIEW,
+        "title", title,
+        nullptr
+    ));
+
+    view->addon_service = addon_service;
+    view->addon_id = new std::string(addon_id);
+    view->type = new std::string(type);
+    view->catalog_id = new std::string(catalog_id);
+
+    load_catalog(view, setup_genres(view));
+
+    return view;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <adwaita.h>
+#include "stremio/stremio.hpp"
+
+G_BEGIN_DECLS
+
+#define MADARI_TYPE_CATALOG_VIEW (madari_catalog_view_get_type())
+
+G_DECLARE_FINAL_TYPE(MadariCatalogView, madari_catalog_view, MADARI, CATALOG_VIEW, AdwNavigationPage)
+
+/**
+ * Full-catalog grid page ("See All"), paging through the catalog's skip
+ * offsets as the user scrolls
+ */
+MadariCatalogView *madari_catalog_view_new(Stremio::AddonService *addon_service,
+                                            const char *addon_id,
+                                            const char *type,
+                                            const char *catalog_id,
+                                            const char *title);
+
+G_END_DECLS
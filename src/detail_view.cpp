@@ -1,10 +1,60 @@
 #include "detail_view.hpp"
 #include "window.hpp"
-#include <libsoup/soup.h>
+#include "stream_list.hpp"
+#include "image_loader.hpp"
+#include "profiler.hpp"
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <algorithm>
 
+// Streams resolved in the background for the most likely play target, so the
+// streams dialog can render without waiting on the addons
+static const gint64 STREAM_PREFETCH_MAX_AGE = 10 * 60 * G_USEC_PER_SEC;
+
+struct StreamPrefetch {
+    std::string video_id;
+    gint64 started_at = 0;  // Monotonic time; stream URLs (debrid links) go stale
+    std::vector<std::pair<Stremio::Manifest, std::vector<Stremio::Stream>>> batches;
+    bool done = false;
+    // Set while a streams dialog for video_id is open and still waiting for addons
+    AdwDialog *dialog = nullptr;
+    std::function<void(const Stremio::Manifest&, const std::vector<Stremio::Stream>&)> on_batch;
+    std::function<void()> on_done;
+};
+
+// Episode list item, one per video in the selected season
+#define MADARI_TYPE_EPISODE_ITEM (madari_episode_item_get_type())
+G_DECLARE_FINAL_TYPE(MadariEpisodeItem, madari_episode_item, MADARI, EPISODE_ITEM, GObject)
+
+struct _MadariEpisodeItem {
+    GObject parent_instance;
+    Stremio::Video *video;
+};
+
+G_DEFINE_TYPE(MadariEpisodeItem, madari_episode_item, G_TYPE_OBJECT)
+
+static void madari_episode_item_finalize(GObject *object) {
+    delete MADARI_EPISODE_ITEM(object)->video;
+    G_OBJECT_CLASS(madari_episode_item_parent_class)->finalize(object);
+}
+
+static void madari_episode_item_class_init(MadariEpisodeItemClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = madari_episode_item_finalize;
+}
+
+static void madari_episode_item_init(MadariEpisodeItem *self) {
+    self->video = nullptr;
+}
+
+static MadariEpisodeItem *madari_episode_item_new(const Stremio::Video& video) {
+    MadariEpisodeItem *self = MADARI_EPISODE_ITEM(g_object_new(MADARI_TYPE_EPISODE_ITEM, nullptr));
+    self->video = new Stremio::Video(video);
+    return self;
+}
+
 struct _MadariDetailView {
     AdwNavigationPage parent_instance;
     
@@ -42,9 +92,14 @@ struct _MadariDetailView {
     
     // For series
     int current_season;
-    std::map<int, std::vector<Stremio::Video>> *seasons_map;
     std::vector<int> *season_numbers;
-    GtkStringList *season_model;
+    GtkStringList *season_model;      // Owned by season_dropdown
+    GListStore *episode_store;        // MadariEpisodeItem for the selected season
+    GtkScrolledWindow *episode_scroll;
+    
+    // Speculative stream resolution
+    std::shared_ptr<StreamPrefetch> *stream_prefetch;
+    GCancellable *prefetch_cancellable;
 };
 
 G_DEFINE_TYPE(MadariDetailView, madari_detail_view, ADW_TYPE_NAVIGATION_PAGE)
@@ -52,11 +107,10 @@ G_DEFINE_TYPE(MadariDetailView, madari_detail_view, ADW_TYPE_NAVIGATION_PAGE)
 // Forward declarations
 static void load_meta(MadariDetailView *self);
 static void populate_ui(MadariDetailView *self);
-static void load_image(GtkPicture *picture, const std::string& url, int width, int height);
 static void show_streams_dialog(MadariDetailView *self, const std::string& video_id);
 static void populate_seasons(MadariDetailView *self);
 static void populate_episodes(MadariDetailView *self, int season);
-static GtkWidget* create_episode_row(MadariDetailView *self, const Stremio::Video& video);
+static void setup_episode_list(MadariDetailView *self);
 static GtkWidget* create_info_chip(const char* text);
 static GtkWidget* create_detail_row(const char* label, const std::string& value);
 static GtkWidget* create_cast_item(const std::string& name, const char* role);
@@ -67,7 +121,7 @@ struct StreamsData {
     MadariDetailView *view;
     GtkBox *content_box;
     GtkWidget *loading_box;
-    GtkListBox *streams_list;
+    MadariStreamList *stream_list;
     AdwDialog *dialog;
     std::string *meta_title;
     std::string *meta_id;
@@ -81,29 +135,30 @@ struct StreamsData {
     GtkBox *filter_box;
     std::set<std::string> *addon_names;
     std::string *active_filter;  // Empty string means "All"
+    Stremio::StreamRanker *ranker = nullptr;  // Dedupes and scores streams across addons
 };
 
-// Static callback for stream play button
-static void on_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpointer user_data) {
-    g_print("Play button clicked!\n");
-    
-    const std::string *url = static_cast<const std::string*>(
-        g_object_get_data(G_OBJECT(btn), "stream-url"));
-    const std::string *title = static_cast<const std::string*>(
-        g_object_get_data(G_OBJECT(btn), "stream-title"));
-    const std::string *binge = static_cast<const std::string*>(
-        g_object_get_data(G_OBJECT(btn), "binge-group"));
-    StreamsData *sdata = static_cast<StreamsData*>(
-        g_object_get_data(G_OBJECT(btn), "streams-data"));
-    
-    g_print("url=%p, sdata=%p, view=%p\n", (void*)url, (void*)sdata, 
-            sdata ? (void*)sdata->view : nullptr);
+// Play the activated stream from the streams dialog
+static void play_stream_item(StreamsData *sdata, MadariStreamItem *item) {
+    const Stremio::RankedStream& ranked = madari_stream_item_get_ranked(item);
+    const Stremio::Stream& stream = ranked.stream;
+    
+    std::optional<std::string> url;
+    if (stream.url.has_value()) {
+        url = *stream.url;
+    } else if (stream.external_url.has_value()) {
+        url = *stream.external_url;
+    } else if (stream.yt_id.has_value()) {
+        url = "https://youtube.com/watch?v=" + *stream.yt_id;
+    }
+    
+    const std::string *title = &madari_stream_item_get_title(item);
+    const std::string *binge = stream.behavior_hints.binge_group ? &*stream.behavior_hints.binge_group : nullptr;
+    const char *addon_id = ranked.addon_id.c_str();
     
     if (url && sdata && sdata->view) {
         // Get the main window
         GtkWidget *toplevel = GTK_WIDGET(gtk_widget_get_root(GTK_WIDGET(sdata->view)));
-        g_print("toplevel=%p, type=%s\n", (void*)toplevel, 
-                toplevel ? G_OBJECT_TYPE_NAME(toplevel) : "null");
         
         if (toplevel && MADARI_IS_WINDOW(toplevel)) {
             MadariWindow *window = MADARI_WINDOW(toplevel);
@@ -136,11 +191,6 @@ static void on_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpointer use
                 full_title = "Playing";
             }
             
-            g_print("Playing: %s\n", url->c_str());
-            
-            // Close the dialog first
-            adw_dialog_close(sdata->dialog);
-            
             // Play in the embedded player with episode context and binge group
             madari_window_play_episode(window, url->c_str(), full_title.c_str(),
                 sdata->meta_id ? sdata->meta_id->c_str() : nullptr,
@@ -148,18 +198,18 @@ static void on_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpointer use
                 sdata->video_id ? sdata->video_id->c_str() : nullptr,
                 binge ? binge->c_str() : nullptr,
                 sdata->poster_url ? sdata->poster_url->c_str() : nullptr,
-                sdata->episode);
+                sdata->episode, addon_id);
             
             // Build and set episode list for the current season
             MadariDetailView *view = sdata->view;
-            if (view && view->seasons_map && view->current_season >= 0) {
-                auto it = view->seasons_map->find(view->current_season);
-                if (it != view->seasons_map->end()) {
+            if (view && view->meta && view->meta->has_videos() && view->current_season >= 0) {
+                const auto& season_videos = view->meta->videos->season(view->current_season);
+                if (!season_videos.empty()) {
                     std::vector<MadariEpisodeInfo> episodes;
                     int current_idx = -1;
                     
                     // Sort episodes by episode number
-                    std::vector<Stremio::Video> sorted_eps = it->second;
+                    std::vector<Stremio::Video> sorted_eps = season_videos;
                     std::sort(sorted_eps.begin(), sorted_eps.end(), 
                         [](const Stremio::Video& a, const Stremio::Video& b) {
                             return a.episode.value_or(0) < b.episode.value_or(0);
@@ -185,81 +235,15 @@ static void on_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpointer use
                     }
                 }
             }
+            
+            // Close the dialog last, it owns sdata and the activated item
+            adw_dialog_close(sdata->dialog);
         } else {
             g_warning("Could not get MadariWindow to play video (toplevel is not MadariWindow)");
         }
     } else {
-        g_warning("Missing data: url=%p, sdata=%p", (void*)url, (void*)sdata);
-    }
-}
-
-static SoupSession* get_image_session() {
-    static SoupSession *session = nullptr;
-    if (!session) {
-        session = soup_session_new();
-        g_object_set(session, "timeout", 30, nullptr);
+        g_warning("Stream has no playable URL");
     }
-    return session;
-}
-
-static void load_image(GtkPicture *picture, const std::string& url, int width, int height) {
-    SoupMessage *msg = soup_message_new("GET", url.c_str());
-    if (!msg) return;
-    
-    g_object_ref(picture);
-    
-    struct LoadData {
-        int width;
-        int height;
-    };
-    LoadData *data = new LoadData{width, height};
-    g_object_set_data_full(G_OBJECT(picture), "load-data", data, 
-        [](gpointer d) { delete static_cast<LoadData*>(d); });
-    
-    soup_session_send_and_read_async(
-        get_image_session(),
-        msg,
-        G_PRIORITY_DEFAULT,
-        nullptr,
-        [](GObject *source, GAsyncResult *result, gpointer user_data) {
-            GtkPicture *picture = GTK_PICTURE(user_data);
-            g_autoptr(GError) error = nullptr;
-            
-            LoadData *data = static_cast<LoadData*>(g_object_get_data(G_OBJECT(picture), "load-data"));
-            int width = data ? data->width : 300;
-            int height = data ? data->height : 450;
-            
-            GBytes *bytes = soup_session_send_and_read_finish(SOUP_SESSION(source), result, &error);
-            
-            if (bytes && !error) {
-                gsize size;
-                const guchar *img_data = static_cast<const guchar*>(g_bytes_get_data(bytes, &size));
-                
-                if (img_data && size > 0) {
-                    g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_data(
-                        g_memdup2(img_data, size), size, g_free);
-                    
-                    GdkPixbuf *pixbuf = gdk_pixbuf_new_from_stream_at_scale(
-                        stream, width, height, TRUE, nullptr, nullptr);
-                    
-                    if (pixbuf) {
-                        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-                        GdkTexture *texture = gdk_texture_new_for_pixbuf(pixbuf);
-                        G_GNUC_END_IGNORE_DEPRECATIONS
-                        gtk_picture_set_paintable(picture, GDK_PAINTABLE(texture));
-                        g_object_unref(texture);
-                        g_object_unref(pixbuf);
-                    }
-                }
-                g_bytes_unref(bytes);
-            }
-            
-            g_object_unref(picture);
-        },
-        picture
-    );
-    
-    g_object_unref(msg);
 }
 
 static GtkWidget* create_info_chip(const char* text) {
@@ -354,19 +338,102 @@ static GtkWidget* create_trailer_button(const Stremio::Trailer& trailer) {
     return button;
 }
 
-static void on_play_clicked([[maybe_unused]] GtkButton *button, MadariDetailView *self) {
-    if (!self->meta) return;
+/**
+ * The video the user is most likely to play from this page: the movie itself,
+ * the episode in progress or the one after the last finished episode, the
+ * addon's default video, or else the first regular episode.
+ */
+static std::string pick_play_target(MadariDetailView *self) {
+    const Stremio::Meta& meta = *self->meta;
+    if (meta.type == "movie" || !meta.has_videos()) {
+        return meta.default_video_id.value_or(meta.id);
+    }
     
-    std::string video_id;
-    if (self->meta->type == "movie") {
-        video_id = self->meta->id;
-    } else if (!self->meta->videos.empty()) {
-        video_id = self->meta->videos[0].id;
-    } else {
-        video_id = self->meta->id;
+    // Episodes in viewing order, specials (season 0) last
+    std::vector<const Stremio::VideoRef*> ordered;
+    for (const auto& ref : meta.videos->refs()) {
+        ordered.push_back(&ref);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Stremio::VideoRef *a, const Stremio::VideoRef *b) {
+        int sa = a->season.value_or(1);
+        int sb = b->season.value_or(1);
+        if ((sa == 0) != (sb == 0)) return sb == 0;
+        if (sa != sb) return sa < sb;
+        return a->episode.value_or(0) < b->episode.value_or(0);
+    });
+    
+    GApplication *app = g_application_get_default();
+    Madari::WatchHistoryService *history = MADARI_IS_APPLICATION(app) ?
+        madari_application_get_watch_history(MADARI_APPLICATION(app)) : nullptr;
+    if (history) {
+        auto last = history->get_latest_for_series(*self->meta_id);
+        if (last) {
+            auto it = std::find_if(ordered.begin(), ordered.end(), [&last](const Stremio::VideoRef *v) {
+                return v->id == last->video_id;
+            });
+            if (it != ordered.end()) {
+                if (!last->is_finished()) return last->video_id;
+                if (std::next(it) != ordered.end()) return (*std::next(it))->id;
+            }
+        }
+    }
+    
+    if (meta.default_video_id.has_value()) {
+        return *meta.default_video_id;
+    }
+    return ordered.front()->id;
+}
+
+/**
+ * Resolve streams for the likely play target in the background, at low
+ * priority, so opening the streams dialog usually renders instantly.
+ * Cancelled when the page goes away.
+ */
+static void start_stream_prefetch(MadariDetailView *self) {
+    if (!self->meta || !self->meta_type) return;
+    
+    std::string video_id = pick_play_target(self);
+    if (*self->stream_prefetch && (*self->stream_prefetch)->video_id == video_id) return;
+    
+    auto prefetch = std::make_shared<StreamPrefetch>();
+    prefetch->video_id = video_id;
+    prefetch->started_at = g_get_monotonic_time();
+    *self->stream_prefetch = prefetch;
+    
+    if (!self->prefetch_cancellable) {
+        self->prefetch_cancellable = g_cancellable_new();
     }
     
-    show_streams_dialog(self, video_id);
+    Stremio::RequestOptions options;
+    options.priority = G_PRIORITY_LOW;
+    options.cancellable = self->prefetch_cancellable;
+    
+    self->addon_service->fetch_all_streams(
+        *self->meta_type,
+        video_id,
+        [prefetch](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
+            prefetch->batches.emplace_back(addon, streams);
+            if (prefetch->on_batch) {
+                prefetch->on_batch(addon, streams);
+            }
+        },
+        [prefetch]() {
+            prefetch->done = true;
+            if (prefetch->on_done) {
+                prefetch->on_done();
+            }
+            prefetch->dialog = nullptr;
+            prefetch->on_batch = nullptr;
+            prefetch->on_done = nullptr;
+        },
+        options
+    );
+}
+
+static void on_play_clicked([[maybe_unused]] GtkButton *button, MadariDetailView *self) {
+    if (!self->meta) return;
+    
+    show_streams_dialog(self, pick_play_target(self));
 }
 
 static void on_episode_play_clicked(GtkButton *button, MadariDetailView *self) {
@@ -376,21 +443,6 @@ static void on_episode_play_clicked(GtkButton *button, MadariDetailView *self) {
     }
 }
 
-// Filter streams by addon name
-static void apply_stream_filter(StreamsData *data) {
-    GtkWidget *child = gtk_widget_get_first_child(GTK_WIDGET(data->streams_list));
-    while (child) {
-        const char *addon_name = static_cast<const char*>(
-            g_object_get_data(G_OBJECT(child), "addon-name"));
-        
-        bool visible = data->active_filter->empty() || 
-                       (addon_name && *data->active_filter == addon_name);
-        gtk_widget_set_visible(child, visible);
-        
-        child = gtk_widget_get_next_sibling(child);
-    }
-}
-
 // Callback for filter button toggle
 static void on_filter_button_toggled(GtkToggleButton *button, StreamsData *data) {
     if (!gtk_toggle_button_get_active(button)) {
@@ -416,7 +468,7 @@ static void on_filter_button_toggled(GtkToggleButton *button, StreamsData *data)
     *data->active_filter = filter_name ? filter_name : "";
     
     // Apply filter
-    apply_stream_filter(data);
+    madari_stream_list_set_addon_filter(data->stream_list, *data->active_filter);
 }
 
 // Add a filter button for an addon
@@ -441,6 +493,108 @@ static void add_filter_button(StreamsData *data, const std::string& addon_name,
     gtk_box_append(data->filter_box, button);
 }
 
+// Append one addon's streams to an open streams dialog
+static void append_stream_rows(StreamsData *data, const Stremio::Manifest& addon,
+                               const std::vector<Stremio::Stream>& streams) {
+    gtk_widget_set_visible(data->loading_box, FALSE);
+    gtk_widget_set_visible(data->stream_list->scroll, TRUE);
+    
+    // Track this addon and add filter button if it's new
+    if (data->addon_names->find(addon.name) == data->addon_names->end()) {
+        // First addon - add "All" button
+        if (data->addon_names->empty()) {
+            add_filter_button(data, "", true);  // "All" button
+            // Show filter bar
+            GtkWidget *filter_scroll = static_cast<GtkWidget*>(
+                g_object_get_data(G_OBJECT(data->dialog), "filter-scroll"));
+            if (filter_scroll) {
+                gtk_widget_set_visible(filter_scroll, TRUE);
+            }
+        }
+        data->addon_names->insert(addon.name);
+        add_filter_button(data, addon.name);
+    }
+    
+    // Only streams not already offered by another addon come back; the
+    // sort model places them. Duplicates update the row they fold into.
+    std::vector<const Stremio::RankedStream*> folded;
+    auto added = data->ranker->add_batch(addon, streams, &folded);
+    madari_stream_list_append(data->stream_list, added, folded);
+}
+
+// Measure TTFB and throughput of the shown HTTP streams, annotate them and
+// move the fastest sources to the top
+static void on_probe_streams_clicked(GtkButton *button, StreamsData *data) {
+    struct ProbeItems {
+        AdwDialog *dialog;  // Keeps StreamsData alive until the probe ends
+        StreamsData *data;
+        std::vector<MadariStreamItem*> items;  // Owned refs
+        std::vector<Stremio::Stream> streams;
+    };
+    
+    Stremio::ProbeOptions options;
+    options.max_streams = 8;
+    
+    auto probe = std::shared_ptr<ProbeItems>(new ProbeItems(), [](ProbeItems *p) {
+        for (MadariStreamItem *item : p->items) {
+            g_object_unref(item);
+        }
+        delete p;
+    });
+    probe->data = data;
+    
+    // Top of the list as currently filtered and sorted
+    GListModel *visible = madari_stream_list_get_visible(data->stream_list);
+    guint n_items = g_list_model_get_n_items(visible);
+    for (guint i = 0; i < n_items && probe->items.size() < options.max_streams; i++) {
+        MadariStreamItem *item = MADARI_STREAM_ITEM(g_list_model_get_item(visible, i));
+        if (!Stremio::StreamProbe::is_probeable(madari_stream_item_get_stream(item))) {
+            g_object_unref(item);
+            continue;
+        }
+        probe->items.push_back(item);
+        probe->streams.push_back(madari_stream_item_get_stream(item));
+    }
+    
+    if (probe->streams.empty()) {
+        gtk_widget_set_tooltip_text(GTK_WIDGET(button), "No direct HTTP streams to test");
+        return;
+    }
+    
+    gtk_widget_set_sensitive(GTK_WIDGET(button), FALSE);
+    probe->dialog = ADW_DIALOG(g_object_ref(data->dialog));
+    
+    data->view->addon_service->probe_streams(probe->streams, options,
+        [probe](const Stremio::ProbeResult& result) {
+            madari_stream_list_set_probe_summary(probe->data->stream_list, probe->items[result.index],
+                                                 Stremio::StreamProbe::describe(result));
+        },
+        [probe](const std::vector<Stremio::ProbeResult>& results) {
+            int rank = 1;
+            for (const auto& result : results) {
+                if (!result.ok) continue;
+                madari_stream_item_set_probe_rank(probe->items[result.index], rank++);
+            }
+            madari_stream_list_resort(probe->data->stream_list);
+            g_object_unref(probe->dialog);
+        });
+}
+
+// All addons answered - show the empty state if nothing came back
+static void finish_stream_rows(StreamsData *data) {
+    if (madari_stream_list_get_n_items(data->stream_list) == 0) {
+        gtk_widget_set_visible(data->loading_box, FALSE);
+        
+        GtkWidget *no_streams = adw_status_page_new();
+        adw_status_page_set_icon_name(ADW_STATUS_PAGE(no_streams), "face-uncertain-symbolic");
+        adw_status_page_set_title(ADW_STATUS_PAGE(no_streams), "No Streams Available");
+        adw_status_page_set_description(ADW_STATUS_PAGE(no_streams), 
+            "No streaming sources were found for this content.");
+        gtk_widget_set_vexpand(no_streams, TRUE);
+        gtk_box_append(data->content_box, no_streams);
+    }
+}
+
 static void show_streams_dialog(MadariDetailView *self, const std::string& video_id) {
     AdwDialog *dialog = adw_dialog_new();
     adw_dialog_set_title(dialog, "Select Stream");
@@ -452,8 +606,9 @@ static void show_streams_dialog(MadariDetailView *self, const std::string& video
     GtkWidget *header = adw_header_bar_new();
     adw_toolbar_view_add_top_bar(ADW_TOOLBAR_VIEW(toolbar_view), header);
     
-    GtkWidget *scroll = gtk_scrolled_window_new();
-    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroll), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    GtkWidget *probe_button = gtk_button_new_with_label("Test Speed");
+    gtk_widget_set_tooltip_text(probe_button, "Measure how fast each direct source responds");
+    adw_header_bar_pack_start(ADW_HEADER_BAR(header), probe_button);
     
     GtkWidget *content_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 8);
     gtk_widget_set_margin_start(content_box, 16);
@@ -478,8 +633,8 @@ static void show_streams_dialog(MadariDetailView *self, const std::string& video
     
     gtk_box_append(GTK_BOX(content_box), loading_box);
     
-    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroll), content_box);
-    adw_toolbar_view_set_content(ADW_TOOLBAR_VIEW(toolbar_view), scroll);
+    // The stream list scrolls on its own so only visible rows get widgets
+    adw_toolbar_view_set_content(ADW_TOOLBAR_VIEW(toolbar_view), content_box);
     adw_dialog_set_child(dialog, toolbar_view);
     
     // Filter bar (horizontal scrollable box with toggle buttons)
@@ -492,13 +647,6 @@ static void show_streams_dialog(MadariDetailView *self, const std::string& video
     gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(filter_scroll), filter_box);
     gtk_box_append(GTK_BOX(content_box), filter_scroll);
     
-    // Streams list
-    GtkWidget *streams_list = gtk_list_box_new();
-    gtk_list_box_set_selection_mode(GTK_LIST_BOX(streams_list), GTK_SELECTION_NONE);
-    gtk_widget_add_css_class(streams_list, "boxed-list");
-    gtk_widget_set_visible(streams_list, FALSE);
-    gtk_box_append(GTK_BOX(content_box), streams_list);
-    
     std::string *meta_title = new std::string(self->meta ? self->meta->name : "Video");
     std::string *meta_id = new std::string(self->meta_id ? *self->meta_id : "");
     std::string *meta_type = new std::string(self->meta_type ? *self->meta_type : "");
@@ -510,13 +658,11 @@ static void show_streams_dialog(MadariDetailView *self, const std::string& video
     int episode_num = 0;
     
     if (self->meta && self->meta_type && *self->meta_type == "series") {
-        for (const auto& video : self->meta->videos) {
-            if (video.id == video_id) {
-                episode_title = new std::string(video.title);
-                season_num = video.season.value_or(0);
-                episode_num = video.episode.value_or(0);
-                break;
-            }
+        const Stremio::Video *video = self->meta->has_videos() ? self->meta->videos->find(video_id) : nullptr;
+        if (video) {
+            episode_title = new std::string(video->title);
+            season_num = video->season.value_or(0);
+            episode_num = video->episode.value_or(0);
         }
     }
     
@@ -531,10 +677,30 @@ static void show_streams_dialog(MadariDetailView *self, const std::string& video
     }
     
     StreamsData *data = new StreamsData{
-        self, GTK_BOX(content_box), loading_box, GTK_LIST_BOX(streams_list), dialog, 
+        self, GTK_BOX(content_box), loading_box, nullptr, dialog, 
         meta_title, meta_id, meta_type, vid_id, episode_title, poster_url, season_num, episode_num,
         GTK_BOX(filter_box), addon_names, active_filter
     };
+    data->ranker = new Stremio::StreamRanker();
+    
+    // Streams list
+    data->stream_list = madari_stream_list_new([data](MadariStreamItem *item) {
+        play_stream_item(data, item);
+    });
+    gtk_widget_set_visible(data->stream_list->scroll, FALSE);
+    gtk_box_append(GTK_BOX(content_box), data->stream_list->scroll);
+    
+    // Sources that played well before rise, ones that kept failing sink
+    GApplication *app = g_application_get_default();
+    Madari::SourceStatsService *source_stats = MADARI_IS_APPLICATION(app) ?
+        madari_application_get_source_stats(MADARI_APPLICATION(app)) : nullptr;
+    if (source_stats) {
+        data->ranker->set_preference([source_stats](const std::string& addon_id, const Stremio::Stream& stream) {
+            return source_stats->preference(addon_id, stream);
+        });
+    }
+    
+    g_signal_connect(probe_button, "clicked", G_CALLBACK(on_probe_streams_clicked), data);
     
     // Store filter_scroll reference for later visibility toggle
     g_object_set_data(G_OBJECT(dialog), "filter-scroll", filter_scroll);
@@ -550,161 +716,50 @@ static void show_streams_dialog(MadariDetailView *self, const std::string& video
             if (sd->poster_url) delete sd->poster_url;
             delete sd->addon_names;
             delete sd->active_filter;
+            // Items point into the ranker
+            madari_stream_list_free(sd->stream_list);
+            delete sd->ranker;
             delete sd; 
         });
     
-    self->addon_service->fetch_all_streams(
-        *self->meta_type,
-        video_id,
-        [data](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
-            gtk_widget_set_visible(data->loading_box, FALSE);
-            gtk_widget_set_visible(GTK_WIDGET(data->streams_list), TRUE);
-            
-            // Track this addon and add filter button if it's new
-            if (data->addon_names->find(addon.name) == data->addon_names->end()) {
-                // First addon - add "All" button
-                if (data->addon_names->empty()) {
-                    add_filter_button(data, "", true);  // "All" button
-                    // Show filter bar
-                    GtkWidget *filter_scroll = static_cast<GtkWidget*>(
-                        g_object_get_data(G_OBJECT(data->dialog), "filter-scroll"));
-                    if (filter_scroll) {
-                        gtk_widget_set_visible(filter_scroll, TRUE);
-                    }
-                }
-                data->addon_names->insert(addon.name);
-                add_filter_button(data, addon.name);
-            }
-            
-            for (const auto& stream : streams) {
-                GtkWidget *row = adw_action_row_new();
-                
-                // Build stream title - prefer name, then title
-                std::string title;
-                std::string details;
-                
-                if (stream.name.has_value() && !stream.name->empty()) {
-                    // Stream name often contains quality info like "Torrentio\n4K"
-                    // Replace newlines with " • "
-                    title = *stream.name;
-                    size_t pos;
-                    while ((pos = title.find('\n')) != std::string::npos) {
-                        title.replace(pos, 1, " • ");
-                    }
-                }
-                
-                if (stream.title.has_value() && !stream.title->empty()) {
-                    if (title.empty()) {
-                        title = *stream.title;
-                    } else {
-                        details = *stream.title;
-                    }
-                }
-                
-                if (title.empty()) {
-                    title = "Stream";
-                }
-                
-                // Use description for more details
-                if (stream.description.has_value() && !stream.description->empty()) {
-                    if (details.empty()) {
-                        details = *stream.description;
-                    }
-                }
-                
-                // Set title - escape markup
-                gchar *escaped_title = g_markup_escape_text(title.c_str(), -1);
-                adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), escaped_title);
-                g_free(escaped_title);
-                adw_action_row_set_title_lines(ADW_ACTION_ROW(row), 0);  // 0 = no limit, show full title
-                
-                // Subtitle with details and addon name
-                std::string subtitle;
-                if (!details.empty()) {
-                    subtitle = details;
-                }
-                subtitle += (subtitle.empty() ? "" : "\n") + addon.name;
-                
-                gchar *escaped_subtitle = g_markup_escape_text(subtitle.c_str(), -1);
-                adw_action_row_set_subtitle(ADW_ACTION_ROW(row), escaped_subtitle);
-                g_free(escaped_subtitle);
-                adw_action_row_set_subtitle_lines(ADW_ACTION_ROW(row), 0);  // 0 = no limit, show full subtitle
-                
-                // Icon
-                GtkWidget *icon;
-                if (stream.info_hash.has_value()) {
-                    icon = gtk_image_new_from_icon_name("network-transmit-symbolic");
-                } else if (stream.yt_id.has_value()) {
-                    icon = gtk_image_new_from_icon_name("video-display-symbolic");
-                } else {
-                    icon = gtk_image_new_from_icon_name("network-server-symbolic");
-                }
-                adw_action_row_add_prefix(ADW_ACTION_ROW(row), icon);
-                
-                // Play button
-                GtkWidget *play_btn = gtk_button_new_from_icon_name("media-playback-start-symbolic");
-                gtk_widget_add_css_class(play_btn, "flat");
-                gtk_widget_set_valign(play_btn, GTK_ALIGN_CENTER);
-                
-                std::string *stream_url = nullptr;
-                if (stream.url.has_value()) {
-                    stream_url = new std::string(*stream.url);
-                } else if (stream.external_url.has_value()) {
-                    stream_url = new std::string(*stream.external_url);
-                } else if (stream.yt_id.has_value()) {
-                    stream_url = new std::string("https://youtube.com/watch?v=" + *stream.yt_id);
-                }
-                
-                if (stream_url) {
-                    // Store stream URL
-                    g_object_set_data_full(G_OBJECT(play_btn), "stream-url", stream_url,
-                        (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
-                    
-                    // Store title for player window
-                    std::string *stream_title = new std::string(title);
-                    g_object_set_data_full(G_OBJECT(play_btn), "stream-title", stream_title,
-                        (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
-                    
-                    // Store binge_group if available
-                    if (stream.behavior_hints.binge_group.has_value()) {
-                        std::string *binge = new std::string(*stream.behavior_hints.binge_group);
-                        g_object_set_data_full(G_OBJECT(play_btn), "binge-group", binge,
-                            (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
-                    }
-                    
-                    // Store data pointer for dialog close
-                    g_object_set_data(G_OBJECT(play_btn), "streams-data", data);
-                    
-                    g_signal_connect(play_btn, "clicked", G_CALLBACK(on_stream_play_clicked), nullptr);
+    // Render from the background prefetch when it targeted this video
+    std::shared_ptr<StreamPrefetch> prefetch = *self->stream_prefetch;
+    if (prefetch && prefetch->video_id == video_id &&
+        g_get_monotonic_time() - prefetch->started_at < STREAM_PREFETCH_MAX_AGE) {
+        for (const auto& [addon, streams] : prefetch->batches) {
+            append_stream_rows(data, addon, streams);
+        }
+        if (prefetch->done) {
+            finish_stream_rows(data);
+        } else {
+            prefetch->on_batch = [data](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
+                append_stream_rows(data, addon, streams);
+            };
+            prefetch->on_done = [data]() {
+                finish_stream_rows(data);
+            };
+            prefetch->dialog = dialog;
+            g_signal_connect(dialog, "closed", G_CALLBACK(+[](AdwDialog *dialog, MadariDetailView *view) {
+                if (view->stream_prefetch && *view->stream_prefetch &&
+                    (*view->stream_prefetch)->dialog == dialog) {
+                    (*view->stream_prefetch)->dialog = nullptr;
+                    (*view->stream_prefetch)->on_batch = nullptr;
+                    (*view->stream_prefetch)->on_done = nullptr;
                 }
-                
-                adw_action_row_add_suffix(ADW_ACTION_ROW(row), play_btn);
-                adw_action_row_set_activatable_widget(ADW_ACTION_ROW(row), play_btn);
-                
-                // Store addon name on row for filtering
-                std::string *row_addon_name = new std::string(addon.name);
-                g_object_set_data_full(G_OBJECT(row), "addon-name", 
-                    const_cast<char*>(row_addon_name->c_str()), nullptr);
-                g_object_set_data_full(G_OBJECT(row), "addon-name-str", row_addon_name,
-                    [](gpointer d) { delete static_cast<std::string*>(d); });
-                
-                gtk_list_box_append(data->streams_list, row);
-            }
-        },
-        [data]() {
-            GtkWidget *first = gtk_widget_get_first_child(GTK_WIDGET(data->streams_list));
-            if (!first) {
-                gtk_widget_set_visible(data->loading_box, FALSE);
-                
-                GtkWidget *no_streams = adw_status_page_new();
-                adw_status_page_set_icon_name(ADW_STATUS_PAGE(no_streams), "face-uncertain-symbolic");
-                adw_status_page_set_title(ADW_STATUS_PAGE(no_streams), "No Streams Available");
-                adw_status_page_set_description(ADW_STATUS_PAGE(no_streams), 
-                    "No streaming sources were found for this content.");
-                gtk_box_append(data->content_box, no_streams);
-            }
+            }), self);
         }
-    );
+    } else {
+        self->addon_service->fetch_all_streams(
+            *self->meta_type,
+            video_id,
+            [data](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
+                append_stream_rows(data, addon, streams);
+            },
+            [data]() {
+                finish_stream_rows(data);
+            }
+        );
+    }
     
     adw_dialog_present(dialog, GTK_WIDGET(self));
 }
@@ -719,39 +774,41 @@ static void on_season_changed(GtkDropDown *dropdown, [[maybe_unused]] GParamSpec
 }
 
 static void populate_seasons(MadariDetailView *self) {
-    if (!self->meta || self->meta->videos.empty()) return;
-    
-    // Organize videos by season
-    self->seasons_map->clear();
-    self->season_numbers->clear();
-    
-    for (const auto& video : self->meta->videos) {
-        int season = video.season.value_or(1);
-        (*self->seasons_map)[season].push_back(video);
-    }
+    if (!self->meta || !self->meta->has_videos()) return;
     
-    if (self->seasons_map->empty()) return;
+    // Seasons come from the index; episodes are parsed when a season is shown
+    *self->season_numbers = self->meta->videos->seasons();
+    if (self->season_numbers->empty()) return;
     
     // Create season model for dropdown
     self->season_model = gtk_string_list_new(nullptr);
     
-    for (const auto& [season, videos] : *self->seasons_map) {
-        self->season_numbers->push_back(season);
-        std::string label = "Season " + std::to_string(season) + " (" + std::to_string(videos.size()) + " episodes)";
+    for (int season : *self->season_numbers) {
+        size_t count = self->meta->videos->season_size(season);
+        std::string label = "Season " + std::to_string(season) + " (" + std::to_string(count) + " episodes)";
         gtk_string_list_append(self->season_model, label.c_str());
     }
     
+    // A revalidated meta repopulates the page; stay on the season being viewed
+    guint selected = 0;
+    if (gtk_widget_get_visible(GTK_WIDGET(self->episodes_section))) {
+        auto it = std::find(self->season_numbers->begin(), self->season_numbers->end(), self->current_season);
+        if (it != self->season_numbers->end()) {
+            selected = static_cast<guint>(it - self->season_numbers->begin());
+        }
+    }
+    
+    g_signal_handlers_disconnect_by_func(self->season_dropdown, (gpointer)on_season_changed, self);
     gtk_drop_down_set_model(self->season_dropdown, G_LIST_MODEL(self->season_model));
-    gtk_drop_down_set_selected(self->season_dropdown, 0);
+    g_object_unref(self->season_model);  // The dropdown holds it
+    gtk_drop_down_set_selected(self->season_dropdown, selected);
     
     // Connect to selection changes
     g_signal_connect(self->season_dropdown, "notify::selected", 
                      G_CALLBACK(on_season_changed), self);
     
     // Set current season
-    if (!self->season_numbers->empty()) {
-        self->current_season = (*self->season_numbers)[0];
-    }
+    self->current_season = (*self->season_numbers)[selected];
     
     // Show episodes section
     gtk_widget_set_visible(GTK_WIDGET(self->episodes_section), TRUE);
@@ -759,27 +816,42 @@ static void populate_seasons(MadariDetailView *self) {
 }
 
 static void populate_episodes(MadariDetailView *self, int season) {
-    GtkWidget *child;
-    while ((child = gtk_widget_get_first_child(GTK_WIDGET(self->episodes_box))) != nullptr) {
-        gtk_box_remove(self->episodes_box, child);
+    std::vector<const Stremio::Video*> episodes;
+    if (self->meta && self->meta->has_videos()) {
+        for (const auto& video : self->meta->videos->season(season)) {
+            episodes.push_back(&video);
+        }
     }
-    
-    auto it = self->seasons_map->find(season);
-    if (it == self->seasons_map->end()) return;
-    
-    std::vector<Stremio::Video> episodes = it->second;
-    std::sort(episodes.begin(), episodes.end(), [](const Stremio::Video& a, const Stremio::Video& b) {
-        return a.episode.value_or(0) < b.episode.value_or(0);
+    std::stable_sort(episodes.begin(), episodes.end(), [](const Stremio::Video *a, const Stremio::Video *b) {
+        return a->episode.value_or(0) < b->episode.value_or(0);
     });
     
-    // Create episode cards in a flow layout
-    for (const auto& video : episodes) {
-        GtkWidget *card = create_episode_row(self, video);
-        gtk_box_append(self->episodes_box, card);
+    std::vector<gpointer> items;
+    items.reserve(episodes.size());
+    for (const Stremio::Video *video : episodes) {
+        items.push_back(madari_episode_item_new(*video));
     }
+    
+    // Replace the whole season in one splice; the list view only builds
+    // (and loads thumbnails for) the rows that end up on screen
+    g_list_store_splice(self->episode_store, 0,
+                        g_list_model_get_n_items(G_LIST_MODEL(self->episode_store)),
+                        items.data(), static_cast<guint>(items.size()));
+    for (gpointer item : items) {
+        g_object_unref(item);
+    }
+    
+    gtk_adjustment_set_value(gtk_scrolled_window_get_vadjustment(self->episode_scroll), 0);
 }
 
-static GtkWidget* create_episode_row(MadariDetailView *self, const Stremio::Video& video) {
+// ============= Episode Rows =============
+
+// Rows are built once per visible slot and rebound as the list scrolls
+static void on_episode_row_setup([[maybe_unused]] GtkSignalListItemFactory *factory,
+                                 GtkListItem *list_item, MadariDetailView *self) {
+    gtk_list_item_set_activatable(list_item, FALSE);
+    gtk_list_item_set_selectable(list_item, FALSE);
+    
     // Create a horizontal card for episode
     GtkWidget *card = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 16);
     gtk_widget_add_css_class(card, "card");
@@ -792,7 +864,7 @@ static GtkWidget* create_episode_row(MadariDetailView *self, const Stremio::Vide
     
     GtkWidget *thumb_overlay = gtk_overlay_new();
     
-    // Placeholder
+    // Placeholder, covered once the thumbnail arrives
     GtkWidget *thumb_placeholder = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
     gtk_widget_set_size_request(thumb_placeholder, 178, 100);
     GtkWidget *thumb_icon = gtk_image_new_from_icon_name("video-x-generic-symbolic");
@@ -804,25 +876,19 @@ static GtkWidget* create_episode_row(MadariDetailView *self, const Stremio::Vide
     gtk_box_append(GTK_BOX(thumb_placeholder), thumb_icon);
     gtk_overlay_set_child(GTK_OVERLAY(thumb_overlay), thumb_placeholder);
     
-    // Actual thumbnail
-    if (video.thumbnail.has_value() && !video.thumbnail->empty()) {
-        GtkWidget *thumb = gtk_picture_new();
-        gtk_widget_set_size_request(thumb, 178, 100);
-        gtk_picture_set_content_fit(GTK_PICTURE(thumb), GTK_CONTENT_FIT_COVER);
-        load_image(GTK_PICTURE(thumb), *video.thumbnail, 178, 100);
-        gtk_overlay_add_overlay(GTK_OVERLAY(thumb_overlay), thumb);
-    }
+    GtkWidget *thumb = gtk_picture_new();
+    gtk_widget_set_size_request(thumb, 178, 100);
+    gtk_picture_set_content_fit(GTK_PICTURE(thumb), GTK_CONTENT_FIT_COVER);
+    gtk_overlay_add_overlay(GTK_OVERLAY(thumb_overlay), thumb);
     
     // Episode number badge
-    if (video.episode.has_value()) {
-        GtkWidget *badge = gtk_label_new(std::to_string(*video.episode).c_str());
-        gtk_widget_add_css_class(badge, "heading");
-        gtk_widget_set_halign(badge, GTK_ALIGN_START);
-        gtk_widget_set_valign(badge, GTK_ALIGN_END);
-        gtk_widget_set_margin_start(badge, 8);
-        gtk_widget_set_margin_bottom(badge, 8);
-        gtk_overlay_add_overlay(GTK_OVERLAY(thumb_overlay), badge);
-    }
+    GtkWidget *badge = gtk_label_new(nullptr);
+    gtk_widget_add_css_class(badge, "heading");
+    gtk_widget_set_halign(badge, GTK_ALIGN_START);
+    gtk_widget_set_valign(badge, GTK_ALIGN_END);
+    gtk_widget_set_margin_start(badge, 8);
+    gtk_widget_set_margin_bottom(badge, 8);
+    gtk_overlay_add_overlay(GTK_OVERLAY(thumb_overlay), badge);
     
     gtk_frame_set_child(GTK_FRAME(thumb_frame), thumb_overlay);
     gtk_box_append(GTK_BOX(card), thumb_frame);
@@ -835,41 +901,30 @@ static GtkWidget* create_episode_row(MadariDetailView *self, const Stremio::Vide
     gtk_widget_set_margin_bottom(info_box, 12);
     gtk_widget_set_margin_end(info_box, 8);
     
-    // Title
-    std::string title = video.title;
-    if (title.empty() && video.episode.has_value()) {
-        title = "Episode " + std::to_string(*video.episode);
-    }
-    GtkWidget *title_label = gtk_label_new(title.c_str());
+    GtkWidget *title_label = gtk_label_new(nullptr);
     gtk_widget_add_css_class(title_label, "heading");
     gtk_widget_set_halign(title_label, GTK_ALIGN_START);
     gtk_label_set_ellipsize(GTK_LABEL(title_label), PANGO_ELLIPSIZE_END);
     gtk_label_set_max_width_chars(GTK_LABEL(title_label), 50);
     gtk_box_append(GTK_BOX(info_box), title_label);
     
-    // Overview
-    if (video.overview.has_value() && !video.overview->empty()) {
-        GtkWidget *overview_label = gtk_label_new(video.overview->c_str());
-        gtk_widget_add_css_class(overview_label, "dim-label");
-        gtk_widget_add_css_class(overview_label, "caption");
-        gtk_widget_set_halign(overview_label, GTK_ALIGN_START);
-        gtk_label_set_ellipsize(GTK_LABEL(overview_label), PANGO_ELLIPSIZE_END);
-        gtk_label_set_lines(GTK_LABEL(overview_label), 2);
-        gtk_label_set_max_width_chars(GTK_LABEL(overview_label), 80);
-        gtk_label_set_wrap(GTK_LABEL(overview_label), TRUE);
-        gtk_label_set_xalign(GTK_LABEL(overview_label), 0);
-        gtk_box_append(GTK_BOX(info_box), overview_label);
-    }
-    
-    // Release date if available
-    if (!video.released.empty()) {
-        GtkWidget *date_label = gtk_label_new(video.released.substr(0, 10).c_str());
-        gtk_widget_add_css_class(date_label, "dim-label");
-        gtk_widget_add_css_class(date_label, "caption");
-        gtk_widget_set_halign(date_label, GTK_ALIGN_START);
-        gtk_widget_set_margin_top(date_label, 4);
-        gtk_box_append(GTK_BOX(info_box), date_label);
-    }
+    GtkWidget *overview_label = gtk_label_new(nullptr);
+    gtk_widget_add_css_class(overview_label, "dim-label");
+    gtk_widget_add_css_class(overview_label, "caption");
+    gtk_widget_set_halign(overview_label, GTK_ALIGN_START);
+    gtk_label_set_ellipsize(GTK_LABEL(overview_label), PANGO_ELLIPSIZE_END);
+    gtk_label_set_lines(GTK_LABEL(overview_label), 2);
+    gtk_label_set_max_width_chars(GTK_LABEL(overview_label), 80);
+    gtk_label_set_wrap(GTK_LABEL(overview_label), TRUE);
+    gtk_label_set_xalign(GTK_LABEL(overview_label), 0);
+    gtk_box_append(GTK_BOX(info_box), overview_label);
+    
+    GtkWidget *date_label = gtk_label_new(nullptr);
+    gtk_widget_add_css_class(date_label, "dim-label");
+    gtk_widget_add_css_class(date_label, "caption");
+    gtk_widget_set_halign(date_label, GTK_ALIGN_START);
+    gtk_widget_set_margin_top(date_label, 4);
+    gtk_box_append(GTK_BOX(info_box), date_label);
     
     gtk_box_append(GTK_BOX(card), info_box);
     
@@ -879,17 +934,86 @@ static GtkWidget* create_episode_row(MadariDetailView *self, const Stremio::Vide
     gtk_widget_add_css_class(play_btn, "suggested-action");
     gtk_widget_set_valign(play_btn, GTK_ALIGN_CENTER);
     gtk_widget_set_margin_end(play_btn, 16);
-    
-    std::string *video_id = new std::string(video.id);
-    g_object_set_data_full(G_OBJECT(play_btn), "video-id", 
-        const_cast<char*>(video_id->c_str()), nullptr);
-    g_object_set_data_full(G_OBJECT(card), "video-id-str", video_id,
-        [](gpointer d) { delete static_cast<std::string*>(d); });
-    
     g_signal_connect(play_btn, "clicked", G_CALLBACK(on_episode_play_clicked), self);
     gtk_box_append(GTK_BOX(card), play_btn);
     
-    return card;
+    g_object_set_data(G_OBJECT(card), "thumb", thumb);
+    g_object_set_data(G_OBJECT(card), "badge", badge);
+    g_object_set_data(G_OBJECT(card), "title", title_label);
+    g_object_set_data(G_OBJECT(card), "overview", overview_label);
+    g_object_set_data(G_OBJECT(card), "date", date_label);
+    g_object_set_data(G_OBJECT(card), "play-button", play_btn);
+    gtk_list_item_set_child(list_item, card);
+}
+
+static void on_episode_row_bind([[maybe_unused]] GtkSignalListItemFactory *factory,
+                                GtkListItem *list_item, [[maybe_unused]] MadariDetailView *self) {
+    const Stremio::Video& video = *MADARI_EPISODE_ITEM(gtk_list_item_get_item(list_item))->video;
+    GObject *card = G_OBJECT(gtk_list_item_get_child(list_item));
+    
+    GtkPicture *thumb = GTK_PICTURE(g_object_get_data(card, "thumb"));
+    if (video.thumbnail.has_value() && !video.thumbnail->empty()) {
+        madari_image_load(thumb, *video.thumbnail, 178, 100);
+    } else {
+        gtk_picture_set_paintable(thumb, nullptr);
+    }
+    
+    GtkWidget *badge = GTK_WIDGET(g_object_get_data(card, "badge"));
+    gtk_widget_set_visible(badge, video.episode.has_value());
+    if (video.episode.has_value()) {
+        gtk_label_set_text(GTK_LABEL(badge), std::to_string(*video.episode).c_str());
+    }
+    
+    std::string title = video.title;
+    if (title.empty() && video.episode.has_value()) {
+        title = "Episode " + std::to_string(*video.episode);
+    }
+    gtk_label_set_text(GTK_LABEL(g_object_get_data(card, "title")), title.c_str());
+    
+    GtkWidget *overview = GTK_WIDGET(g_object_get_data(card, "overview"));
+    bool has_overview = video.overview.has_value() && !video.overview->empty();
+    gtk_label_set_text(GTK_LABEL(overview), has_overview ? video.overview->c_str() : "");
+    gtk_widget_set_visible(overview, has_overview);
+    
+    GtkWidget *date = GTK_WIDGET(g_object_get_data(card, "date"));
+    gtk_label_set_text(GTK_LABEL(date), video.released.substr(0, 10).c_str());
+    gtk_widget_set_visible(date, !video.released.empty());
+    
+    g_object_set_data_full(G_OBJECT(g_object_get_data(card, "play-button")), "video-id",
+                           g_strdup(video.id.c_str()), g_free);
+}
+
+static void on_episode_row_unbind([[maybe_unused]] GtkSignalListItemFactory *factory,
+                                  GtkListItem *list_item, [[maybe_unused]] MadariDetailView *self) {
+    // Scrolled out of view: don't spend a download slot on it
+    GtkPicture *thumb = GTK_PICTURE(g_object_get_data(G_OBJECT(gtk_list_item_get_child(list_item)), "thumb"));
+    madari_image_cancel(thumb);
+    gtk_picture_set_paintable(thumb, nullptr);
+}
+
+static void setup_episode_list(MadariDetailView *self) {
+    self->episode_store = g_list_store_new(MADARI_TYPE_EPISODE_ITEM);
+    
+    GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+    g_signal_connect(factory, "setup", G_CALLBACK(on_episode_row_setup), self);
+    g_signal_connect(factory, "bind", G_CALLBACK(on_episode_row_bind), self);
+    g_signal_connect(factory, "unbind", G_CALLBACK(on_episode_row_unbind), self);
+    
+    GtkNoSelection *selection = gtk_no_selection_new(G_LIST_MODEL(g_object_ref(self->episode_store)));
+    GtkWidget *list_view = gtk_list_view_new(GTK_SELECTION_MODEL(selection), factory);
+    gtk_widget_add_css_class(list_view, "episode-list");
+    
+    // The page scrolls as a whole, so the list gets its own bounded viewport;
+    // inside the outer scroll it would be sized to (and realize) every row.
+    // Short seasons shrink to their natural height.
+    GtkWidget *scroll = gtk_scrolled_window_new();
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroll), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    gtk_scrolled_window_set_max_content_height(GTK_SCROLLED_WINDOW(scroll), 640);
+    gtk_scrolled_window_set_propagate_natural_height(GTK_SCROLLED_WINDOW(scroll), TRUE);
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroll), list_view);
+    gtk_box_append(self->episodes_box, scroll);
+    
+    self->episode_scroll = GTK_SCROLLED_WINDOW(scroll);
 }
 
 static void populate_ui(MadariDetailView *self) {
@@ -901,12 +1025,12 @@ static void populate_ui(MadariDetailView *self) {
     
     // Load background (picture is always visible, just empty until loaded)
     if (self->meta->background.has_value() && !self->meta->background->empty()) {
-        load_image(self->background_picture, *self->meta->background, 1200, 400);
+        madari_image_load(self->background_picture, *self->meta->background, 1200, 400);
     }
     
     // Load poster
     if (self->meta->poster.has_value() && !self->meta->poster->empty()) {
-        load_image(self->poster, *self->meta->poster, 200, 300);
+        madari_image_load(self->poster, *self->meta->poster, 200, 300);
     }
     
     // Info chips (year, rating, runtime, genres)
@@ -1011,7 +1135,7 @@ static void populate_ui(MadariDetailView *self) {
     }
     
     // Handle series with seasons
-    if (self->meta->type == "series" && !self->meta->videos.empty()) {
+    if (self->meta->type == "series" && self->meta->has_videos()) {
         populate_seasons(self);
     } else {
         gtk_widget_set_visible(GTK_WIDGET(self->seasons_box), FALSE);
@@ -1019,39 +1143,74 @@ static void populate_ui(MadariDetailView *self) {
     }
     
     gtk_stack_set_visible_child_name(self->main_stack, "content");
+    
+    // Resolve streams for the likely target once the page has settled
+    g_idle_add_full(G_PRIORITY_LOW, [](gpointer user_data) -> gboolean {
+        MadariDetailView *self = MADARI_DETAIL_VIEW(user_data);
+        if (self->stream_prefetch) {
+            start_stream_prefetch(self);
+        }
+        return G_SOURCE_REMOVE;
+    }, g_object_ref(self), g_object_unref);
 }
 
 static void load_meta(MadariDetailView *self) {
     gtk_stack_set_visible_child_name(self->main_stack, "loading");
     
-    self->addon_service->fetch_meta(
+    // Cached metas render right away; a background revalidation may call
+    // back again with fresher data, possibly after the page was closed.
+    // Addons below the first to answer fill in what it lacked, re-rendering
+    // the page each time.
+    std::shared_ptr<MadariDetailView> view(MADARI_DETAIL_VIEW(g_object_ref(self)), g_object_unref);
+    
+    self->addon_service->fetch_meta_cached(
         *self->meta_type,
         *self->meta_id,
-        [self](std::optional<Stremio::MetaResponse> response, const std::string& error) {
+        [view](std::optional<Stremio::MetaResponse> response, const std::string& error,
+               [[maybe_unused]] bool from_cache) {
+            MadariDetailView *self = view.get();
+            if (!self->meta_id) return;  // Disposed
+            
             if (response) {
+                delete self->meta;
                 self->meta = new Stremio::Meta(response->meta);
                 populate_ui(self);
-            } else {
+            } else if (!self->meta) {
                 gtk_stack_set_visible_child_name(self->main_stack, "error");
                 g_warning("Failed to load meta: %s", error.c_str());
             }
-        }
+        },
+        Stremio::MetaFanoutMode::Merge
     );
 }
 
 static void madari_detail_view_dispose(GObject *object) {
     MadariDetailView *self = MADARI_DETAIL_VIEW(object);
     
+    // Abort speculative requests; the prefetch state outlives us until they report back
+    if (self->prefetch_cancellable) {
+        g_cancellable_cancel(self->prefetch_cancellable);
+        g_clear_object(&self->prefetch_cancellable);
+    }
+    if (self->stream_prefetch) {
+        if (*self->stream_prefetch) {
+            (*self->stream_prefetch)->dialog = nullptr;
+            (*self->stream_prefetch)->on_batch = nullptr;
+            (*self->stream_prefetch)->on_done = nullptr;
+        }
+        delete self->stream_prefetch;
+        self->stream_prefetch = nullptr;
+    }
+    
     delete self->meta_id;
     delete self->meta_type;
     delete self->meta;
-    delete self->seasons_map;
     delete self->season_numbers;
+    g_clear_object(&self->episode_store);
     
     self->meta_id = nullptr;
     self->meta_type = nullptr;
     self->meta = nullptr;
-    self->seasons_map = nullptr;
     self->season_numbers = nullptr;
     self->season_model = nullptr;
     
@@ -1089,16 +1248,21 @@ static void madari_detail_view_class_init(MadariDetailViewClass *klass) {
 }
 
 static void madari_detail_view_init(MadariDetailView *self) {
-    gtk_widget_init_template(GTK_WIDGET(self));
+    {
+        Madari::ProfileSpan span("detail view template init", "ui");
+        gtk_widget_init_template(GTK_WIDGET(self));
+    }
     
     self->meta_id = nullptr;
     self->meta_type = nullptr;
     self->meta = nullptr;
     self->addon_service = nullptr;
     self->current_season = 1;
-    self->seasons_map = new std::map<int, std::vector<Stremio::Video>>();
     self->season_numbers = new std::vector<int>();
     self->season_model = nullptr;
+    self->stream_prefetch = new std::shared_ptr<StreamPrefetch>();
+    setup_episode_list(self);
+    self->prefetch_cancellable = nullptr;
     
     // Connect play button
     g_signal_connect(self->play_button, "clicked", G_CALLBACK(on_play_clicked), self);
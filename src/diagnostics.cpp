@@ -0,0 +1,196 @@
+#include "diagnostics.hpp"
+#include "application.hpp"
+#include "window.hpp"
+#include "image_loader.hpp"
+#include <json-glib/json-glib.h>
+#include <algorithm>
+#include <ctime>
+
+namespace Madari {
+
+// Main loop probe period; also the resolution of the latency figures
+static const guint PROBE_INTERVAL_MS = 100;
+
+// Samples kept, one minute's worth
+static const size_t PROBE_SAMPLES = 600;
+
+Diagnostics::Diagnostics(MadariApplication* app)
+    : app_(app),
+      probe_source_(0),
+      probe_expected_(0),
+      lateness_next_(0) {
+    lateness_ms_.reserve(PROBE_SAMPLES);
+}
+
+Diagnostics::~Diagnostics() {
+    stop_probe();
+}
+
+void Diagnostics::start_probe() {
+    if (probe_source_) return;
+
+    lateness_ms_.clear();
+    lateness_next_ = 0;
+    probe_expected_ = g_get_monotonic_time() + PROBE_INTERVAL_MS * 1000;
+    probe_source_ = g_timeout_add(PROBE_INTERVAL_MS, [](gpointer data) -> gboolean {
+        static_cast<Diagnostics*>(data)->on_probe();
+        return G_SOURCE_CONTINUE;
+    }, this);
+}
+
+void Diagnostics::stop_probe() {
+    g_clear_handle_id(&probe_source_, g_source_remove);
+}
+
+void Diagnostics::on_probe() {
+    gint64 now = g_get_monotonic_time();
+    double late_ms = std::max<gint64>(0, now - probe_expected_) / 1000.0;
+    probe_expected_ = now + PROBE_INTERVAL_MS * 1000;
+
+    if (lateness_ms_.size() < PROBE_SAMPLES) {
+        lateness_ms_.push_back(late_ms);
+    } else {
+        lateness_ms_[lateness_next_] = late_ms;
+        lateness_next_ = (lateness_next_ + 1) % PROBE_SAMPLES;
+    }
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static DiagnosticsReport::Cache cache_entry(const std::string& name, const Stremio::CacheStats& stats) {
+    return {name, stats.memory_hits + stats.disk_hits, stats.misses, stats.hit_rate()};
+}
+
+DiagnosticsReport Diagnostics::collect() const {
+    DiagnosticsReport report;
+    report.generated_at = std::time(nullptr);
+
+    MadariImageStats images = madari_image_get_stats();
+    report.memory.push_back({"textures", static_cast<int64_t>(images.cache_bytes),
+                             std::to_string(images.cache_entries) + " decoded images cached"});
+
+    if (Stremio::AddonService* service = madari_application_get_addon_service(app_)) {
+        Stremio::CatalogCache& catalogs = service->catalog_cache();
+        Stremio::MetaCache& metas = service->meta_cache();
+        Stremio::LocalIndex& index = service->local_index();
+
+        report.memory.push_back({"catalogs", static_cast<int64_t>(catalogs.memory_bytes()),
+                                 std::to_string(catalogs.memory_size()) + " pages in memory"});
+        report.memory.push_back({"metas", static_cast<int64_t>(metas.memory_bytes()),
+                                 std::to_string(metas.memory_size()) + " metas in memory"});
+        report.memory.push_back({"search_index", static_cast<int64_t>(index.memory_bytes()),
+                                 std::to_string(index.size()) + " items indexed"});
+
+        report.caches.push_back(cache_entry("catalogs", catalogs.stats()));
+        report.caches.push_back(cache_entry("metas", metas.stats()));
+
+        report.in_flight.push_back({"addon_requests", static_cast<int64_t>(service->requests_in_flight())});
+    }
+
+    if (WatchHistoryService* history = madari_application_get_watch_history(app_)) {
+        report.memory.push_back({"history", static_cast<int64_t>(history->memory_bytes()),
+                                 std::to_string(history->size()) + " entries"});
+    }
+
+    int64_t demuxer_bytes = -1;
+    for (GList* l = gtk_application_get_windows(GTK_APPLICATION(app_)); l; l = l->next) {
+        if (MADARI_IS_WINDOW(l->data)) {
+            demuxer_bytes = std::max<int64_t>(demuxer_bytes, madari_window_get_demuxer_cache_bytes(MADARI_WINDOW(l->data)));
+        }
+    }
+    report.memory.push_back({"demuxer_cache", demuxer_bytes,
+                             demuxer_bytes < 0 ? "nothing playing" : "mpv demuxer cache"});
+
+    guint64 image_misses = images.downloads;
+    guint64 image_hits = images.cache_hits + images.disk_hits;
+    report.caches.push_back({"images", image_hits, image_misses,
+                             image_hits + image_misses > 0
+                                 ? static_cast<double>(image_hits) / (image_hits + image_misses) : 0.0});
+
+    report.in_flight.push_back({"image_loads", images.active});
+    report.in_flight.push_back({"image_loads_queued", images.queued});
+
+    std::vector<double> sorted = lateness_ms_;
+    std::sort(sorted.begin(), sorted.end());
+    report.loop_samples = sorted.size();
+    report.loop_p50_ms = percentile(sorted, 0.50);
+    report.loop_p95_ms = percentile(sorted, 0.95);
+    report.loop_p99_ms = percentile(sorted, 0.99);
+    report.loop_max_ms = sorted.empty() ? 0 : sorted.back();
+
+    return report;
+}
+
+std::string DiagnosticsReport::to_json() const {
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+
+    json_builder_set_member_name(builder, "generated_at");
+    json_builder_add_int_value(builder, generated_at);
+
+    json_builder_set_member_name(builder, "memory");
+    json_builder_begin_object(builder);
+    for (const auto& entry : memory) {
+        json_builder_set_member_name(builder, entry.subsystem.c_str());
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "bytes");
+        json_builder_add_int_value(builder, entry.bytes);
+        json_builder_set_member_name(builder, "detail");
+        json_builder_add_string_value(builder, entry.detail.c_str());
+        json_builder_end_object(builder);
+    }
+    json_builder_end_object(builder);
+
+    json_builder_set_member_name(builder, "caches");
+    json_builder_begin_object(builder);
+    for (const auto& cache : caches) {
+        json_builder_set_member_name(builder, cache.name.c_str());
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "hits");
+        json_builder_add_int_value(builder, static_cast<gint64>(cache.hits));
+        json_builder_set_member_name(builder, "misses");
+        json_builder_add_int_value(builder, static_cast<gint64>(cache.misses));
+        json_builder_set_member_name(builder, "hit_rate");
+        json_builder_add_double_value(builder, cache.hit_rate);
+        json_builder_end_object(builder);
+    }
+    json_builder_end_object(builder);
+
+    json_builder_set_member_name(builder, "in_flight");
+    json_builder_begin_object(builder);
+    for (const auto& entry : in_flight) {
+        json_builder_set_member_name(builder, entry.name.c_str());
+        json_builder_add_int_value(builder, entry.count);
+    }
+    json_builder_end_object(builder);
+
+    json_builder_set_member_name(builder, "main_loop_latency_ms");
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "p50");
+    json_builder_add_double_value(builder, loop_p50_ms);
+    json_builder_set_member_name(builder, "p95");
+    json_builder_add_double_value(builder, loop_p95_ms);
+    json_builder_set_member_name(builder, "p99");
+    json_builder_add_double_value(builder, loop_p99_ms);
+    json_builder_set_member_name(builder, "max");
+    json_builder_add_double_value(builder, loop_max_ms);
+    json_builder_set_member_name(builder, "samples");
+    json_builder_add_int_value(builder, static_cast<gint64>(loop_samples));
+    json_builder_end_object(builder);
+
+    json_builder_end_object(builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+    json_generator_set_pretty(generator, TRUE);
+
+    g_autofree gchar* json = json_generator_to_data(generator, nullptr);
+    return json;
+}
+
+} // namespace Madari
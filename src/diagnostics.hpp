@@ -0,0 +1,82 @@
+#pragma once
+
+#include <glib.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef struct _MadariApplication MadariApplication;
+
+namespace Madari {
+
+/**
+ * Point-in-time figures for support: what each subsystem holds in memory,
+ * how well the caches do, what is on the wire and how responsive the main
+ * loop has been
+ */
+struct DiagnosticsReport {
+    struct Memory {
+        std::string subsystem;
+        int64_t bytes;          // Approximate, -1 if unknown
+        std::string detail;
+    };
+
+    struct Cache {
+        std::string name;
+        uint64_t hits;
+        uint64_t misses;
+        double hit_rate;
+    };
+
+    struct InFlight {
+        std::string name;
+        int64_t count;
+    };
+
+    int64_t generated_at = 0;   // Unix timestamp
+    std::vector<Memory> memory;
+    std::vector<Cache> caches;
+    std::vector<InFlight> in_flight;
+
+    // How late main loop wakeups ran since the probe started, over the
+    // last minute at most, in ms
+    double loop_p50_ms = 0;
+    double loop_p95_ms = 0;
+    double loop_p99_ms = 0;
+    double loop_max_ms = 0;
+    size_t loop_samples = 0;
+
+    std::string to_json() const;
+};
+
+/**
+ * Collects DiagnosticsReports. Owns a probe that, while started, wakes up
+ * the main loop at a fixed rate and records how late each wakeup ran,
+ * which is what a blocked main loop looks like from the inside.
+ */
+class Diagnostics {
+public:
+    explicit Diagnostics(MadariApplication* app);
+    ~Diagnostics();
+
+    DiagnosticsReport collect() const;
+
+    /**
+     * Start measuring main loop latency, dropping earlier samples. The
+     * probe wakes the loop ten times a second, so it only runs while the
+     * figures are on screen.
+     */
+    void start_probe();
+    void stop_probe();
+
+private:
+    MadariApplication* app_;
+    guint probe_source_;
+    gint64 probe_expected_;
+    std::vector<double> lateness_ms_;   // Ring buffer
+    size_t lateness_next_;
+
+    void on_probe();
+};
+
+} // namespace Madari
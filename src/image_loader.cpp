@@ -0,0 +1,463 @@
+#include "image_loader.hpp"
+#include "profiler.hpp"
+#include "transport.hpp"
+#include <libsoup/soup.h>
+#include <glib/gstdio.h>
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Downloads in flight at once; the rest wait in order of request
+const int MAX_ACTIVE_LOADS = 6;
+
+// Of those, how many may be prefetches, so images on screen always get a slot
+const int MAX_ACTIVE_PREFETCHES = 2;
+
+// Decoded textures kept around, counted as 4 bytes per pixel
+const gsize CACHE_MAX_BYTES = 96 * 1024 * 1024;
+
+// Downloaded files kept on disk; trimmed back to DISK_TRIM_TO_BYTES, oldest
+// first, once per run when over the limit
+const goffset DISK_MAX_BYTES = 256 * 1024 * 1024;
+const goffset DISK_TRIM_TO_BYTES = 192 * 1024 * 1024;
+
+struct ImageRequest {
+    GtkPicture *picture;       // Ref held until the request finishes, null for prefetches
+    std::string url;
+    std::string key;
+    int width;
+    int height;
+    GCancellable *cancellable;
+    bool from_disk = false;
+    gint64 decode_started = -1;    // Profiler time, -1 when not profiling
+};
+
+// What a picture was last asked to show, so it can be emptied and reloaded
+struct ImageSource {
+    std::string url;
+    int width;
+    int height;
+    bool released;
+};
+
+struct CacheEntry {
+    std::string key;
+    GdkTexture *texture;
+    gsize bytes;
+};
+
+struct Pipeline {
+    SoupSession *session = nullptr;
+    std::deque<ImageRequest*> queue;
+    std::deque<ImageRequest*> prefetch_queue;   // Started only when queue is empty
+    std::vector<ImageRequest*> running;
+    int active = 0;
+    int active_prefetches = 0;
+
+    // Most recently used first
+    std::list<CacheEntry> lru;
+    std::unordered_map<std::string, std::list<CacheEntry>::iterator> index;
+    gsize cache_bytes = 0;
+    guint64 cache_hits = 0;
+    guint64 disk_hits = 0;
+    guint64 downloads = 0;
+
+    std::string disk_dir;
+};
+
+const char *REQUEST_KEY = "madari-image-request";
+const char *SOURCE_KEY = "madari-image-source";
+
+void trim_disk_cache(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable);
+
+Pipeline& pipeline() {
+    static Pipeline *instance = nullptr;
+    if (!instance) {
+        instance = new Pipeline();
+        // max-conns and max-conns-per-host are construct-only properties
+        instance->session = SOUP_SESSION(g_object_new(SOUP_TYPE_SESSION,
+                                         "timeout", 30,
+                                         "max-conns", 8,
+                                         "max-conns-per-host", 4,
+                                         nullptr));
+
+        instance->disk_dir = std::string(g_get_user_cache_dir()) + "/madari/images";
+        g_mkdir_with_parents(instance->disk_dir.c_str(), 0755);
+
+        GTask *task = g_task_new(nullptr, nullptr, nullptr, nullptr);
+        g_task_set_task_data(task, g_strdup(instance->disk_dir.c_str()), g_free);
+        g_task_run_in_thread(task, trim_disk_cache);
+        g_object_unref(task);
+    }
+    return *instance;
+}
+
+std::string disk_path(const std::string& url) {
+    g_autofree gchar *hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, url.c_str(), -1);
+    return pipeline().disk_dir + "/" + hash;
+}
+
+// Worker thread: delete the oldest files while the cache is over its limit
+void trim_disk_cache(GTask *task, [[maybe_unused]] gpointer source, gpointer task_data,
+                     [[maybe_unused]] GCancellable *cancellable) {
+    const char *dir = static_cast<const char*>(task_data);
+    g_autoptr(GFile) directory = g_file_new_for_path(dir);
+    g_autoptr(GFileEnumerator) enumerator = g_file_enumerate_children(
+        directory, G_FILE_ATTRIBUTE_STANDARD_NAME "," G_FILE_ATTRIBUTE_STANDARD_SIZE ","
+                   G_FILE_ATTRIBUTE_TIME_MODIFIED,
+        G_FILE_QUERY_INFO_NONE, nullptr, nullptr);
+    if (!enumerator) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    struct DiskFile { guint64 mtime; goffset size; std::string path; };
+    std::vector<DiskFile> files;
+    goffset total = 0;
+
+    GFileInfo *info;
+    while ((info = g_file_enumerator_next_file(enumerator, nullptr, nullptr)) != nullptr) {
+        goffset size = g_file_info_get_size(info);
+        files.push_back({g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED), size,
+                         std::string(dir) + "/" + g_file_info_get_name(info)});
+        total += size;
+        g_object_unref(info);
+    }
+
+    if (total > DISK_MAX_BYTES) {
+        std::sort(files.begin(), files.end(), [](const DiskFile& a, const DiskFile& b) {
+            return a.mtime < b.mtime;
+        });
+        for (const auto& file : files) {
+            if (total <= DISK_TRIM_TO_BYTES) break;
+            if (g_unlink(file.path.c_str()) == 0) total -= file.size;
+        }
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+std::string cache_key(const std::string& url, int width, int height) {
+    return url + "@" + std::to_string(width) + "x" + std::to_string(height);
+}
+
+GdkTexture *cache_lookup(const std::string& key) {
+    Pipeline& p = pipeline();
+    auto it = p.index.find(key);
+    if (it == p.index.end()) return nullptr;
+
+    p.lru.splice(p.lru.begin(), p.lru, it->second);
+    return it->second->texture;
+}
+
+void cache_insert(const std::string& key, GdkTexture *texture) {
+    Pipeline& p = pipeline();
+
+    auto existing = p.index.find(key);
+    if (existing != p.index.end()) {
+        p.cache_bytes -= existing->second->bytes;
+        g_object_unref(existing->second->texture);
+        p.lru.erase(existing->second);
+        p.index.erase(existing);
+    }
+
+    gsize bytes = static_cast<gsize>(gdk_texture_get_width(texture)) *
+                  static_cast<gsize>(gdk_texture_get_height(texture)) * 4;
+    p.lru.push_front({key, GDK_TEXTURE(g_object_ref(texture)), bytes});
+    p.index[key] = p.lru.begin();
+    p.cache_bytes += bytes;
+
+    // Textures still shown keep their own ref, eviction only drops ours
+    while (p.cache_bytes > CACHE_MAX_BYTES && p.lru.size() > 1) {
+        CacheEntry& oldest = p.lru.back();
+        p.cache_bytes -= oldest.bytes;
+        p.index.erase(oldest.key);
+        g_object_unref(oldest.texture);
+        p.lru.pop_back();
+    }
+}
+
+template <typename Visit>
+void for_each_picture(GtkWidget *widget, const Visit& visit) {
+    if (GTK_IS_PICTURE(widget)) {
+        visit(GTK_PICTURE(widget));
+    }
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child; child = gtk_widget_get_next_sibling(child)) {
+        for_each_picture(child, visit);
+    }
+}
+
+void free_request(ImageRequest *req) {
+    g_object_unref(req->cancellable);
+    if (req->picture) {
+        g_object_unref(req->picture);
+    }
+    delete req;
+}
+
+void start_request(ImageRequest *req);
+
+void pump_queue() {
+    Pipeline& p = pipeline();
+    while (p.active < MAX_ACTIVE_LOADS) {
+        ImageRequest *req;
+        if (!p.queue.empty()) {
+            req = p.queue.front();
+            p.queue.pop_front();
+        } else if (!p.prefetch_queue.empty() && p.active_prefetches < MAX_ACTIVE_PREFETCHES) {
+            req = p.prefetch_queue.front();
+            p.prefetch_queue.pop_front();
+            // Cancelled while waiting: the page it was for is gone
+            if (g_cancellable_is_cancelled(req->cancellable)) {
+                free_request(req);
+                continue;
+            }
+            p.active_prefetches++;
+        } else {
+            break;
+        }
+        p.active++;
+        p.running.push_back(req);
+        start_request(req);
+    }
+}
+
+// Show the result if the picture still wants it, then start the next download
+void finish_request(ImageRequest *req, GdkTexture *texture) {
+    if (req->picture && g_object_get_data(G_OBJECT(req->picture), REQUEST_KEY) == req) {
+        if (texture) {
+            gtk_picture_set_paintable(req->picture, GDK_PAINTABLE(texture));
+        }
+        g_object_set_data(G_OBJECT(req->picture), REQUEST_KEY, nullptr);
+    }
+
+    Pipeline& p = pipeline();
+    p.running.erase(std::find(p.running.begin(), p.running.end(), req));
+    if (!req->picture) p.active_prefetches--;
+    p.active--;
+    free_request(req);
+    pump_queue();
+}
+
+void on_image_decoded([[maybe_unused]] GObject *source, GAsyncResult *result, gpointer user_data) {
+    ImageRequest *req = static_cast<ImageRequest*>(user_data);
+    g_autoptr(GError) error = nullptr;
+
+    GdkPixbuf *pixbuf = gdk_pixbuf_new_from_stream_finish(result, &error);
+    if (req->decode_started >= 0) {
+        Madari::Profiler::async("image decode", "images", req->decode_started, req->url);
+    }
+    if (!pixbuf) {
+        if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_debug("Failed to decode image %s: %s", req->url.c_str(),
+                    error ? error->message : "unknown error");
+            // A damaged cache file would fail the same way every time
+            if (req->from_disk) g_unlink(disk_path(req->url).c_str());
+        }
+        finish_request(req, nullptr);
+        return;
+    }
+
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+    GdkTexture *texture = gdk_texture_new_for_pixbuf(pixbuf);
+    G_GNUC_END_IGNORE_DEPRECATIONS
+    g_object_unref(pixbuf);
+
+    cache_insert(req->key, texture);
+    finish_request(req, texture);
+    g_object_unref(texture);
+}
+
+// Decode on a worker thread, scaled while decoding
+void decode_image(ImageRequest *req, GBytes *bytes) {
+    if (Madari::Profiler::enabled()) req->decode_started = Madari::Profiler::now();
+    g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_bytes(bytes);
+    gdk_pixbuf_new_from_stream_at_scale_async(stream, req->width, req->height, TRUE,
+                                              req->cancellable, on_image_decoded, req);
+}
+
+void on_disk_cache_written(GObject *source, GAsyncResult *result, [[maybe_unused]] gpointer user_data) {
+    g_autoptr(GError) error = nullptr;
+    if (!g_file_replace_contents_finish(G_FILE(source), result, nullptr, &error)) {
+        g_debug("Failed to write image cache: %s", error->message);
+    }
+}
+
+void on_image_downloaded(ImageRequest *req, GBytes *bytes, guint status, const GError *error) {
+    if (!bytes || g_bytes_get_size(bytes) == 0 || status < 200 || status >= 300) {
+        if (error && !g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_debug("Failed to load image %s: %s", req->url.c_str(), error->message);
+        }
+        finish_request(req, nullptr);
+        return;
+    }
+
+    // Keep the file, so a texture dropped later reloads without the network
+    g_autoptr(GFile) file = g_file_new_for_path(disk_path(req->url).c_str());
+    g_file_replace_contents_bytes_async(file, bytes, nullptr, FALSE, G_FILE_CREATE_NONE,
+                                        nullptr, on_disk_cache_written, nullptr);
+
+    decode_image(req, bytes);
+}
+
+void fetch_from_network(ImageRequest *req) {
+    SoupMessage *msg = soup_message_new("GET", req->url.c_str());
+    if (!msg) {
+        finish_request(req, nullptr);
+        return;
+    }
+
+    Madari::Transport::send_and_read(pipeline().session, msg, G_PRIORITY_LOW, req->cancellable,
+        [req](GBytes *bytes, guint status, const GError *error) {
+            on_image_downloaded(req, bytes, status, error);
+        });
+    g_object_unref(msg);
+}
+
+void on_disk_cache_read(GObject *source, GAsyncResult *result, gpointer user_data) {
+    ImageRequest *req = static_cast<ImageRequest*>(user_data);
+    g_autoptr(GError) error = nullptr;
+
+    g_autoptr(GBytes) bytes = g_file_load_bytes_finish(G_FILE(source), result, nullptr, &error);
+    if (bytes && g_bytes_get_size(bytes) > 0) {
+        req->from_disk = true;
+        pipeline().disk_hits++;
+        decode_image(req, bytes);
+    } else if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        finish_request(req, nullptr);
+    } else {
+        pipeline().downloads++;
+        fetch_from_network(req);
+    }
+}
+
+// Disk cache first, then the network
+void start_request(ImageRequest *req) {
+    g_autoptr(GFile) file = g_file_new_for_path(disk_path(req->url).c_str());
+    g_file_load_bytes_async(file, req->cancellable, on_disk_cache_read, req);
+}
+
+} // namespace
+
+void madari_image_load(GtkPicture *picture, const std::string& url, int width, int height) {
+    madari_image_cancel(picture);
+    if (url.empty()) return;
+
+    g_object_set_data_full(G_OBJECT(picture), SOURCE_KEY, new ImageSource{url, width, height, false},
+                           [](gpointer data) { delete static_cast<ImageSource*>(data); });
+
+    std::string key = cache_key(url, width, height);
+    if (GdkTexture *texture = cache_lookup(key)) {
+        pipeline().cache_hits++;
+        gtk_picture_set_paintable(picture, GDK_PAINTABLE(texture));
+        return;
+    }
+
+    gtk_picture_set_paintable(picture, nullptr);
+
+    ImageRequest *req = new ImageRequest{
+        GTK_PICTURE(g_object_ref(picture)), url, std::move(key), width, height, g_cancellable_new()
+    };
+    g_object_set_data(G_OBJECT(picture), REQUEST_KEY, req);
+
+    pipeline().queue.push_back(req);
+    pump_queue();
+}
+
+void madari_image_cancel(GtkPicture *picture) {
+    ImageRequest *req = static_cast<ImageRequest*>(g_object_get_data(G_OBJECT(picture), REQUEST_KEY));
+    if (!req) return;
+
+    g_object_set_data(G_OBJECT(picture), REQUEST_KEY, nullptr);
+
+    // Still queued: drop it outright. In flight: it finishes as cancelled.
+    Pipeline& p = pipeline();
+    auto it = std::find(p.queue.begin(), p.queue.end(), req);
+    if (it != p.queue.end()) {
+        p.queue.erase(it);
+        free_request(req);
+    } else {
+        g_cancellable_cancel(req->cancellable);
+    }
+}
+
+void madari_image_prefetch(const std::string& url, int width, int height, GCancellable *cancellable) {
+    if (url.empty()) return;
+
+    std::string key = cache_key(url, width, height);
+    Pipeline& p = pipeline();
+    if (p.index.count(key)) return;
+    for (const auto *requests : {&p.queue, &p.prefetch_queue}) {
+        for (ImageRequest *queued : *requests) {
+            if (queued->key == key) return;
+        }
+    }
+    for (ImageRequest *running : p.running) {
+        if (running->key == key) return;
+    }
+
+    GCancellable *request_cancellable = cancellable ? G_CANCELLABLE(g_object_ref(cancellable)) : g_cancellable_new();
+    p.prefetch_queue.push_back(new ImageRequest{nullptr, url, std::move(key), width, height, request_cancellable});
+    pump_queue();
+}
+
+gsize madari_image_release(GtkWidget *root) {
+    gsize released = 0;
+    for_each_picture(root, [&released](GtkPicture *picture) {
+        ImageSource *source = static_cast<ImageSource*>(g_object_get_data(G_OBJECT(picture), SOURCE_KEY));
+        if (!source || source->released) return;
+
+        GdkPaintable *paintable = gtk_picture_get_paintable(picture);
+        bool pending = g_object_get_data(G_OBJECT(picture), REQUEST_KEY) != nullptr;
+        if (!GDK_IS_TEXTURE(paintable) && !pending) return;
+
+        if (GDK_IS_TEXTURE(paintable)) {
+            released += static_cast<gsize>(gdk_texture_get_width(GDK_TEXTURE(paintable))) *
+                        static_cast<gsize>(gdk_texture_get_height(GDK_TEXTURE(paintable))) * 4;
+        }
+        madari_image_cancel(picture);
+        gtk_picture_set_paintable(picture, nullptr);
+        source->released = true;
+    });
+    return released;
+}
+
+void madari_image_restore(GtkWidget *root) {
+    for_each_picture(root, [](GtkPicture *picture) {
+        ImageSource *source = static_cast<ImageSource*>(g_object_get_data(G_OBJECT(picture), SOURCE_KEY));
+        if (!source || !source->released) return;
+
+        // Copied, as loading replaces the source
+        std::string url = source->url;
+        madari_image_load(picture, url, source->width, source->height);
+    });
+}
+
+gsize madari_image_trim_cache(gsize max_bytes) {
+    Pipeline& p = pipeline();
+    gsize before = p.cache_bytes;
+
+    while (p.cache_bytes > max_bytes && !p.lru.empty()) {
+        CacheEntry& oldest = p.lru.back();
+        p.cache_bytes -= oldest.bytes;
+        p.index.erase(oldest.key);
+        g_object_unref(oldest.texture);
+        p.lru.pop_back();
+    }
+    return before - p.cache_bytes;
+}
+
+gsize madari_image_cache_bytes() {
+    return pipeline().cache_bytes;
+}
+
+MadariImageStats madari_image_get_stats() {
+    Pipeline& p = pipeline();
+    return MadariImageStats{
+        p.cache_bytes, static_cast<guint>(p.lru.size()), p.cache_hits, p.disk_hits, p.downloads,
+        p.active, static_cast<int>(p.queue.size() + p.prefetch_queue.size())
+    };
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <string>
+
+/**
+ * Shared image pipeline for posters, backgrounds and thumbnails.
+ *
+ * Downloads go through one soup session with a cap on concurrent requests,
+ * decoding happens off the main loop, and decoded textures are kept in a
+ * bounded in-memory LRU keyed by URL and target size, so scrolling back to
+ * an image or opening the same title twice does not fetch it again.
+ * Downloaded files are also kept in a disk cache under the user cache dir,
+ * so textures dropped under memory pressure come back without the network.
+ */
+
+/**
+ * Load url scaled to fit width x height into picture. Replaces (and
+ * cancels) any load still pending for the same picture. Cached images are
+ * shown immediately, otherwise the picture is cleared until the image arrives.
+ */
+void madari_image_load(GtkPicture *picture, const std::string& url, int width, int height);
+
+/**
+ * Cancel a pending load for picture, e.g. when a list row is recycled.
+ * Does nothing if no load is pending.
+ */
+void madari_image_cancel(GtkPicture *picture);
+
+/**
+ * Fetch url at width x height into the cache without showing it, so a page
+ * about to open finds it there. Skipped if cached, queued or downloading.
+ * Prefetches wait behind images being shown and are dropped once
+ * cancellable is cancelled.
+ */
+void madari_image_prefetch(const std::string& url, int width, int height,
+                           GCancellable *cancellable = nullptr);
+
+/**
+ * Drop the textures shown by the pictures under root (e.g. a page that is
+ * not visible), remembering what each showed for madari_image_restore.
+ * Only pictures loaded through madari_image_load are touched.
+ * @return Approximate bytes of the textures let go
+ */
+gsize madari_image_release(GtkWidget *root);
+
+/**
+ * Reload the pictures under root that madari_image_release emptied, from
+ * the memory or disk cache where possible
+ */
+void madari_image_restore(GtkWidget *root);
+
+/**
+ * Shrink the decoded texture cache to at most max_bytes. Textures still
+ * shown stay alive through their pictures.
+ * @return Bytes dropped from the cache
+ */
+gsize madari_image_trim_cache(gsize max_bytes);
+
+/**
+ * Bytes of decoded textures in the cache, counted as 4 bytes per pixel
+ */
+gsize madari_image_cache_bytes();
+
+/**
+ * Counters of the image pipeline, for diagnostics
+ */
+struct MadariImageStats {
+    gsize cache_bytes;      // Decoded textures held by the cache
+    guint cache_entries;
+    guint64 cache_hits;     // Loads served from decoded textures
+    guint64 disk_hits;      // Loads decoded from the disk cache
+    guint64 downloads;      // Loads that went to the network
+    int active;             // Loads being fetched or decoded
+    int queued;             // Loads waiting for a slot
+};
+
+MadariImageStats madari_image_get_stats();
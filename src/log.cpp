@@ -0,0 +1,367 @@
+#include "log.hpp"
+#include <glib-unix.h>
+#include <glib/gstdio.h>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+namespace Madari {
+
+// Entries kept; a few minutes of normal use at debug level
+static const size_t RING_SIZE = 2048;
+
+// Text stored per entry, message and fields together; longer is cut short
+static const size_t TEXT_SIZE = 216;
+static const size_t DOMAIN_SIZE = 16;
+
+std::atomic<int> Log::level_{static_cast<int>(LogLevel::Info)};
+
+namespace {
+
+// seq is 2n+1 while entry n is being written and 2n+2 once it is complete,
+// so a reader can tell a finished entry from a torn or overwritten one
+struct Slot {
+    std::atomic<guint64> seq{0};
+    gint64 time;
+    int level;
+    int tid;
+    char domain[DOMAIN_SIZE];
+    char text[TEXT_SIZE];
+};
+
+Slot ring[RING_SIZE];
+std::atomic<guint64> next_entry{0};
+
+gint64 origin = g_get_monotonic_time();
+std::atomic<int> next_tid{1};
+
+// Filled in by init so the crash handler doesn't have to allocate
+char crash_path[4096];
+char header[128];
+
+const char LEVEL_CHARS[] = {'E', 'W', 'I', 'D', 'T'};
+
+// Marks messages this file forwarded to GLib so the writer doesn't record them twice
+const char* const FORWARDED_FIELD = "MADARI_DOMAIN";
+
+int current_tid() {
+    thread_local int tid = next_tid.fetch_add(1);
+    return tid;
+}
+
+void copy_truncated(char* dest, size_t size, const char* src, size_t length) {
+    length = std::min(length, size - 1);
+    memcpy(dest, src, length);
+    dest[length] = '\0';
+}
+
+void record(LogLevel level, const char* domain, const char* text, size_t length) {
+    guint64 n = next_entry.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = ring[n % RING_SIZE];
+
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.time = g_get_monotonic_time() - origin;
+    slot.level = static_cast<int>(level);
+    slot.tid = current_tid();
+    copy_truncated(slot.domain, DOMAIN_SIZE, domain, strlen(domain));
+    copy_truncated(slot.text, TEXT_SIZE, text, length);
+
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+}
+
+// ============ Async-signal-safe output ============
+// Used by the crash handler, so no allocation, stdio or locks below
+
+void write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+}
+
+void write_str(int fd, const char* str) {
+    write_all(fd, str, strlen(str));
+}
+
+// Padded on the left to at least width characters
+char* format_uint(char* out, guint64 value, int width, char pad) {
+    char digits[24];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count < width) digits[count++] = pad;
+    while (count > 0) *out++ = digits[--count];
+    return out;
+}
+
+void write_entry(int fd, const Slot& entry) {
+    // "   12.345678 W  1 domain: text"
+    char line[64 + DOMAIN_SIZE];
+    char* out = line;
+    guint64 time = static_cast<guint64>(std::max<gint64>(0, entry.time));
+    out = format_uint(out, time / G_USEC_PER_SEC, 5, ' ');
+    *out++ = '.';
+    out = format_uint(out, time % G_USEC_PER_SEC, 6, '0');
+    *out++ = ' ';
+    *out++ = entry.level >= 0 && entry.level <= 4 ? LEVEL_CHARS[entry.level] : '?';
+    *out++ = ' ';
+    out = format_uint(out, static_cast<guint64>(entry.tid), 2, ' ');
+    *out++ = ' ';
+    size_t domain_length = strnlen(entry.domain, DOMAIN_SIZE - 1);
+    memcpy(out, entry.domain, domain_length);
+    out += domain_length;
+    *out++ = ':';
+    *out++ = ' ';
+
+    write_all(fd, line, static_cast<size_t>(out - line));
+    write_all(fd, entry.text, strnlen(entry.text, TEXT_SIZE - 1));
+    write_all(fd, "\n", 1);
+}
+
+void write_ring(int fd) {
+    write_str(fd, header);
+
+    guint64 end = next_entry.load(std::memory_order_acquire);
+    guint64 begin = end > RING_SIZE ? end - RING_SIZE : 0;
+    for (guint64 n = begin; n < end; n++) {
+        const Slot& slot = ring[n % RING_SIZE];
+        guint64 seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2 * n + 2) continue;
+
+        Slot entry;
+        entry.time = slot.time;
+        entry.level = slot.level;
+        entry.tid = slot.tid;
+        memcpy(entry.domain, slot.domain, DOMAIN_SIZE);
+        memcpy(entry.text, slot.text, TEXT_SIZE);
+
+        // Overwritten while copying
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+
+        write_entry(fd, entry);
+    }
+}
+
+void on_crash(int sig) {
+    int fd = open(crash_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd >= 0) {
+        char line[32] = "signal ";
+        char* out = format_uint(line + strlen(line), static_cast<guint64>(sig), 1, '0');
+        *out++ = '\n';
+        write_all(fd, line, static_cast<size_t>(out - line));
+        write_ring(fd);
+        close(fd);
+
+        write_str(STDERR_FILENO, "madari: crashed, recent log written to ");
+        write_str(STDERR_FILENO, crash_path);
+        write_str(STDERR_FILENO, "\n");
+    }
+
+    // The handler was reset on entry; the default action runs on return
+    raise(sig);
+}
+
+// ============ GLib integration ============
+
+GLogLevelFlags glib_level(LogLevel level) {
+    switch (level) {
+    // Not CRITICAL: G_DEBUG=fatal-criticals would abort on our own errors
+    case LogLevel::Error: return G_LOG_LEVEL_WARNING;
+    case LogLevel::Warning: return G_LOG_LEVEL_WARNING;
+    case LogLevel::Info: return G_LOG_LEVEL_INFO;
+    case LogLevel::Debug:
+    case LogLevel::Trace: return G_LOG_LEVEL_DEBUG;
+    }
+    return G_LOG_LEVEL_DEBUG;
+}
+
+LogLevel from_glib_level(GLogLevelFlags flags) {
+    if (flags & (G_LOG_LEVEL_ERROR | G_LOG_LEVEL_CRITICAL)) return LogLevel::Error;
+    if (flags & G_LOG_LEVEL_WARNING) return LogLevel::Warning;
+    if (flags & (G_LOG_LEVEL_MESSAGE | G_LOG_LEVEL_INFO)) return LogLevel::Info;
+    return LogLevel::Debug;
+}
+
+// Plain g_warning/g_debug calls (ours, GTK's, libsoup's) land in the ring too
+GLogWriterOutput glib_writer(GLogLevelFlags flags, const GLogField* fields, gsize n_fields,
+                             gpointer user_data) {
+    LogLevel level = from_glib_level(flags);
+    if (Log::enabled(level)) {
+        const char* domain = "madari";
+        const char* message = nullptr;
+        gssize message_length = -1;
+        bool forwarded = false;
+        for (gsize i = 0; i < n_fields; i++) {
+            if (strcmp(fields[i].key, FORWARDED_FIELD) == 0) {
+                forwarded = true;
+                break;
+            }
+            if (strcmp(fields[i].key, "GLIB_DOMAIN") == 0 && fields[i].value) {
+                domain = static_cast<const char*>(fields[i].value);
+            } else if (strcmp(fields[i].key, "MESSAGE") == 0 && fields[i].value) {
+                message = static_cast<const char*>(fields[i].value);
+                message_length = fields[i].length;
+            }
+        }
+        if (!forwarded && message) {
+            record(level, domain, message, message_length < 0 ? strlen(message) : static_cast<size_t>(message_length));
+        }
+    }
+    return g_log_writer_default(flags, fields, n_fields, user_data);
+}
+
+gboolean on_dump_signal(gpointer) {
+    g_autoptr(GDateTime) now = g_date_time_new_now_local();
+    g_autofree gchar* name = g_date_time_format(now, "log-%Y%m%d-%H%M%S.log");
+    std::string path = Log::dump_dir() + "/" + name;
+    if (Log::dump(path)) {
+        g_message("Log written to %s", path.c_str());
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+bool parse_level(const char* name, LogLevel* level) {
+    static const struct { const char* name; LogLevel level; } LEVELS[] = {
+        {"error", LogLevel::Error},
+        {"warning", LogLevel::Warning},
+        {"info", LogLevel::Info},
+        {"debug", LogLevel::Debug},
+        {"trace", LogLevel::Trace},
+    };
+    for (const auto& entry : LEVELS) {
+        if (g_ascii_strcasecmp(name, entry.name) == 0) {
+            *level = entry.level;
+            return true;
+        }
+    }
+    return false;
+}
+
+void append_value(std::string& text, const std::string& value) {
+    bool quote = value.empty() || value.find_first_of(" \t\n\"=") != std::string::npos;
+    if (!quote) {
+        text += value;
+        return;
+    }
+    text += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') text += '\\';
+        text += c == '\n' ? ' ' : c;
+    }
+    text += '"';
+}
+
+std::vector<Log::LevelCallback>& level_callbacks() {
+    static std::vector<Log::LevelCallback> callbacks;
+    return callbacks;
+}
+
+} // namespace
+
+LogField::LogField(const char* key, double value) : key(key) {
+    char buffer[G_ASCII_DTOSTR_BUF_SIZE];
+    this->value = g_ascii_formatd(buffer, sizeof(buffer), "%.3f", value);
+}
+
+LogField::LogField(const char* key, const void* value) : key(key) {
+    char buffer[24];
+    g_snprintf(buffer, sizeof(buffer), "%p", value);
+    this->value = buffer;
+}
+
+void Log::init() {
+    const char* env = g_getenv("MADARI_LOG");
+    LogLevel level;
+    if (env && *env) {
+        if (parse_level(env, &level)) {
+            set_level(level);
+        } else {
+            g_warning("Unknown MADARI_LOG level '%s'", env);
+        }
+    }
+    current_tid();
+
+    g_autoptr(GDateTime) now = g_date_time_new_now_local();
+    g_autofree gchar* started = g_date_time_format_iso8601(now);
+    g_snprintf(header, sizeof(header), "madari log, pid %d, started %s\n", static_cast<int>(getpid()), started);
+
+    std::string dir = dump_dir();
+    g_mkdir_with_parents(dir.c_str(), 0755);
+    g_autofree gchar* name = g_date_time_format(now, "crash-%Y%m%d-%H%M%S.log");
+    g_snprintf(crash_path, sizeof(crash_path), "%s/%s", dir.c_str(), name);
+
+    struct sigaction action = {};
+    action.sa_handler = on_crash;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    for (int sig : {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT}) {
+        sigaction(sig, &action, nullptr);
+    }
+
+    g_unix_signal_add(SIGUSR1, on_dump_signal, nullptr);
+    g_log_set_writer_func(glib_writer, nullptr, nullptr);
+}
+
+void Log::set_level(LogLevel level) {
+    int previous = level_.exchange(static_cast<int>(level), std::memory_order_relaxed);
+    if (previous == static_cast<int>(level)) return;
+
+    for (const auto& callback : level_callbacks()) {
+        callback(level);
+    }
+}
+
+void Log::on_level_changed(LevelCallback callback) {
+    level_callbacks().push_back(std::move(callback));
+}
+
+void Log::write(LogLevel level, const char* domain, const char* message,
+                std::initializer_list<LogField> fields) {
+    std::string text = message;
+    for (const auto& field : fields) {
+        text += ' ';
+        text += field.key;
+        text += '=';
+        append_value(text, field.value);
+    }
+    record(level, domain, text.data(), text.size());
+
+    std::string line = std::string(domain) + ": " + text;
+    const GLogField glib_fields[] = {
+        {"GLIB_DOMAIN", "madari", -1},
+        {"MESSAGE", line.c_str(), -1},
+        {FORWARDED_FIELD, domain, -1},
+    };
+    g_log_structured_array(glib_level(level), glib_fields, G_N_ELEMENTS(glib_fields));
+}
+
+bool Log::dump(const std::string& path) {
+    int fd = g_open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        g_warning("Failed to write log to %s: %s", path.c_str(), g_strerror(errno));
+        return false;
+    }
+    write_ring(fd);
+    g_close(fd, nullptr);
+    return true;
+}
+
+std::string Log::dump_dir() {
+    return std::string(g_get_user_cache_dir()) + "/madari/logs";
+}
+
+} // namespace Madari
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <glib.h>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <string>
+
+/**
+ * Most verbose level compiled in; messages above it cost nothing at all.
+ * Set by the build (release builds drop Trace).
+ */
+#ifndef MADARI_LOG_MAX_LEVEL
+#define MADARI_LOG_MAX_LEVEL 4
+#endif
+
+namespace Madari {
+
+enum class LogLevel {
+    Error = 0,
+    Warning = 1,
+    Info = 2,
+    Debug = 3,
+    Trace = 4,
+};
+
+/**
+ * A key=value pair attached to a message. Values are only formatted
+ * when the message's level is enabled.
+ */
+struct LogField {
+    LogField(const char* key, const std::string& value) : key(key), value(value) {}
+    LogField(const char* key, const char* value) : key(key), value(value ? value : "(null)") {}
+    LogField(const char* key, bool value) : key(key), value(value ? "true" : "false") {}
+    LogField(const char* key, int value) : key(key), value(std::to_string(value)) {}
+    LogField(const char* key, long value) : key(key), value(std::to_string(value)) {}
+    LogField(const char* key, long long value) : key(key), value(std::to_string(value)) {}
+    LogField(const char* key, unsigned value) : key(key), value(std::to_string(value)) {}
+    LogField(const char* key, unsigned long value) : key(key), value(std::to_string(value)) {}
+    LogField(const char* key, unsigned long long value) : key(key), value(std::to_string(value)) {}
+    LogField(const char* key, double value);
+    LogField(const char* key, const void* value);
+
+    const char* key;
+    std::string value;
+};
+
+/**
+ * Leveled, structured logging. Every enabled message goes into an
+ * in-memory ring of the most recent entries and on to GLib's log writer
+ * (which prints warnings, and info/debug when G_MESSAGES_DEBUG asks).
+ * The ring is written to ~/.cache/madari/logs/ when the app crashes, on
+ * SIGUSR1, or from the Diagnostics page.
+ *
+ * The run-time level comes from MADARI_LOG (error, warning, info, debug,
+ * trace) and defaults to info. Writing never takes a lock.
+ */
+class Log {
+public:
+    using LevelCallback = std::function<void(LogLevel level)>;
+
+    /**
+     * Read MADARI_LOG and install the crash and SIGUSR1 handlers. Call
+     * first thing in main.
+     */
+    static void init();
+
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) <= level_.load(std::memory_order_relaxed);
+    }
+
+    static LogLevel level() { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+    static void set_level(LogLevel level);
+
+    /**
+     * Register for run-time level changes, for sources such as mpv that
+     * filter their messages before they reach us. Main thread only, as is
+     * set_level once callbacks are registered.
+     */
+    static void on_level_changed(LevelCallback callback);
+
+    /**
+     * Record a message; use the MADARI_LOG_* macros so disabled levels
+     * skip building the fields
+     */
+    static void write(LogLevel level, const char* domain, const char* message,
+                      std::initializer_list<LogField> fields = {});
+
+    /**
+     * Write the ring, oldest entry first, to path
+     */
+    static bool dump(const std::string& path);
+
+    /**
+     * Where crash and SIGUSR1 dumps go
+     */
+    static std::string dump_dir();
+
+private:
+    static std::atomic<int> level_;
+};
+
+} // namespace Madari
+
+#define MADARI_LOG(level, domain, message, ...)                                         \
+    do {                                                                                \
+        if (static_cast<int>(level) <= MADARI_LOG_MAX_LEVEL && Madari::Log::enabled(level)) \
+            Madari::Log::write(level, domain, message, {__VA_ARGS__});                  \
+    } while (0)
+
+#define MADARI_LOG_ERROR(domain, message, ...) MADARI_LOG(Madari::LogLevel::Error, domain, message, __VA_ARGS__)
+#define MADARI_LOG_WARNING(domain, message, ...) MADARI_LOG(Madari::LogLevel::Warning, domain, message, __VA_ARGS__)
+#define MADARI_LOG_INFO(domain, message, ...) MADARI_LOG(Madari::LogLevel::Info, domain, message, __VA_ARGS__)
+#define MADARI_LOG_DEBUG(domain, message, ...) MADARI_LOG(Madari::LogLevel::Debug, domain, message, __VA_ARGS__)
+#define MADARI_LOG_TRACE(domain, message, ...) MADARI_LOG(Madari::LogLevel::Trace, domain, message, __VA_ARGS__)
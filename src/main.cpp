@@ -1,6 +1,14 @@
 #include "application.hpp"
+#include "log.hpp"
+#include "profiler.hpp"
+#include "transport.hpp"
 
 int main(int argc, char *argv[]) {
+    // Before anything else, so the log and trace cover all of startup
+    Madari::Log::init();
+    Madari::Profiler::init(argc, argv);
+    Madari::Transport::init();
+    
     g_autoptr(MadariApplication) app = madari_application_new();
     return g_application_run(G_APPLICATION(app), argc, argv);
 }
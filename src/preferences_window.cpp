@@ -1,4 +1,6 @@
 #include "preferences_window.hpp"
+#include "profiler.hpp"
+#include "log.hpp"
 
 struct _MadariPreferencesWindow {
     AdwWindow parent_instance;
@@ -6,6 +8,7 @@ struct _MadariPreferencesWindow {
     // Services
     Stremio::AddonService *addon_service;
     Trakt::TraktService *trakt_service;
+    Madari::Diagnostics *diagnostics;
     
     // UI elements - Addons page
     AdwPreferencesPage *addons_page;
@@ -44,6 +47,14 @@ struct _MadariPreferencesWindow {
     GtkLabel *trakt_auth_status_label;
     guint trakt_poll_timeout_id;
     std::string *trakt_device_code;
+    
+    // Diagnostics UI elements (created programmatically)
+    AdwPreferencesPage *diagnostics_page;
+    AdwPreferencesGroup *diagnostics_memory_group;
+    AdwPreferencesGroup *diagnostics_cache_group;
+    AdwPreferencesGroup *diagnostics_requests_group;
+    AdwPreferencesGroup *diagnostics_loop_group;
+    guint diagnostics_refresh_id;
 };
 
 G_DEFINE_TYPE(MadariPreferencesWindow, madari_preferences_window, ADW_TYPE_WINDOW)
@@ -521,6 +532,188 @@ static void create_trakt_page(MadariPreferencesWindow *self) {
 
 // ============ End Trakt UI Functions ============
 
+// ============ Diagnostics UI Functions ============
+
+/**
+ * Rows are created the first time a figure shows up and kept on the group
+ * under their name, so refreshing only touches labels
+ */
+static void set_diagnostics_row(AdwPreferencesGroup *group, const std::string& name,
+                                const std::string& subtitle, const std::string& value) {
+    auto *row = ADW_ACTION_ROW(g_object_get_data(G_OBJECT(group), name.c_str()));
+    if (!row) {
+        row = ADW_ACTION_ROW(adw_action_row_new());
+        adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), name.c_str());
+        
+        GtkWidget *label = gtk_label_new(nullptr);
+        gtk_widget_add_css_class(label, "dim-label");
+        gtk_widget_add_css_class(label, "numeric");
+        adw_action_row_add_suffix(row, label);
+        g_object_set_data(G_OBJECT(row), "value-label", label);
+        
+        adw_preferences_group_add(group, GTK_WIDGET(row));
+        g_object_set_data(G_OBJECT(group), name.c_str(), row);
+    }
+    
+    adw_action_row_set_subtitle(row, subtitle.c_str());
+    gtk_label_set_text(GTK_LABEL(g_object_get_data(G_OBJECT(row), "value-label")), value.c_str());
+}
+
+static void refresh_diagnostics(MadariPreferencesWindow *self) {
+    if (!self->diagnostics) return;
+    
+    Madari::DiagnosticsReport report = self->diagnostics->collect();
+    
+    for (const auto& entry : report.memory) {
+        std::string value = "Unknown";
+        if (entry.bytes >= 0) {
+            g_autofree gchar *size = g_format_size(entry.bytes);
+            value = size;
+        }
+        set_diagnostics_row(self->diagnostics_memory_group, entry.subsystem, entry.detail, value);
+    }
+    
+    for (const auto& cache : report.caches) {
+        g_autofree gchar *subtitle = g_strdup_printf("%" G_GUINT64_FORMAT " hits, %" G_GUINT64_FORMAT " misses",
+                                                     static_cast<guint64>(cache.hits),
+                                                     static_cast<guint64>(cache.misses));
+        g_autofree gchar *value = g_strdup_printf("%.0f%%", cache.hit_rate * 100);
+        set_diagnostics_row(self->diagnostics_cache_group, cache.name, subtitle, value);
+    }
+    
+    for (const auto& entry : report.in_flight) {
+        set_diagnostics_row(self->diagnostics_requests_group, entry.name, "", std::to_string(entry.count));
+    }
+    
+    std::string samples = std::to_string(report.loop_samples) + " samples";
+    const std::pair<const char*, double> latencies[] = {
+        {"p50", report.loop_p50_ms},
+        {"p95", report.loop_p95_ms},
+        {"p99", report.loop_p99_ms},
+        {"max", report.loop_max_ms},
+    };
+    for (const auto& [name, ms] : latencies) {
+        g_autofree gchar *value = g_strdup_printf("%.1f ms", ms);
+        set_diagnostics_row(self->diagnostics_loop_group, name, samples, value);
+    }
+}
+
+// Figures only refresh while the page is on screen
+static void on_diagnostics_page_map([[maybe_unused]] GtkWidget *page, MadariPreferencesWindow *self) {
+    if (self->diagnostics) self->diagnostics->start_probe();
+    refresh_diagnostics(self);
+    if (self->diagnostics_refresh_id) return;
+    self->diagnostics_refresh_id = g_timeout_add_seconds(1, [](gpointer data) -> gboolean {
+        refresh_diagnostics(MADARI_PREFERENCES_WINDOW(data));
+        return G_SOURCE_CONTINUE;
+    }, self);
+}
+
+static void on_diagnostics_page_unmap([[maybe_unused]] GtkWidget *page, MadariPreferencesWindow *self) {
+    if (self->diagnostics) self->diagnostics->stop_probe();
+    g_clear_handle_id(&self->diagnostics_refresh_id, g_source_remove);
+}
+
+static void on_diagnostics_export_saved(GObject *source, GAsyncResult *result, gpointer user_data) {
+    MadariPreferencesWindow *self = MADARI_PREFERENCES_WINDOW(user_data);
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(GFile) file = gtk_file_dialog_save_finish(GTK_FILE_DIALOG(source), result, &error);
+    
+    if (file && self->diagnostics) {
+        std::string json = self->diagnostics->collect().to_json();
+        if (!g_file_replace_contents(file, json.data(), json.size(), nullptr, FALSE,
+                                     G_FILE_CREATE_REPLACE_DESTINATION, nullptr, nullptr, &error)) {
+            g_warning("Failed to export diagnostics: %s", error->message);
+        }
+    }
+    
+    g_object_unref(self);
+}
+
+static void on_diagnostics_export_clicked([[maybe_unused]] GtkButton *btn, MadariPreferencesWindow *self) {
+    g_autoptr(GtkFileDialog) dialog = gtk_file_dialog_new();
+    gtk_file_dialog_set_title(dialog, "Export Diagnostics");
+    
+    g_autoptr(GDateTime) now = g_date_time_new_now_local();
+    g_autofree gchar *name = g_date_time_format(now, "madari-diagnostics-%Y%m%d-%H%M%S.json");
+    gtk_file_dialog_set_initial_name(dialog, name);
+    
+    gtk_file_dialog_save(dialog, GTK_WINDOW(self), nullptr,
+                         on_diagnostics_export_saved, g_object_ref(self));
+}
+
+static void on_diagnostics_log_saved(GObject *source, GAsyncResult *result, [[maybe_unused]] gpointer user_data) {
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(GFile) file = gtk_file_dialog_save_finish(GTK_FILE_DIALOG(source), result, &error);
+    
+    if (file) {
+        g_autofree gchar *path = g_file_get_path(file);
+        if (path) Madari::Log::dump(path);
+    }
+}
+
+static void on_diagnostics_log_clicked([[maybe_unused]] GtkButton *btn, MadariPreferencesWindow *self) {
+    g_autoptr(GtkFileDialog) dialog = gtk_file_dialog_new();
+    gtk_file_dialog_set_title(dialog, "Save Log");
+    
+    g_autoptr(GDateTime) now = g_date_time_new_now_local();
+    g_autofree gchar *name = g_date_time_format(now, "madari-%Y%m%d-%H%M%S.log");
+    gtk_file_dialog_set_initial_name(dialog, name);
+    
+    gtk_file_dialog_save(dialog, GTK_WINDOW(self), nullptr, on_diagnostics_log_saved, nullptr);
+}
+
+static AdwPreferencesGroup* create_diagnostics_group(AdwPreferencesPage *page, const char *title,
+                                                     const char *description) {
+    AdwPreferencesGroup *group = ADW_PREFERENCES_GROUP(adw_preferences_group_new());
+    adw_preferences_group_set_title(group, title);
+    adw_preferences_group_set_description(group, description);
+    adw_preferences_page_add(page, group);
+    return group;
+}
+
+static void create_diagnostics_page(MadariPreferencesWindow *self) {
+    self->diagnostics_page = ADW_PREFERENCES_PAGE(adw_preferences_page_new());
+    adw_preferences_page_set_title(self->diagnostics_page, "Diagnostics");
+    adw_preferences_page_set_icon_name(self->diagnostics_page, "utilities-system-monitor-symbolic");
+    
+    self->diagnostics_memory_group = create_diagnostics_group(self->diagnostics_page, "Memory",
+        "Approximate memory held by each part of the app");
+    
+    // Export button
+    GtkWidget *export_btn = gtk_button_new_with_label("Export JSON…");
+    gtk_widget_add_css_class(export_btn, "flat");
+    gtk_widget_set_valign(export_btn, GTK_ALIGN_CENTER);
+    g_signal_connect(export_btn, "clicked", G_CALLBACK(on_diagnostics_export_clicked), self);
+    adw_preferences_group_set_header_suffix(self->diagnostics_memory_group, export_btn);
+    
+    self->diagnostics_cache_group = create_diagnostics_group(self->diagnostics_page, "Caches",
+        "Lookups answered from memory or disk since startup");
+    self->diagnostics_requests_group = create_diagnostics_group(self->diagnostics_page, "In Flight",
+        "Requests and image loads not finished yet");
+    self->diagnostics_loop_group = create_diagnostics_group(self->diagnostics_page, "Main Loop Latency",
+        "How late the interface ran scheduled work while this page was open");
+    
+    // Recent log, for bug reports
+    AdwPreferencesGroup *log_group = create_diagnostics_group(self->diagnostics_page, "Log",
+        "Recent messages are kept in memory and saved automatically if the app crashes");
+    AdwActionRow *log_row = ADW_ACTION_ROW(adw_action_row_new());
+    adw_preferences_row_set_title(ADW_PREFERENCES_ROW(log_row), "Recent Messages");
+    g_autofree gchar *log_subtitle = g_strdup_printf("Set MADARI_LOG=debug for more detail; crash logs go to %s",
+                                                     Madari::Log::dump_dir().c_str());
+    adw_action_row_set_subtitle(log_row, log_subtitle);
+    GtkWidget *log_btn = gtk_button_new_with_label("Save…");
+    gtk_widget_set_valign(log_btn, GTK_ALIGN_CENTER);
+    g_signal_connect(log_btn, "clicked", G_CALLBACK(on_diagnostics_log_clicked), self);
+    adw_action_row_add_suffix(log_row, log_btn);
+    adw_preferences_group_add(log_group, GTK_WIDGET(log_row));
+    
+    g_signal_connect(self->diagnostics_page, "map", G_CALLBACK(on_diagnostics_page_map), self);
+    g_signal_connect(self->diagnostics_page, "unmap", G_CALLBACK(on_diagnostics_page_unmap), self);
+}
+
+// ============ End Diagnostics UI Functions ============
+
 static void madari_preferences_window_class_init(MadariPreferencesWindowClass *klass) {
     GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
     
@@ -539,13 +732,19 @@ static void madari_preferences_window_class_init(MadariPreferencesWindowClass *k
 }
 
 static void madari_preferences_window_init(MadariPreferencesWindow *self) {
-    gtk_widget_init_template(GTK_WIDGET(self));
+    {
+        Madari::ProfileSpan span("preferences template init", "ui");
+        gtk_widget_init_template(GTK_WIDGET(self));
+    }
     
     // Initialize Trakt-related pointers
     self->trakt_service = nullptr;
     self->trakt_poll_timeout_id = 0;
     self->trakt_device_code = nullptr;
     
+    self->diagnostics = nullptr;
+    self->diagnostics_refresh_id = 0;
+    
     // Connect add button signal
     g_signal_connect(self->add_addon_button, "clicked",
                      G_CALLBACK(on_add_addon_clicked), self);
@@ -553,7 +752,8 @@ static void madari_preferences_window_init(MadariPreferencesWindow *self) {
 
 MadariPreferencesWindow *madari_preferences_window_new(GtkWindow *parent, 
                                                         Stremio::AddonService *addon_service,
-                                                        Trakt::TraktService *trakt_service) {
+                                                        Trakt::TraktService *trakt_service,
+                                                        Madari::Diagnostics *diagnostics) {
     MadariPreferencesWindow *window = MADARI_PREFERENCES_WINDOW(g_object_new(
         MADARI_TYPE_PREFERENCES_WINDOW,
         "transient-for", parent,
@@ -562,14 +762,25 @@ MadariPreferencesWindow *madari_preferences_window_new(GtkWindow *parent,
     
     window->addon_service = addon_service;
     window->trakt_service = trakt_service;
+    window->diagnostics = diagnostics;
     
     // Subscribe to addon changes
     addon_service->on_addons_changed([window]() {
         refresh_addons_list(window);
     });
     
-    // Initial refresh
+    // Initial refresh, and again once installed addons are read in
     refresh_addons_list(window);
+    if (!addon_service->is_ready()) {
+        g_object_ref(window);
+        addon_service->when_ready([window]() {
+            // Template children are cleared once the window is disposed
+            if (window->addons_list) {
+                refresh_addons_list(window);
+            }
+            g_object_unref(window);
+        });
+    }
     
     // Create and add Trakt page to the view stack
     create_trakt_page(window);
@@ -592,5 +803,14 @@ MadariPreferencesWindow *madari_preferences_window_new(GtkWindow *parent,
         update_trakt_account_ui(window);
     }
     
+    // Create and add Diagnostics page to the view stack
+    if (diagnostics && window->view_stack) {
+        create_diagnostics_page(window);
+        adw_view_stack_add_titled_with_icon(window->view_stack,
+                                             GTK_WIDGET(window->diagnostics_page),
+                                             "diagnostics", "Diagnostics",
+                                             "utilities-system-monitor-symbolic");
+    }
+    
     return window;
 }
@@ -3,6 +3,7 @@
 #include <adwaita.h>
 #include "stremio/stremio.hpp"
 #include "trakt/trakt.hpp"
+#include "diagnostics.hpp"
 
 G_BEGIN_DECLS
 
@@ -12,6 +13,7 @@ G_DECLARE_FINAL_TYPE(MadariPreferencesWindow, madari_preferences_window, MADARI,
 
 MadariPreferencesWindow *madari_preferences_window_new(GtkWindow *parent, 
                                                         Stremio::AddonService *addon_service,
-                                                        Trakt::TraktService *trakt_service);
+                                                        Trakt::TraktService *trakt_service,
+                                                        Madari::Diagnostics *diagnostics);
 
 G_END_DECLS
@@ -0,0 +1,231 @@
+#include "profiler.hpp"
+#include <json-glib/json-glib.h>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace Madari {
+
+// Events kept at most; a trace this long is already hard to read
+static const size_t MAX_EVENTS = 1000000;
+
+std::atomic<bool> Profiler::enabled_{false};
+
+namespace {
+
+struct Event {
+    char phase;             // 'X' complete, 'a' async, 'i' instant
+    const char* name;       // String literal
+    const char* category;   // String literal
+    gint64 start;
+    gint64 duration;
+    int tid;
+    std::string detail;
+};
+
+struct Recording {
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string path;
+    gint64 origin = 0;          // Monotonic time recording started at
+    size_t dropped = 0;
+};
+
+Recording& recording() {
+    static Recording instance;
+    return instance;
+}
+
+std::atomic<int> next_tid{1};
+
+// Small stable ids read better in the viewer than system thread ids;
+// the thread that starts recording is 1
+int current_tid() {
+    thread_local int tid = next_tid.fetch_add(1);
+    return tid;
+}
+
+void record(Event event) {
+    Recording& rec = recording();
+    std::lock_guard<std::mutex> lock(rec.mutex);
+    if (rec.events.size() >= MAX_EVENTS) {
+        rec.dropped++;
+        return;
+    }
+    rec.events.push_back(std::move(event));
+}
+
+void add_common(JsonBuilder* builder, const Event& event, const char* phase, gint64 ts) {
+    json_builder_set_member_name(builder, "name");
+    json_builder_add_string_value(builder, event.name);
+    json_builder_set_member_name(builder, "cat");
+    json_builder_add_string_value(builder, event.category);
+    json_builder_set_member_name(builder, "ph");
+    json_builder_add_string_value(builder, phase);
+    json_builder_set_member_name(builder, "ts");
+    json_builder_add_int_value(builder, ts);
+    json_builder_set_member_name(builder, "pid");
+    json_builder_add_int_value(builder, 1);
+    json_builder_set_member_name(builder, "tid");
+    json_builder_add_int_value(builder, event.tid);
+    if (!event.detail.empty()) {
+        json_builder_set_member_name(builder, "args");
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "detail");
+        json_builder_add_string_value(builder, event.detail.c_str());
+        json_builder_end_object(builder);
+    }
+}
+
+void add_thread_name(JsonBuilder* builder, int tid, const char* name) {
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "name");
+    json_builder_add_string_value(builder, "thread_name");
+    json_builder_set_member_name(builder, "ph");
+    json_builder_add_string_value(builder, "M");
+    json_builder_set_member_name(builder, "pid");
+    json_builder_add_int_value(builder, 1);
+    json_builder_set_member_name(builder, "tid");
+    json_builder_add_int_value(builder, tid);
+    json_builder_set_member_name(builder, "args");
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "name");
+    json_builder_add_string_value(builder, name);
+    json_builder_end_object(builder);
+    json_builder_end_object(builder);
+}
+
+} // namespace
+
+void Profiler::init(int argc, char* argv[]) {
+    const char* env = g_getenv("MADARI_PROFILE");
+    bool requested = env && *env && strcmp(env, "0") != 0;
+    for (int i = 1; i < argc && !requested; i++) {
+        requested = strcmp(argv[i], "--profile") == 0;
+    }
+    if (!requested) return;
+
+    // MADARI_PROFILE may name the file; otherwise one per run in the cache dir
+    std::string path;
+    if (env && strcmp(env, "1") != 0 && strcmp(env, "0") != 0) {
+        path = env;
+    } else {
+        std::string dir = std::string(g_get_user_cache_dir()) + "/madari/profiles";
+        g_mkdir_with_parents(dir.c_str(), 0755);
+        g_autoptr(GDateTime) now = g_date_time_new_now_local();
+        g_autofree gchar* name = g_date_time_format(now, "trace-%Y%m%d-%H%M%S.json");
+        path = dir + "/" + name;
+    }
+    start(path);
+}
+
+void Profiler::start(const std::string& path) {
+    Recording& rec = recording();
+    {
+        std::lock_guard<std::mutex> lock(rec.mutex);
+        rec.events.clear();
+        rec.dropped = 0;
+        rec.path = path;
+        rec.origin = g_get_monotonic_time();
+    }
+    current_tid();
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+gint64 Profiler::now() {
+    return g_get_monotonic_time() - recording().origin;
+}
+
+void Profiler::complete(const char* name, const char* category, gint64 start, const std::string& detail) {
+    if (!enabled()) return;
+    record({'X', name, category, start, now() - start, current_tid(), detail});
+}
+
+void Profiler::async(const char* name, const char* category, gint64 start, const std::string& detail) {
+    if (!enabled()) return;
+    record({'a', name, category, start, now() - start, current_tid(), detail});
+}
+
+void Profiler::instant(const char* name, const char* category) {
+    if (!enabled()) return;
+    record({'i', name, category, now(), 0, current_tid(), {}});
+}
+
+void Profiler::stop() {
+    if (!enabled()) return;
+    enabled_.store(false, std::memory_order_relaxed);
+
+    Recording& rec = recording();
+    std::vector<Event> events;
+    size_t dropped;
+    {
+        std::lock_guard<std::mutex> lock(rec.mutex);
+        events = std::move(rec.events);
+        rec.events.clear();
+        dropped = rec.dropped;
+    }
+
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "displayTimeUnit");
+    json_builder_add_string_value(builder, "ms");
+    json_builder_set_member_name(builder, "traceEvents");
+    json_builder_begin_array(builder);
+
+    add_thread_name(builder, 1, "main");
+    int max_tid = next_tid.load() - 1;
+    for (int tid = 2; tid <= max_tid; tid++) {
+        g_autofree gchar* name = g_strdup_printf("worker %d", tid - 1);
+        add_thread_name(builder, tid, name);
+    }
+
+    guint64 async_id = 0;
+    for (const auto& event : events) {
+        switch (event.phase) {
+        case 'X':
+            json_builder_begin_object(builder);
+            add_common(builder, event, "X", event.start);
+            json_builder_set_member_name(builder, "dur");
+            json_builder_add_int_value(builder, event.duration);
+            json_builder_end_object(builder);
+            break;
+        case 'a': {
+            // Nestable async begin/end pair with an id of its own
+            g_autofree gchar* id = g_strdup_printf("0x%" G_GINT64_MODIFIER "x", ++async_id);
+            for (const char* phase : {"b", "e"}) {
+                json_builder_begin_object(builder);
+                add_common(builder, event, phase, *phase == 'b' ? event.start : event.start + event.duration);
+                json_builder_set_member_name(builder, "id");
+                json_builder_add_string_value(builder, id);
+                json_builder_end_object(builder);
+            }
+            break;
+        }
+        case 'i':
+            json_builder_begin_object(builder);
+            add_common(builder, event, "i", event.start);
+            json_builder_set_member_name(builder, "s");
+            json_builder_add_string_value(builder, "p");
+            json_builder_end_object(builder);
+            break;
+        }
+    }
+
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+
+    g_autoptr(GError) error = nullptr;
+    if (!json_generator_to_file(generator, rec.path.c_str(), &error)) {
+        g_warning("Failed to write profile: %s", error->message);
+        return;
+    }
+
+    g_message("Profile written to %s (%zu events%s)", rec.path.c_str(), events.size(),
+              dropped ? ", some dropped" : "");
+}
+
+} // namespace Madari
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <glib.h>
+#include <atomic>
+#include <string>
+
+namespace Madari {
+
+/**
+ * Records spans into a Chrome trace (chrome://tracing, Perfetto).
+ * Enabled with the --profile flag or MADARI_PROFILE=1 (or =path/to/trace.json);
+ * the trace is written on exit. Spans stay compiled in: while disabled
+ * each costs a single relaxed atomic load. Safe to use from any thread.
+ */
+class Profiler {
+public:
+    /**
+     * Start recording if asked to by argv or the environment. Call first
+     * thing in main so startup is covered from the beginning.
+     */
+    static void init(int argc, char* argv[]);
+
+    /**
+     * Start recording, to be written to path
+     */
+    static void start(const std::string& path);
+
+    /**
+     * Write the trace and stop recording
+     */
+    static void stop();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * Microseconds since recording started
+     */
+    static gint64 now();
+
+    /**
+     * A span on the calling thread from start to now; spans nest by time
+     */
+    static void complete(const char* name, const char* category, gint64 start,
+                         const std::string& detail = {});
+
+    /**
+     * A span on its own track, for work that starts in one callback and
+     * ends in another (requests, decodes)
+     */
+    static void async(const char* name, const char* category, gint64 start,
+                      const std::string& detail = {});
+
+    /**
+     * A point in time, e.g. the first frame
+     */
+    static void instant(const char* name, const char* category);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * Records a span for the lifetime of the object
+ */
+class ProfileSpan {
+public:
+    ProfileSpan(const char* name, const char* category)
+        : name_(name), category_(category),
+          start_(Profiler::enabled() ? Profiler::now() : -1) {}
+
+    ~ProfileSpan() {
+        if (start_ >= 0) Profiler::complete(name_, category_, start_, detail_);
+    }
+
+    ProfileSpan(const ProfileSpan&) = delete;
+    ProfileSpan& operator=(const ProfileSpan&) = delete;
+
+    /**
+     * Extra text shown with the span; check Profiler::enabled() before
+     * building anything costly for it
+     */
+    void set_detail(std::string detail) { detail_ = std::move(detail); }
+
+private:
+    const char* name_;
+    const char* category_;
+    gint64 start_;
+    std::string detail_;
+};
+
+} // namespace Madari
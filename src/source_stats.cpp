@@ -0,0 +1,316 @@
+#include "source_stats.hpp"
+#include "profiler.hpp"
+#include <json-glib/json-glib.h>
+#include <glib.h>
+#include <algorithm>
+#include <ctime>
+
+namespace Madari {
+
+// Once a key has this many attempts its counters are halved, so recent
+// behaviour outweighs what a source did months ago
+static const double STATS_DECAY_ATTEMPTS = 40.0;
+
+// Attempts needed before a key's stats count fully
+static const double STATS_FULL_CONFIDENCE = 4.0;
+
+// Outcomes come in bursts around a playback; one write covers the burst
+static const guint SAVE_DELAY_SECONDS = 5;
+
+static std::string addon_key(const std::string& addon_id) {
+    return "addon:" + addon_id;
+}
+
+static std::string host_key(const std::string& host) {
+    return "host:" + host;
+}
+
+static std::string binge_key(const std::string& addon_id, const std::string& binge_group) {
+    return "binge:" + addon_id + "|" + binge_group;
+}
+
+// Score a single key's stats, 0 = neutral
+static double score_stats(const SourceStats& stats) {
+    double score = 0;
+
+    score -= 50.0 * stats.error_rate();
+    score -= std::min(10.0, 4.0 * stats.stalls_per_start());
+
+    // Slow starts cost up to 10, anything under a second is free
+    double start_s = stats.avg_start_ms() / 1000.0;
+    if (start_s > 1.0) {
+        score -= std::min(10.0, 1.5 * (start_s - 1.0));
+    }
+
+    if (stats.attempts >= 3 && stats.error_rate() < 0.1 && stats.stalls_per_start() < 0.5) {
+        score += 8.0;
+    }
+
+    double confidence = std::min(1.0, stats.attempts / STATS_FULL_CONFIDENCE);
+    return score * confidence;
+}
+
+SourceStatsService::SourceStatsService()
+    : cancellable_(g_cancellable_new()) {
+    storage_path_ = get_storage_path();
+}
+
+SourceStatsService::~SourceStatsService() {
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+
+    // Outcomes since the last save would otherwise be lost at exit
+    flush();
+}
+
+std::string SourceStatsService::get_storage_path() {
+    const char *data_dir = g_get_user_data_dir();
+    std::string app_dir = std::string(data_dir) + "/madari";
+    g_mkdir_with_parents(app_dir.c_str(), 0755);
+    return app_dir + "/source_stats.json";
+}
+
+std::string SourceStatsService::host_of(const std::string& url) {
+    if (url.empty()) return "";
+
+    g_autoptr(GUri) uri = g_uri_parse(url.c_str(), G_URI_FLAGS_NONE, nullptr);
+    if (!uri || !g_uri_get_host(uri)) return "";
+
+    g_autofree gchar *host = g_ascii_strdown(g_uri_get_host(uri), -1);
+    return host;
+}
+
+// Parse the saved stats; touches no service state, so it runs on a worker
+static std::unordered_map<std::string, SourceStats> read_stats(const std::string& path) {
+    ProfileSpan span("load source stats", "services");
+    std::unordered_map<std::string, SourceStats> stats_by_key;
+
+    if (!g_file_test(path.c_str(), G_FILE_TEST_EXISTS)) {
+        return stats_by_key;
+    }
+
+    g_autoptr(GError) error = nullptr;
+    g_autoptr(JsonParser) parser = json_parser_new();
+
+    if (!json_parser_load_from_file(parser, path.c_str(), &error)) {
+        g_warning("Failed to load source stats: %s", error->message);
+        return stats_by_key;
+    }
+
+    JsonNode *root = json_parser_get_root(parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root)) {
+        g_warning("Invalid source stats format");
+        return stats_by_key;
+    }
+
+    JsonObject *object = json_node_get_object(root);
+    JsonObjectIter iter;
+    const gchar *key;
+    JsonNode *node;
+    json_object_iter_init(&iter, object);
+    while (json_object_iter_next(&iter, &key, &node)) {
+        if (!JSON_NODE_HOLDS_OBJECT(node)) continue;
+        JsonObject *obj = json_node_get_object(node);
+
+        SourceStats stats;
+        stats.attempts = json_object_get_double_member_with_default(obj, "attempts", 0);
+        stats.starts = json_object_get_double_member_with_default(obj, "starts", 0);
+        stats.errors = json_object_get_double_member_with_default(obj, "errors", 0);
+        stats.stalls = json_object_get_double_member_with_default(obj, "stalls", 0);
+        stats.total_start_ms = json_object_get_double_member_with_default(obj, "total_start_ms", 0);
+        stats.last_used = json_object_get_int_member_with_default(obj, "last_used", 0);
+
+        if (stats.attempts > 0) {
+            stats_by_key[key] = stats;
+        }
+    }
+    return stats_by_key;
+}
+
+void SourceStatsService::load() {
+    stats_ = read_stats(storage_path_);
+    loaded_ = true;
+}
+
+void SourceStatsService::load_async() {
+    struct StatsRead {
+        std::string path;
+        std::unordered_map<std::string, SourceStats> stats;
+    };
+
+    GTask *task = g_task_new(nullptr, cancellable_,
+        [](GObject*, GAsyncResult *result, gpointer user_data) {
+            // Cancelled when the service went away first
+            if (g_task_had_error(G_TASK(result))) return;
+
+            auto *self = static_cast<SourceStatsService*>(user_data);
+            auto *read = static_cast<StatsRead*>(g_task_get_task_data(G_TASK(result)));
+
+            // Keys recorded while reading are newer than the file
+            bool recorded = !self->stats_.empty();
+            for (auto& [key, stats] : read->stats) {
+                self->stats_.emplace(key, stats);
+            }
+            self->loaded_ = true;
+            if (recorded) self->schedule_save();
+        }, this);
+    g_task_set_task_data(task, new StatsRead{storage_path_, {}},
+                         [](gpointer d) { delete static_cast<StatsRead*>(d); });
+    g_task_run_in_thread(task, [](GTask *task, gpointer, gpointer task_data, GCancellable*) {
+        auto *read = static_cast<StatsRead*>(task_data);
+        read->stats = read_stats(read->path);
+        g_task_return_boolean(task, TRUE);
+    });
+    g_object_unref(task);
+}
+
+void SourceStatsService::save() {
+    // Until the file is read, stats_ only holds what was recorded since
+    if (!loaded_) return;
+
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+
+    json_builder_begin_object(builder);
+
+    for (const auto& [key, stats] : stats_) {
+        json_builder_set_member_name(builder, key.c_str());
+        json_builder_begin_object(builder);
+
+        json_builder_set_member_name(builder, "attempts");
+        json_builder_add_double_value(builder, stats.attempts);
+
+        json_builder_set_member_name(builder, "starts");
+        json_builder_add_double_value(builder, stats.starts);
+
+        json_builder_set_member_name(builder, "errors");
+        json_builder_add_double_value(builder, stats.errors);
+
+        json_builder_set_member_name(builder, "stalls");
+        json_builder_add_double_value(builder, stats.stalls);
+
+        json_builder_set_member_name(builder, "total_start_ms");
+        json_builder_add_double_value(builder, stats.total_start_ms);
+
+        json_builder_set_member_name(builder, "last_used");
+        json_builder_add_int_value(builder, stats.last_used);
+
+        json_builder_end_object(builder);
+    }
+
+    json_builder_end_object(builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    json_generator_set_pretty(generator, TRUE);
+
+    JsonNode *root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+
+    g_autoptr(GError) error = nullptr;
+    if (!json_generator_to_file(generator, storage_path_.c_str(), &error)) {
+        g_warning("Failed to save source stats: %s", error->message);
+    }
+
+    json_node_unref(root);
+}
+
+void SourceStatsService::schedule_save() {
+    if (save_source_ || !loaded_) return;
+
+    save_source_ = g_timeout_add_seconds(SAVE_DELAY_SECONDS, [](gpointer user_data) -> gboolean {
+        auto *self = static_cast<SourceStatsService*>(user_data);
+        self->save_source_ = 0;
+        self->save();
+        return G_SOURCE_REMOVE;
+    }, this);
+}
+
+void SourceStatsService::flush() {
+    if (!save_source_) return;
+
+    g_clear_handle_id(&save_source_, g_source_remove);
+    save();
+}
+
+template <typename Fn>
+void SourceStatsService::update(const PlaybackSource& source, Fn&& fn) {
+    if (source.addon_id.empty()) return;
+
+    std::string host = host_of(source.url);
+    std::string keys[3] = {
+        addon_key(source.addon_id),
+        host.empty() ? "" : host_key(host),
+        source.binge_group.empty() ? "" : binge_key(source.addon_id, source.binge_group),
+    };
+
+    int64_t now = std::time(nullptr);
+    for (const auto& key : keys) {
+        if (key.empty()) continue;
+
+        SourceStats& stats = stats_[key];
+        if (stats.attempts >= STATS_DECAY_ATTEMPTS) {
+            stats.attempts /= 2;
+            stats.starts /= 2;
+            stats.errors /= 2;
+            stats.stalls /= 2;
+            stats.total_start_ms /= 2;
+        }
+        fn(stats);
+        stats.last_used = now;
+    }
+
+    schedule_save();
+}
+
+void SourceStatsService::record_start(const PlaybackSource& source, double start_ms) {
+    update(source, [start_ms](SourceStats& stats) {
+        stats.attempts += 1;
+        stats.starts += 1;
+        stats.total_start_ms += start_ms;
+    });
+}
+
+void SourceStatsService::record_error(const PlaybackSource& source) {
+    update(source, [](SourceStats& stats) {
+        stats.attempts += 1;
+        stats.errors += 1;
+    });
+}
+
+void SourceStatsService::record_stall(const PlaybackSource& source) {
+    update(source, [](SourceStats& stats) {
+        stats.stalls += 1;
+    });
+}
+
+double SourceStatsService::preference(const std::string& addon_id, const std::string& url,
+                                      const std::string& binge_group) const {
+    if (addon_id.empty() || stats_.empty()) return 0.0;
+
+    // The more specific the key, the more it says about this stream
+    struct Weighted { std::string key; double weight; };
+    std::string host = host_of(url);
+    Weighted keys[3] = {
+        {binge_group.empty() ? "" : binge_key(addon_id, binge_group), 1.0},
+        {host.empty() ? "" : host_key(host), 0.7},
+        {addon_key(addon_id), 0.4},
+    };
+
+    double total = 0;
+    double weights = 0;
+    for (const auto& [key, weight] : keys) {
+        if (key.empty()) continue;
+        auto it = stats_.find(key);
+        if (it == stats_.end()) continue;
+        total += weight * score_stats(it->second);
+        weights += weight;
+    }
+
+    return weights > 0 ? total / weights : 0.0;
+}
+
+double SourceStatsService::preference(const std::string& addon_id, const Stremio::Stream& stream) const {
+    return preference(addon_id, stream.url.value_or(""),
+                      stream.behavior_hints.binge_group.value_or(""));
+}
+
+} // namespace Madari
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "stremio/stremio_types.hpp"
+#include <gio/gio.h>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace Madari {
+
+/**
+ * Where a playback came from: the addon that offered the stream, the URL
+ * that was loaded and the stream's binge group (may be empty)
+ */
+struct PlaybackSource {
+    std::string addon_id;
+    std::string url;
+    std::string binge_group;
+};
+
+/**
+ * Accumulated playback outcomes for one addon, host or binge group.
+ * Counters are doubles because older samples are decayed by halving.
+ */
+struct SourceStats {
+    double attempts = 0;          // Playbacks that either started or failed
+    double starts = 0;            // Reached the first frame
+    double errors = 0;            // Failed to open, or abandoned before starting
+    double stalls = 0;            // Rebuffering pauses after the first frame
+    double total_start_ms = 0;    // Sum of loadfile-to-first-frame latency over starts
+    int64_t last_used = 0;        // Unix timestamp of the last outcome
+
+    double error_rate() const {
+        return attempts > 0 ? errors / attempts : 0.0;
+    }
+
+    double avg_start_ms() const {
+        return starts > 0 ? total_start_ms / starts : 0.0;
+    }
+
+    double stalls_per_start() const {
+        return starts > 0 ? stalls / starts : 0.0;
+    }
+};
+
+/**
+ * Local store of playback outcomes keyed per addon, per host and per
+ * binge group, used to prefer sources that start fast and play smoothly
+ * and to sink the ones that keep failing.
+ */
+class SourceStatsService {
+public:
+    SourceStatsService();
+    ~SourceStatsService();
+
+    /**
+     * Load stats from disk
+     */
+    void load();
+
+    /**
+     * Load stats from disk on a worker thread; outcomes recorded meanwhile
+     * are kept
+     */
+    void load_async();
+
+    /**
+     * Save stats to disk
+     */
+    void save();
+
+    /**
+     * Write outcomes recorded since the last save now; also done on
+     * destruction
+     */
+    void flush();
+
+    /**
+     * The source reached its first frame after start_ms
+     */
+    void record_start(const PlaybackSource& source, double start_ms);
+
+    /**
+     * The source failed to open or was abandoned while still loading
+     */
+    void record_error(const PlaybackSource& source);
+
+    /**
+     * The source paused to rebuffer after playback had started
+     */
+    void record_stall(const PlaybackSource& source);
+
+    /**
+     * Ranking adjustment for a source, 0 when nothing is known. Roughly
+     * +8 for a proven reliable source down to -60 for one that keeps failing.
+     * @param url Stream URL, may be empty (torrents have no host to learn from)
+     */
+    double preference(const std::string& addon_id, const std::string& url,
+                      const std::string& binge_group) const;
+
+    /**
+     * preference() for a stream as offered by an addon
+     */
+    double preference(const std::string& addon_id, const Stremio::Stream& stream) const;
+
+    /**
+     * Host part of a URL, empty for magnets and unparsable URLs
+     */
+    static std::string host_of(const std::string& url);
+
+private:
+    std::unordered_map<std::string, SourceStats> stats_;
+    std::string storage_path_;
+    GCancellable *cancellable_;
+    bool loaded_ = false;
+    guint save_source_ = 0;
+
+    std::string get_storage_path();
+    void schedule_save();
+
+    template <typename Fn>
+    void update(const PlaybackSource& source, Fn&& fn);
+};
+
+} // namespace Madari
@@ -0,0 +1,357 @@
+#include "stream_list.hpp"
+#include <algorithm>
+
+// ============= Stream Item =============
+
+struct _MadariStreamItem {
+    GObject parent_instance;
+
+    const Stremio::RankedStream *ranked;  // Owned by the ranker
+    std::string *title;
+    std::string *details;         // Stream title or description
+    std::string *traits;          // Extracted traits, e.g. "2160p · HDR"
+    std::string *probe_summary;   // Empty until probed
+    int probe_rank;
+};
+
+G_DEFINE_TYPE(MadariStreamItem, madari_stream_item, G_TYPE_OBJECT)
+
+static void madari_stream_item_finalize(GObject *object) {
+    MadariStreamItem *self = MADARI_STREAM_ITEM(object);
+
+    delete self->title;
+    delete self->details;
+    delete self->traits;
+    delete self->probe_summary;
+
+    G_OBJECT_CLASS(madari_stream_item_parent_class)->finalize(object);
+}
+
+static void madari_stream_item_class_init(MadariStreamItemClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = madari_stream_item_finalize;
+}
+
+static void madari_stream_item_init(MadariStreamItem *self) {
+    self->ranked = nullptr;
+    self->title = new std::string();
+    self->details = new std::string();
+    self->traits = new std::string();
+    self->probe_summary = new std::string();
+    self->probe_rank = 0;
+}
+
+MadariStreamItem *madari_stream_item_new(const Stremio::RankedStream *ranked) {
+    MadariStreamItem *self = MADARI_STREAM_ITEM(g_object_new(MADARI_TYPE_STREAM_ITEM, nullptr));
+    self->ranked = ranked;
+    const Stremio::Stream& stream = self->ranked->stream;
+
+    // Build stream title - prefer name, then title
+    std::string title;
+    std::string details;
+
+    if (stream.name.has_value() && !stream.name->empty()) {
+        // Stream name often contains quality info like "Torrentio\n4K"
+        // Replace newlines with " • "
+        title = *stream.name;
+        size_t pos;
+        while ((pos = title.find('\n')) != std::string::npos) {
+            title.replace(pos, 1, " • ");
+        }
+    }
+
+    if (stream.title.has_value() && !stream.title->empty()) {
+        if (title.empty()) {
+            title = *stream.title;
+        } else {
+            details = *stream.title;
+        }
+    }
+
+    if (title.empty()) {
+        title = "Stream";
+    }
+
+    // Use description for more details
+    if (stream.description.has_value() && !stream.description->empty()) {
+        if (details.empty()) {
+            details = *stream.description;
+        }
+    }
+
+    *self->title = title;
+    *self->details = details;
+    *self->traits = Stremio::StreamRanker::describe(ranked->traits);
+    return self;
+}
+
+const Stremio::RankedStream& madari_stream_item_get_ranked(MadariStreamItem *self) {
+    return *self->ranked;
+}
+
+const Stremio::Stream& madari_stream_item_get_stream(MadariStreamItem *self) {
+    return self->ranked->stream;
+}
+
+const std::string& madari_stream_item_get_title(MadariStreamItem *self) {
+    return *self->title;
+}
+
+int madari_stream_item_get_probe_rank(MadariStreamItem *self) {
+    return self->probe_rank;
+}
+
+void madari_stream_item_set_probe_rank(MadariStreamItem *self, int rank) {
+    self->probe_rank = rank;
+}
+
+// ============= Row Factory =============
+
+// Rows are built once per visible slot and rebound as the list scrolls
+static void on_stream_row_setup([[maybe_unused]] GtkSignalListItemFactory *factory,
+                                GtkListItem *list_item, MadariStreamList *list) {
+    GtkWidget *row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    gtk_widget_set_margin_start(row, 12);
+    gtk_widget_set_margin_end(row, 6);
+    gtk_widget_set_margin_top(row, 8);
+    gtk_widget_set_margin_bottom(row, 8);
+
+    GtkWidget *icon = gtk_image_new();
+    gtk_widget_set_valign(icon, GTK_ALIGN_CENTER);
+    gtk_box_append(GTK_BOX(row), icon);
+
+    GtkWidget *text_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+    gtk_widget_set_hexpand(text_box, TRUE);
+    gtk_widget_set_valign(text_box, GTK_ALIGN_CENTER);
+
+    GtkWidget *title = gtk_label_new(nullptr);
+    gtk_label_set_wrap(GTK_LABEL(title), TRUE);
+    gtk_label_set_wrap_mode(GTK_LABEL(title), PANGO_WRAP_WORD_CHAR);
+    gtk_label_set_xalign(GTK_LABEL(title), 0);
+    gtk_box_append(GTK_BOX(text_box), title);
+
+    GtkWidget *subtitle = gtk_label_new(nullptr);
+    gtk_label_set_wrap(GTK_LABEL(subtitle), TRUE);
+    gtk_label_set_wrap_mode(GTK_LABEL(subtitle), PANGO_WRAP_WORD_CHAR);
+    gtk_label_set_xalign(GTK_LABEL(subtitle), 0);
+    gtk_widget_add_css_class(subtitle, "caption");
+    gtk_widget_add_css_class(subtitle, "dim-label");
+    gtk_box_append(GTK_BOX(text_box), subtitle);
+
+    gtk_box_append(GTK_BOX(row), text_box);
+
+    GtkWidget *play_btn = gtk_button_new_from_icon_name("media-playback-start-symbolic");
+    gtk_widget_add_css_class(play_btn, "flat");
+    gtk_widget_set_valign(play_btn, GTK_ALIGN_CENTER);
+    gtk_box_append(GTK_BOX(row), play_btn);
+
+    g_signal_connect(play_btn, "clicked", G_CALLBACK(+[]([[maybe_unused]] GtkButton *btn, GtkListItem *list_item) {
+        MadariStreamList *list = static_cast<MadariStreamList*>(
+            g_object_get_data(G_OBJECT(list_item), "stream-list"));
+        gpointer item = gtk_list_item_get_item(list_item);
+        if (list && item && list->on_activate) {
+            list->on_activate(MADARI_STREAM_ITEM(item));
+        }
+    }), list_item);
+
+    g_object_set_data(G_OBJECT(list_item), "stream-list", list);
+    g_object_set_data(G_OBJECT(row), "icon", icon);
+    g_object_set_data(G_OBJECT(row), "title", title);
+    g_object_set_data(G_OBJECT(row), "subtitle", subtitle);
+    gtk_list_item_set_child(list_item, row);
+}
+
+static void on_stream_row_bind([[maybe_unused]] GtkSignalListItemFactory *factory,
+                               GtkListItem *list_item, [[maybe_unused]] MadariStreamList *list) {
+    MadariStreamItem *item = MADARI_STREAM_ITEM(gtk_list_item_get_item(list_item));
+    GtkWidget *row = gtk_list_item_get_child(list_item);
+    const Stremio::Stream& stream = madari_stream_item_get_stream(item);
+
+    const char *icon_name = "network-server-symbolic";
+    if (stream.info_hash.has_value()) {
+        icon_name = "network-transmit-symbolic";
+    } else if (stream.yt_id.has_value()) {
+        icon_name = "video-display-symbolic";
+    }
+    gtk_image_set_from_icon_name(GTK_IMAGE(g_object_get_data(G_OBJECT(row), "icon")), icon_name);
+
+    gtk_label_set_text(GTK_LABEL(g_object_get_data(G_OBJECT(row), "title")), item->title->c_str());
+
+    // Addons are read at bind time, as later batches add to also_from
+    std::string subtitle = *item->details;
+    std::string addons = item->ranked->addon_name;
+    for (const auto& other : item->ranked->also_from) {
+        addons += ", " + other;
+    }
+    subtitle += (subtitle.empty() ? "" : "\n") + addons;
+    if (!item->traits->empty()) {
+        subtitle += "\n" + *item->traits;
+    }
+    if (!item->probe_summary->empty()) {
+        subtitle += "\n" + *item->probe_summary;
+    }
+    gtk_label_set_text(GTK_LABEL(g_object_get_data(G_OBJECT(row), "subtitle")), subtitle.c_str());
+}
+
+// ============= Stream List =============
+
+static gboolean stream_matches_filter(gpointer object, gpointer user_data) {
+    MadariStreamList *list = static_cast<MadariStreamList*>(user_data);
+    if (list->addon_filter.empty()) return TRUE;
+
+    // Deduplicated streams count for every addon that offered them
+    const Stremio::RankedStream& ranked = madari_stream_item_get_ranked(MADARI_STREAM_ITEM(object));
+    return ranked.addon_name == list->addon_filter ||
+           std::find(ranked.also_from.begin(), ranked.also_from.end(), list->addon_filter) !=
+               ranked.also_from.end();
+}
+
+// Probed streams first in order of measured speed, the rest by rank score
+static int compare_stream_items(gconstpointer a, gconstpointer b, [[maybe_unused]] gpointer user_data) {
+    MadariStreamItem *item_a = MADARI_STREAM_ITEM(const_cast<gpointer>(a));
+    MadariStreamItem *item_b = MADARI_STREAM_ITEM(const_cast<gpointer>(b));
+
+    int rank_a = item_a->probe_rank;
+    int rank_b = item_b->probe_rank;
+    if (rank_a != rank_b) {
+        if (rank_a == 0) return GTK_ORDERING_LARGER;
+        if (rank_b == 0) return GTK_ORDERING_SMALLER;
+        return rank_a < rank_b ? GTK_ORDERING_SMALLER : GTK_ORDERING_LARGER;
+    }
+
+    const Stremio::RankedStream& ranked_a = *item_a->ranked;
+    const Stremio::RankedStream& ranked_b = *item_b->ranked;
+    if (ranked_a.score != ranked_b.score) {
+        return ranked_a.score > ranked_b.score ? GTK_ORDERING_SMALLER : GTK_ORDERING_LARGER;
+    }
+    if (ranked_a.arrival != ranked_b.arrival) {
+        return ranked_a.arrival < ranked_b.arrival ? GTK_ORDERING_SMALLER : GTK_ORDERING_LARGER;
+    }
+    return GTK_ORDERING_EQUAL;
+}
+
+MadariStreamList *madari_stream_list_new(MadariStreamList::ActivateCallback on_activate) {
+    MadariStreamList *list = new MadariStreamList();
+    list->on_activate = std::move(on_activate);
+
+    list->store = g_list_store_new(MADARI_TYPE_STREAM_ITEM);
+
+    // The filter and sort models take ownership of their inputs; keep our own refs
+    list->filter = gtk_custom_filter_new(stream_matches_filter, list, nullptr);
+    list->filtered = gtk_filter_list_model_new(G_LIST_MODEL(g_object_ref(list->store)),
+                                               GTK_FILTER(g_object_ref(list->filter)));
+    list->sorter = gtk_custom_sorter_new(compare_stream_items, nullptr, nullptr);
+    list->sorted = gtk_sort_list_model_new(G_LIST_MODEL(g_object_ref(list->filtered)),
+                                           GTK_SORTER(g_object_ref(list->sorter)));
+
+    GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+    g_signal_connect(factory, "setup", G_CALLBACK(on_stream_row_setup), list);
+    g_signal_connect(factory, "bind", G_CALLBACK(on_stream_row_bind), list);
+
+    GtkNoSelection *selection = gtk_no_selection_new(G_LIST_MODEL(g_object_ref(list->sorted)));
+    list->list_view = gtk_list_view_new(GTK_SELECTION_MODEL(selection), factory);
+    // Outlives the dialog's widget tree until madari_stream_list_free()
+    g_object_ref_sink(list->list_view);
+    gtk_list_view_set_single_click_activate(GTK_LIST_VIEW(list->list_view), TRUE);
+    gtk_list_view_set_show_separators(GTK_LIST_VIEW(list->list_view), TRUE);
+    gtk_widget_add_css_class(list->list_view, "card");
+
+    g_signal_connect(list->list_view, "activate", G_CALLBACK(+[](GtkListView *view, guint position, MadariStreamList *list) {
+        GListModel *model = G_LIST_MODEL(gtk_list_view_get_model(view));
+        g_autoptr(GObject) item = G_OBJECT(g_list_model_get_item(model, position));
+        if (item && list->on_activate) {
+            list->on_activate(MADARI_STREAM_ITEM(item));
+        }
+    }), list);
+
+    list->scroll = gtk_scrolled_window_new();
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(list->scroll), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(list->scroll), list->list_view);
+    gtk_widget_set_vexpand(list->scroll, TRUE);
+
+    return list;
+}
+
+void madari_stream_list_free(MadariStreamList *list) {
+    if (!list) return;
+
+    // Rows may outlive us briefly while the dialog is torn down
+    g_signal_handlers_disconnect_by_data(list->list_view, list);
+    gtk_list_view_set_model(GTK_LIST_VIEW(list->list_view), nullptr);
+    g_object_unref(list->list_view);
+
+    g_object_unref(list->sorted);
+    g_object_unref(list->sorter);
+    g_object_unref(list->filtered);
+    g_object_unref(list->filter);
+    g_object_unref(list->store);
+    delete list;
+}
+
+// Replace the item with itself so the filter, sorter and a bound row see
+// its changes; hold a ref so removal doesn't finalize it mid-splice
+static void refresh_item(MadariStreamList *list, MadariStreamItem *item) {
+    guint position = 0;
+    if (g_list_store_find(list->store, item, &position)) {
+        g_object_ref(item);
+        gpointer items[] = {item};
+        g_list_store_splice(list->store, position, 1, items, 1);
+        g_object_unref(item);
+    }
+}
+
+void madari_stream_list_append(MadariStreamList *list, const std::vector<const Stremio::RankedStream*>& ranked,
+                               const std::vector<const Stremio::RankedStream*>& folded) {
+    for (const Stremio::RankedStream *entry : folded) {
+        auto it = list->items.find(entry);
+        if (it != list->items.end()) {
+            refresh_item(list, it->second);
+        }
+    }
+
+    if (ranked.empty()) return;
+
+    std::vector<gpointer> items;
+    items.reserve(ranked.size());
+    for (const Stremio::RankedStream *entry : ranked) {
+        MadariStreamItem *item = madari_stream_item_new(entry);
+        list->items[entry] = item;
+        items.push_back(item);
+    }
+
+    // One splice so the filter and sorter see the whole batch at once
+    g_list_store_splice(list->store, g_list_model_get_n_items(G_LIST_MODEL(list->store)), 0,
+                        items.data(), static_cast<guint>(items.size()));
+
+    for (gpointer item : items) {
+        g_object_unref(item);
+    }
+}
+
+void madari_stream_list_set_addon_filter(MadariStreamList *list, const std::string& addon_name) {
+    if (list->addon_filter == addon_name) return;
+
+    // Switching between addons is a different set, not a strict subset
+    GtkFilterChange change = list->addon_filter.empty() ? GTK_FILTER_CHANGE_MORE_STRICT :
+                             addon_name.empty() ? GTK_FILTER_CHANGE_LESS_STRICT :
+                                                  GTK_FILTER_CHANGE_DIFFERENT;
+    list->addon_filter = addon_name;
+    gtk_filter_changed(GTK_FILTER(list->filter), change);
+}
+
+GListModel *madari_stream_list_get_visible(MadariStreamList *list) {
+    return G_LIST_MODEL(list->sorted);
+}
+
+void madari_stream_list_set_probe_summary(MadariStreamList *list, MadariStreamItem *item,
+                                          const std::string& summary) {
+    *item->probe_summary = summary;
+    refresh_item(list, item);
+}
+
+void madari_stream_list_resort(MadariStreamList *list) {
+    gtk_sorter_changed(GTK_SORTER(list->sorter), GTK_SORTER_CHANGE_DIFFERENT);
+}
+
+guint madari_stream_list_get_n_items(MadariStreamList *list) {
+    return g_list_model_get_n_items(G_LIST_MODEL(list->store));
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <adwaita.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "stremio/stremio.hpp"
+
+G_BEGIN_DECLS
+
+#define MADARI_TYPE_STREAM_ITEM (madari_stream_item_get_type())
+
+G_DECLARE_FINAL_TYPE(MadariStreamItem, madari_stream_item, MADARI, STREAM_ITEM, GObject)
+
+/**
+ * List item pointing at one ranked stream, with its display text built
+ * once. The ranker owns the stream and must outlive the item; its
+ * also_from keeps growing as other addons offer the same source.
+ */
+MadariStreamItem *madari_stream_item_new(const Stremio::RankedStream *ranked);
+
+const Stremio::RankedStream& madari_stream_item_get_ranked(MadariStreamItem *self);
+const Stremio::Stream& madari_stream_item_get_stream(MadariStreamItem *self);
+
+/**
+ * Display title, e.g. "Torrentio • 4K"
+ */
+const std::string& madari_stream_item_get_title(MadariStreamItem *self);
+
+/**
+ * 1-based position among probed streams, 0 if not probed (or failed)
+ */
+int madari_stream_item_get_probe_rank(MadariStreamItem *self);
+void madari_stream_item_set_probe_rank(MadariStreamItem *self, int rank);
+
+G_END_DECLS
+
+/**
+ * Model-backed stream list shared by the stream selection dialogs:
+ * GListStore -> GtkFilterListModel (addon filter) -> GtkSortListModel
+ * (probe rank, then ranker score) -> recycling GtkListView.
+ *
+ * Rows are only created for what is on screen, so titles with thousands
+ * of torrent results open and scroll without building a widget per stream.
+ */
+struct MadariStreamList {
+    using ActivateCallback = std::function<void(MadariStreamItem *item)>;
+
+    GListStore *store;
+    GtkCustomFilter *filter;
+    GtkFilterListModel *filtered;
+    GtkCustomSorter *sorter;
+    GtkSortListModel *sorted;
+    GtkWidget *list_view;
+    GtkWidget *scroll;           // Scrolled window holding list_view, add this to the dialog
+    std::string addon_filter;    // Addon name to show, empty for all
+    ActivateCallback on_activate;
+    std::unordered_map<const Stremio::RankedStream*, MadariStreamItem*> items;  // Owned by store
+};
+
+MadariStreamList *madari_stream_list_new(MadariStreamList::ActivateCallback on_activate);
+
+void madari_stream_list_free(MadariStreamList *list);
+
+/**
+ * Append streams as returned by StreamRanker::add_batch, in one splice.
+ * folded are the entries the batch duplicated; their rows and the addon
+ * filter are updated for the new also_from.
+ */
+void madari_stream_list_append(MadariStreamList *list, const std::vector<const Stremio::RankedStream*>& ranked,
+                               const std::vector<const Stremio::RankedStream*>& folded = {});
+
+/**
+ * Show only streams offered by addon_name (empty shows all)
+ */
+void madari_stream_list_set_addon_filter(MadariStreamList *list, const std::string& addon_name);
+
+/**
+ * Streams currently shown, in display order
+ */
+GListModel *madari_stream_list_get_visible(MadariStreamList *list);
+
+/**
+ * Show a probe result (e.g. "120 ms · 8.4 MB/s") under an item
+ */
+void madari_stream_list_set_probe_summary(MadariStreamList *list, MadariStreamItem *item,
+                                          const std::string& summary);
+
+/**
+ * Re-sort after probe ranks changed
+ */
+void madari_stream_list_resort(MadariStreamList *list);
+
+guint madari_stream_list_get_n_items(MadariStreamList *list);
@@ -10,6 +10,14 @@
  * - stremio_parser.hpp: JSON parser for Stremio responses
  * - stremio_client.hpp: HTTP client for addon API calls
  * - stremio_addon_service.hpp: Service for managing installed addons
+ * - stremio_stream_probe.hpp: TTFB/throughput probing of HTTP stream sources
+ * - stremio_stream_ranker.hpp: Trait extraction, dedupe and ranking of streams
+ * - stremio_video_index.hpp: Season index over a meta's videos, parsed on demand
+ * - stremio_meta_cache.hpp: Memory and disk cache of meta responses
+ * - stremio_search_aggregator.hpp: Cross-addon dedupe and ranking of search results
+ * - stremio_local_index.hpp: Persistent full-text index of catalog items seen
+ * - stremio_gzip.hpp: gzip helpers shared by the on-disk caches
+ * - stremio_catalog_cache.hpp: Memory and disk cache of catalog pages
  * 
  * Usage:
  * 
@@ -52,3 +60,11 @@
 #include "stremio_parser.hpp"
 #include "stremio_client.hpp"
 #include "stremio_addon_service.hpp"
+#include "stremio_stream_probe.hpp"
+#include "stremio_stream_ranker.hpp"
+#include "stremio_video_index.hpp"
+#include "stremio_meta_cache.hpp"
+#include "stremio_search_aggregator.hpp"
+#include "stremio_local_index.hpp"
+#include "stremio_gzip.hpp"
+#include "stremio_catalog_cache.hpp"
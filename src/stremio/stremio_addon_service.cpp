@@ -1,5 +1,7 @@
 #include "stremio_addon_service.hpp"
 #include "stremio_parser.hpp"
+#include "../profiler.hpp"
+#include "../log.hpp"
 #include <json-glib/json-glib.h>
 #include <glib.h>
 #include <fstream>
@@ -9,11 +11,20 @@
 
 namespace Stremio {
 
-AddonService::AddonService() : client_(std::make_unique<Client>()) {
+AddonService::AddonService()
+    : client_(std::make_unique<Client>()),
+      probe_(std::make_unique<StreamProbe>()),
+      meta_cache_(std::make_unique<MetaCache>()),
+      local_index_(std::make_unique<LocalIndex>()),
+      catalog_cache_(std::make_unique<CatalogCache>()),
+      cancellable_(g_cancellable_new()) {
     storage_path_ = get_storage_path();
 }
 
-AddonService::~AddonService() = default;
+AddonService::~AddonService() {
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+}
 
 std::string AddonService::get_storage_path() {
     const char* data_dir = g_get_user_data_dir();
@@ -22,32 +33,34 @@ std::string AddonService::get_storage_path() {
     return dir + "/addons.json";
 }
 
-void AddonService::load() {
-    installed_addons_.clear();
+// Parse the saved addons; touches no service state, so it runs on a worker
+static std::vector<InstalledAddon> read_addons(const std::string& path) {
+    Madari::ProfileSpan span("load addons", "services");
+    std::vector<InstalledAddon> addons;
     
     g_autoptr(JsonParser) parser = json_parser_new();
     g_autoptr(GError) error = nullptr;
     
-    if (!json_parser_load_from_file(parser, storage_path_.c_str(), &error)) {
+    if (!json_parser_load_from_file(parser, path.c_str(), &error)) {
         // File doesn't exist or is invalid, that's fine
         g_info("No addons file found or failed to load: %s", 
                error ? error->message : "unknown error");
-        return;
+        return addons;
     }
     
     JsonNode* root = json_parser_get_root(parser);
     if (!root || json_node_get_node_type(root) != JSON_NODE_OBJECT) {
-        return;
+        return addons;
     }
     
     JsonObject* obj = json_node_get_object(root);
     if (!json_object_has_member(obj, "addons")) {
-        return;
+        return addons;
     }
     
     JsonNode* addons_node = json_object_get_member(obj, "addons");
     if (json_node_get_node_type(addons_node) != JSON_NODE_ARRAY) {
-        return;
+        return addons;
     }
     
     JsonArray* addons_array = json_node_get_array(addons_node);
@@ -102,17 +115,89 @@ void AddonService::load() {
             if (date) addon.installed_at = date;
         }
         
-        installed_addons_.push_back(addon);
+        addons.push_back(addon);
     }
     
     // Sort by order
-    std::sort(installed_addons_.begin(), installed_addons_.end(),
+    std::sort(addons.begin(), addons.end(),
               [](const InstalledAddon& a, const InstalledAddon& b) {
                   return a.order < b.order;
               });
+    return addons;
+}
+
+void AddonService::load() {
+    installed_addons_ = read_addons(storage_path_);
+    local_index_->load();
+    set_ready();
+}
+
+void AddonService::load_async() {
+    struct AddonsRead {
+        std::string path;
+        std::vector<InstalledAddon> addons;
+    };
+    
+    GTask* task = g_task_new(nullptr, cancellable_,
+        [](GObject*, GAsyncResult* result, gpointer user_data) {
+            // Cancelled when the service went away first
+            if (g_task_had_error(G_TASK(result))) return;
+            
+            auto* self = static_cast<AddonService*>(user_data);
+            auto* read = static_cast<AddonsRead*>(g_task_get_task_data(G_TASK(result)));
+            
+            // Addons installed while reading stay, after the saved ones
+            std::vector<InstalledAddon> installed = std::move(read->addons);
+            bool changed_while_loading = !self->installed_addons_.empty();
+            for (auto& addon : self->installed_addons_) {
+                auto it = std::find_if(installed.begin(), installed.end(),
+                    [&addon](const InstalledAddon& a) { return a.manifest.id == addon.manifest.id; });
+                if (it == installed.end()) {
+                    installed.push_back(std::move(addon));
+                }
+            }
+            self->installed_addons_ = std::move(installed);
+            
+            self->set_ready();
+            if (changed_while_loading) {
+                self->save();
+                self->notify_change();
+            }
+        }, this);
+    g_task_set_task_data(task, new AddonsRead{storage_path_, {}},
+                         [](gpointer d) { delete static_cast<AddonsRead*>(d); });
+    g_task_run_in_thread(task, [](GTask* task, gpointer, gpointer task_data, GCancellable*) {
+        auto* read = static_cast<AddonsRead*>(task_data);
+        read->addons = read_addons(read->path);
+        g_task_return_boolean(task, TRUE);
+    });
+    g_object_unref(task);
+    
+    // Reads on its own worker
+    local_index_->load();
+}
+
+void AddonService::when_ready(ReadyCallback callback) {
+    if (ready_) {
+        callback();
+        return;
+    }
+    ready_callbacks_.push_back(std::move(callback));
+}
+
+void AddonService::set_ready() {
+    ready_ = true;
+    auto callbacks = std::move(ready_callbacks_);
+    ready_callbacks_.clear();
+    for (const auto& callback : callbacks) {
+        callback();
+    }
 }
 
 void AddonService::save() {
+    // Until the file is read, installed_addons_ only holds what was added since
+    if (!ready_) return;
+    
     g_autoptr(JsonBuilder) builder = json_builder_new();
     
     json_builder_begin_object(builder);
@@ -494,34 +579,528 @@ void AddonService::fetch_catalog(const std::string& addon_id,
                                   const std::string& type,
                                   const std::string& catalog_id,
                                   const ExtraArgs& extra,
-                                  Client::CatalogCallback callback) {
+                                  Client::CatalogCallback callback,
+                                  const RequestOptions& options) {
+    auto addon = get_addon(addon_id);
+    if (!addon) {
+        callback(std::nullopt, "Addon not found: " + addon_id);
+        return;
+    }
+    
+    client_->fetch_catalog(addon->manifest, type, catalog_id, extra,
+        [this, callback](std::optional<CatalogResponse> response, const std::string& error) {
+            if (response) {
+                local_index_->add(response->metas);
+            }
+            callback(std::move(response), error);
+        }, options);
+}
+
+// ============= Catalog Cache =============
+
+void AddonService::fetch_catalog_cached(const std::string& addon_id,
+                                         const std::string& type,
+                                         const std::string& catalog_id,
+                                         const ExtraArgs& extra,
+                                         CachedCatalogCallback callback,
+                                         const RequestOptions& options) {
+    auto addon = get_addon(addon_id);
+    if (!addon) {
+        callback(std::nullopt, "Addon not found: " + addon_id, false);
+        return;
+    }
+    
+    std::string key = CatalogCache::make_key(addon_id, type, catalog_id, extra);
+    Manifest manifest = addon->manifest;
+    
+    catalog_cache_->lookup(key, [this, manifest, type, catalog_id, extra, key, callback, options]
+                                (std::optional<CachedCatalog> cached) {
+        if (cached) {
+            callback(cached->response, "", true);
+            if (cached->is_fresh()) return;
+        }
+        
+        std::optional<size_t> cached_hash;
+        if (cached) cached_hash = cached->body_hash;
+        
+        // Revalidation is background work, a cold fetch is what the user waits on
+        RequestOptions request = options;
+        if (cached) request.priority = G_PRIORITY_LOW;
+        
+        client_->fetch_catalog_body(manifest, type, catalog_id, extra,
+            [this, key, callback, cached_hash](const std::string& body, const std::string& error) {
+                std::optional<CatalogResponse> response;
+                if (error.empty()) response = Parser::parse_catalog(body);
+                
+                if (!response) {
+                    if (!cached_hash) {
+                        callback(std::nullopt, error.empty() ? "Failed to parse catalog response" : error, false);
+                    }
+                    return;
+                }
+                
+                catalog_cache_->store(key, *response, body);
+                local_index_->add(response->metas);
+                if (!cached_hash || *cached_hash != std::hash<std::string>{}(body)) {
+                    callback(std::move(response), "", false);
+                }
+            }, request);
+    });
+}
+
+void AddonService::revalidate_catalog(const std::string& addon_id,
+                                       const std::string& type,
+                                       const std::string& catalog_id,
+                                       const ExtraArgs& extra,
+                                       RevalidateCallback callback,
+                                       const RequestOptions& options) {
     auto addon = get_addon(addon_id);
     if (!addon) {
         callback(std::nullopt, "Addon not found: " + addon_id);
         return;
     }
     
-    client_->fetch_catalog(addon->manifest, type, catalog_id, extra, callback);
+    std::string key = CatalogCache::make_key(addon_id, type, catalog_id, extra);
+    Manifest manifest = addon->manifest;
+    
+    catalog_cache_->lookup(key, [this, manifest, type, catalog_id, extra, key, callback, options]
+                                (std::optional<CachedCatalog> cached) {
+        if (cached && cached->is_fresh()) {
+            callback(std::nullopt, "");
+            return;
+        }
+        
+        std::optional<size_t> cached_hash;
+        if (cached) cached_hash = cached->body_hash;
+        
+        client_->fetch_catalog_body(manifest, type, catalog_id, extra,
+            [this, key, callback, cached_hash](const std::string& body, const std::string& error) {
+                std::optional<CatalogResponse> response;
+                if (error.empty()) response = Parser::parse_catalog(body);
+                if (!response) {
+                    callback(std::nullopt, error.empty() ? "Failed to parse catalog response" : error);
+                    return;
+                }
+                
+                catalog_cache_->store(key, *response, body);
+                local_index_->add(response->metas);
+                if (cached_hash && *cached_hash == std::hash<std::string>{}(body)) {
+                    response.reset();
+                }
+                callback(std::move(response), "");
+            }, options);
+    });
+}
+
+void AddonService::prefetch_catalog(const std::string& addon_id,
+                                     const std::string& type,
+                                     const std::string& catalog_id,
+                                     const ExtraArgs& extra,
+                                     const RequestOptions& options) {
+    // The cache makes repeats cheap: a fresh page costs a lookup, a stale
+    // one a single low priority revalidation
+    RequestOptions request = options;
+    request.priority = G_PRIORITY_LOW;
+    revalidate_catalog(addon_id, type, catalog_id, extra,
+        [](std::optional<CatalogResponse>, const std::string&) {}, request);
+}
+
+size_t AddonService::trim_memory() {
+    size_t released = meta_cache_->memory_bytes() + catalog_cache_->memory_bytes();
+    meta_cache_->clear_memory();
+    catalog_cache_->clear_memory();
+    search_cache_.clear();
+    return released;
+}
+
+// ============= Meta Fan-out =============
+
+namespace {
+
+/**
+ * An addon's answer held back while addons installed above it may still
+ * answer
+ */
+struct HeldMeta {
+    Manifest addon;
+    std::string body;
+    MetaResponse response;
+};
+
+/**
+ * Shared state of one fan-out: a cancellable per addon request, so slow
+ * addons can be timed out and losers dropped individually
+ */
+struct MetaFanoutState {
+    std::vector<GCancellable*> cancellables;
+    std::vector<bool> finished;               // Per addon, in install order
+    std::vector<std::optional<HeldMeta>> held;
+    int pending = 0;
+    bool stopped = false;         // A handler asked for no more responses
+    bool answered = false;        // At least one addon returned a meta
+    bool grace_over = false;      // Held answers no longer wait for higher addons
+    bool grace_started = false;
+    std::string errors;
+    GCancellable* external = nullptr;
+    gulong external_handler = 0;
+    
+    void cancel_all() {
+        for (GCancellable* cancellable : cancellables) {
+            g_cancellable_cancel(cancellable);
+        }
+    }
+    
+    ~MetaFanoutState() {
+        if (external_handler) {
+            g_cancellable_disconnect(external, external_handler);
+        }
+        for (GCancellable* cancellable : cancellables) {
+            g_object_unref(cancellable);
+        }
+    }
+};
+
+// Same as AddonService::MetaResponseHandler
+using HeldMetaHandler = std::function<bool(const Manifest& addon, const std::string& body, MetaResponse response)>;
+
+// Hand held answers to the handler in install order, stopping at the first
+// addon still out unless the grace period is over
+void deliver_held_metas(const std::shared_ptr<MetaFanoutState>& state, const HeldMetaHandler& on_response) {
+    for (size_t i = 0; i < state->held.size() && !state->stopped; i++) {
+        if (!state->finished[i] && !state->grace_over) break;
+        if (!state->held[i]) continue;
+        
+        HeldMeta meta = std::move(*state->held[i]);
+        state->held[i].reset();
+        if (!on_response(meta.addon, meta.body, std::move(meta.response))) {
+            state->stopped = true;
+            state->cancel_all();
+        }
+    }
+}
+
+template <typename T>
+bool fill_missing(std::optional<T>& base, const std::optional<T>& other) {
+    if (base.has_value() || !other.has_value()) return false;
+    base = other;
+    return true;
+}
+
+template <typename T>
+bool fill_missing(std::vector<T>& base, const std::vector<T>& other) {
+    if (!base.empty() || other.empty()) return false;
+    base = other;
+    return true;
+}
+
+// Copy fields base lacks from other; true if anything was added
+bool merge_missing_fields(Meta& base, const Meta& other) {
+    bool changed = false;
+    changed |= fill_missing(base.poster, other.poster);
+    changed |= fill_missing(base.background, other.background);
+    changed |= fill_missing(base.logo, other.logo);
+    changed |= fill_missing(base.description, other.description);
+    changed |= fill_missing(base.release_info, other.release_info);
+    changed |= fill_missing(base.imdb_rating, other.imdb_rating);
+    changed |= fill_missing(base.released, other.released);
+    changed |= fill_missing(base.runtime, other.runtime);
+    changed |= fill_missing(base.genres, other.genres);
+    changed |= fill_missing(base.director, other.director);
+    changed |= fill_missing(base.cast, other.cast);
+    changed |= fill_missing(base.writer, other.writer);
+    changed |= fill_missing(base.links, other.links);
+    changed |= fill_missing(base.trailers, other.trailers);
+    if (!base.has_videos() && other.has_videos()) {
+        base.videos = other.videos;
+        changed = true;
+    }
+    return changed;
+}
+
+// Keeps a fan-out alive until its grace period ends
+struct MetaGrace {
+    std::shared_ptr<MetaFanoutState> state;
+    HeldMetaHandler on_response;
+    GCancellable* service;      // Cancelled when the service goes away
+    
+    ~MetaGrace() {
+        g_object_unref(service);
+    }
+};
+
+} // namespace
+
+void AddonService::fan_out_meta(const std::string& type,
+                                 const std::string& id,
+                                 const std::vector<InstalledAddon>& addons,
+                                 const MetaFanoutOptions& options,
+                                 MetaResponseHandler on_response,
+                                 std::function<void(bool answered, const std::string& errors)> on_done) {
+    auto state = std::make_shared<MetaFanoutState>();
+    state->pending = static_cast<int>(addons.size());
+    state->finished.resize(addons.size(), false);
+    state->held.resize(addons.size());
+    state->grace_over = options.priority_grace_ms == 0;
+    
+    for (size_t i = 0; i < addons.size(); i++) {
+        GCancellable* cancellable = g_cancellable_new();
+        state->cancellables.push_back(cancellable);
+        
+        // Latency cap: a slow addon is cancelled and counts as failed
+        if (options.addon_timeout_ms > 0) {
+            g_timeout_add_full(G_PRIORITY_DEFAULT, options.addon_timeout_ms, [](gpointer data) -> gboolean {
+                g_cancellable_cancel(G_CANCELLABLE(data));
+                return G_SOURCE_REMOVE;
+            }, g_object_ref(cancellable), g_object_unref);
+        }
+    }
+    
+    if (options.cancellable) {
+        state->external = options.cancellable;
+        state->external_handler = g_cancellable_connect(options.cancellable,
+            G_CALLBACK(+[](GCancellable*, gpointer data) {
+                static_cast<MetaFanoutState*>(data)->cancel_all();
+            }), state.get(), nullptr);
+    }
+    
+    for (size_t i = 0; i < addons.size(); i++) {
+        RequestOptions request;
+        request.priority = options.priority;
+        request.cancellable = state->cancellables[i];
+        
+        client_->fetch_meta_body(addons[i].manifest, type, id,
+            [this, state, i, grace_ms = options.priority_grace_ms, on_response, on_done, manifest = addons[i].manifest]
+            (const std::string& body, const std::string& error) {
+                std::optional<MetaResponse> response;
+                if (error.empty()) {
+                    response = Parser::parse_meta(body);
+                }
+                
+                state->finished[i] = true;
+                if (response && !state->stopped) {
+                    state->answered = true;
+                    state->held[i] = HeldMeta{manifest, body, std::move(*response)};
+                } else if (!response && !state->stopped) {
+                    if (!state->errors.empty()) state->errors += "; ";
+                    state->errors += manifest.name + ": " + (error.empty() ? "Failed to parse meta response" : error);
+                }
+                
+                // Everyone is in once nothing is pending, so whatever is held goes out
+                if (--state->pending == 0) {
+                    state->grace_over = true;
+                }
+                deliver_held_metas(state, on_response);
+                
+                // A lower addon answered first; give the ones above it a moment
+                if (state->held[i] && !state->grace_over && !state->grace_started) {
+                    state->grace_started = true;
+                    g_timeout_add_full(G_PRIORITY_DEFAULT, grace_ms, [](gpointer data) -> gboolean {
+                        auto *grace = static_cast<MetaGrace*>(data);
+                        if (g_cancellable_is_cancelled(grace->service)) return G_SOURCE_REMOVE;
+                        grace->state->grace_over = true;
+                        deliver_held_metas(grace->state, grace->on_response);
+                        return G_SOURCE_REMOVE;
+                    }, new MetaGrace{state, on_response, G_CANCELLABLE(g_object_ref(cancellable_))},
+                    [](gpointer data) {
+                        delete static_cast<MetaGrace*>(data);
+                    });
+                }
+                
+                if (state->pending == 0) {
+                    on_done(state->answered, state->errors);
+                }
+            }, request);
+    }
+}
+
+void AddonService::fetch_meta_fanout(const std::string& type,
+                                      const std::string& id,
+                                      const MetaFanoutOptions& options,
+                                      MetaFanoutCallback callback) {
+    auto addons = get_addons_for_resource("meta", type, id);
+    
+    if (addons.empty()) {
+        callback(std::nullopt, "No addon supports meta for type: " + type, true);
+        return;
+    }
+    
+    if (options.mode == MetaFanoutMode::FirstSuccess) {
+        fan_out_meta(type, id, addons, options,
+            [callback](const Manifest&, const std::string&, MetaResponse response) {
+                callback(std::move(response), "", true);
+                return false;
+            },
+            [callback](bool answered, const std::string& errors) {
+                if (!answered) callback(std::nullopt, errors, true);
+            });
+        return;
+    }
+    
+    // Merge: the first answer is the base, later ones fill in what it lacks
+    auto merged = std::make_shared<std::optional<MetaResponse>>();
+    fan_out_meta(type, id, addons, options,
+        [callback, merged](const Manifest&, const std::string&, MetaResponse response) {
+            if (!*merged) {
+                *merged = std::move(response);
+                callback(*merged, "", false);
+            } else if (merge_missing_fields((*merged)->meta, response.meta)) {
+                callback(*merged, "", false);
+            }
+            return true;
+        },
+        [callback, merged](bool answered, const std::string& errors) {
+            if (answered) {
+                callback(*merged, "", true);
+            } else {
+                callback(std::nullopt, errors, true);
+            }
+        });
 }
 
 void AddonService::fetch_meta(const std::string& type,
                                const std::string& id,
                                Client::MetaCallback callback) {
+    // One failing or slow addon no longer hides metadata that others serve
+    fetch_meta_fanout(type, id, MetaFanoutOptions{},
+        [callback](std::optional<MetaResponse> response, const std::string& error, bool) {
+            callback(std::move(response), error);
+        });
+}
+
+void AddonService::fetch_meta_cached(const std::string& type,
+                                      const std::string& id,
+                                      CachedMetaCallback callback,
+                                      MetaFanoutMode mode) {
     auto addons = get_addons_for_resource("meta", type, id);
     
     if (addons.empty()) {
-        callback(std::nullopt, "No addon supports meta for type: " + type);
+        callback(std::nullopt, "No addon supports meta for type: " + type, false);
+        return;
+    }
+    
+    // A prefetch of the same item is already on the wire; pick up its result
+    auto prefetch = meta_prefetches_.find(type + "/" + id);
+    if (prefetch != meta_prefetches_.end()) {
+        prefetch->second.push_back([this, type, id, callback, mode]() {
+            fetch_meta_cached(type, id, callback, mode);
+        });
         return;
     }
     
-    // Try first matching addon
-    client_->fetch_meta(addons[0].manifest, type, id, callback);
+    meta_cache_->lookup(type, id, [this, addons, type, id, callback, mode](std::optional<CachedMeta> cached) {
+        if (cached) {
+            callback(MetaResponse{cached->meta, std::nullopt}, "", true);
+            if (cached->is_fresh() && serves_meta(addons, cached->addon_id)) {
+                return;
+            }
+        }
+        
+        // Revalidation is background work, a cold fetch is what the user waits on
+        MetaFanoutOptions options;
+        options.priority = cached ? G_PRIORITY_LOW : G_PRIORITY_DEFAULT;
+        
+        std::optional<size_t> cached_hash;
+        if (cached) cached_hash = cached->body_hash;
+        
+        // The first answer, and with Merge what later ones filled in
+        struct Base {
+            std::string addon_id;
+            std::string body;
+            std::optional<MetaResponse> response;
+        };
+        auto base = std::make_shared<Base>();
+        
+        fan_out_meta(type, id, addons, options,
+            [this, type, id, callback, cached_hash, mode, base](const Manifest& addon, const std::string& body,
+                                                                MetaResponse response) {
+                if (base->response) {
+                    if (merge_missing_fields(base->response->meta, response.meta)) {
+                        meta_cache_->store(type, id, base->addon_id, *base->response, base->body);
+                        callback(*base->response, "", false);
+                    }
+                    return true;
+                }
+                
+                meta_cache_->store(type, id, addon.id, response, body);
+                bool changed = !cached_hash || *cached_hash != std::hash<std::string>{}(body);
+                if (mode == MetaFanoutMode::FirstSuccess) {
+                    if (changed) callback(std::move(response), "", false);
+                    return false;
+                }
+                
+                base->addon_id = addon.id;
+                base->body = body;
+                base->response = std::move(response);
+                if (changed) callback(*base->response, "", false);
+                return true;
+            },
+            [callback, cached_hash](bool answered, const std::string& errors) {
+                if (!answered && !cached_hash) callback(std::nullopt, errors, false);
+            });
+    });
+}
+
+void AddonService::prefetch_meta(const std::string& type,
+                                  const std::string& id,
+                                  std::function<void(const Meta&)> done,
+                                  const RequestOptions& options) {
+    std::string key = type + "/" + id;
+    if (meta_prefetches_.count(key)) return;
+    
+    auto addons = get_addons_for_resource("meta", type, id);
+    if (addons.empty()) return;
+    
+    meta_prefetches_[key];
+    
+    meta_cache_->lookup(type, id, [this, addons, type, id, key, done, options](std::optional<CachedMeta> cached) {
+        if (cached && cached->is_fresh() && serves_meta(addons, cached->addon_id)) {
+            finish_meta_prefetch(key);
+            if (done) done(cached->meta);
+            return;
+        }
+        
+        MetaFanoutOptions fanout;
+        fanout.priority = G_PRIORITY_LOW;
+        fanout.cancellable = options.cancellable;
+        
+        auto fetched = std::make_shared<std::optional<Meta>>();
+        fan_out_meta(type, id, addons, fanout,
+            [this, type, id, fetched](const Manifest& addon, const std::string& body, MetaResponse response) {
+                meta_cache_->store(type, id, addon.id, response, body);
+                *fetched = std::move(response.meta);
+                return false;
+            },
+            [this, key, done, fetched](bool, const std::string&) {
+                // Waiters re-run their fetch: a memory hit now, or a normal
+                // request if the prefetch failed or was cancelled
+                finish_meta_prefetch(key);
+                if (*fetched && done) done(**fetched);
+            });
+    });
+}
+
+bool AddonService::serves_meta(const std::vector<InstalledAddon>& addons, const std::string& addon_id) {
+    return std::any_of(addons.begin(), addons.end(), [&addon_id](const InstalledAddon& addon) {
+        return addon.manifest.id == addon_id;
+    });
+}
+
+void AddonService::finish_meta_prefetch(const std::string& key) {
+    auto it = meta_prefetches_.find(key);
+    if (it == meta_prefetches_.end()) return;
+    
+    auto waiters = std::move(it->second);
+    meta_prefetches_.erase(it);
+    for (auto& waiter : waiters) {
+        waiter();
+    }
 }
 
 void AddonService::fetch_all_streams(const std::string& type,
                                       const std::string& video_id,
                                       std::function<void(const Manifest&, const std::vector<Stream>&)> callback,
-                                      std::function<void()> done_callback) {
+                                      std::function<void()> done_callback,
+                                      const RequestOptions& options) {
     auto addons = get_addons_for_resource("stream", type, video_id);
     
     if (addons.empty()) {
@@ -544,10 +1123,17 @@ void AddonService::fetch_all_streams(const std::string& type,
                 if (*pending == 0) {
                     done_callback();
                 }
-            });
+            }, options);
     }
 }
 
+void AddonService::probe_streams(const std::vector<Stream>& streams,
+                                  const ProbeOptions& options,
+                                  StreamProbe::ResultCallback on_result,
+                                  StreamProbe::DoneCallback done_callback) {
+    probe_->probe(streams, options, std::move(on_result), std::move(done_callback));
+}
+
 void AddonService::fetch_all_subtitles(const std::string& type,
                                         const std::string& id,
                                         const std::string& video_id,
@@ -608,51 +1194,171 @@ std::vector<std::pair<Manifest, CatalogDefinition>> AddonService::get_searchable
 
 void AddonService::search(const std::string& query,
                           std::function<void(const Manifest&, const CatalogDefinition&, const std::vector<MetaPreview>&)> callback,
-                          std::function<void()> done_callback) {
+                          std::function<void()> done_callback,
+                          const RequestOptions& options) {
     auto catalogs = get_searchable_catalogs();
     
-    g_print("[SEARCH] Searching for '%s' across %zu catalogs\n", query.c_str(), catalogs.size());
-    
     if (catalogs.empty()) {
-        g_print("[SEARCH] No searchable catalogs found\n");
+        MADARI_LOG_DEBUG("search", "no searchable catalogs", {"query", query});
         done_callback();
         return;
     }
     
-    for (const auto& [manifest, catalog] : catalogs) {
-        g_print("[SEARCH] Searchable catalog: %s/%s from addon %s\n", 
-                catalog.type.c_str(), catalog.id.c_str(), manifest.name.c_str());
-    }
-    
     auto pending = std::make_shared<int>(static_cast<int>(catalogs.size()));
+    MADARI_LOG_DEBUG("search", "query", {"query", query}, {"catalogs", catalogs.size()});
     
     for (const auto& [manifest, catalog] : catalogs) {
         ExtraArgs extra;
         extra.search = query;
         
         client_->fetch_catalog(manifest, catalog.type, catalog.id, extra,
-            [callback, done_callback, pending, manifest, catalog, query]
+            [this, callback, done_callback, pending, manifest, catalog]
             (std::optional<CatalogResponse> response, const std::string& error) {
                 if (!error.empty()) {
-                    g_print("[SEARCH] Error from %s/%s: %s\n", 
-                            manifest.name.c_str(), catalog.id.c_str(), error.c_str());
+                    MADARI_LOG_DEBUG("search", "catalog failed", {"addon", manifest.id},
+                                     {"catalog", catalog.id}, {"error", error});
+                } else {
+                    MADARI_LOG_TRACE("search", "catalog answered", {"addon", manifest.id},
+                                     {"catalog", catalog.id},
+                                     {"results", response ? response->metas.size() : 0});
                 }
                 
                 if (response && !response->metas.empty()) {
-                    g_print("[SEARCH] Got %zu results from %s/%s\n", 
-                            response->metas.size(), manifest.name.c_str(), catalog.id.c_str());
+                    local_index_->add(response->metas);
                     callback(manifest, catalog, response->metas);
-                } else {
-                    g_print("[SEARCH] No results from %s/%s\n", 
-                            manifest.name.c_str(), catalog.id.c_str());
                 }
                 
                 (*pending)--;
                 if (*pending == 0) {
                     done_callback();
                 }
-            });
+            }, options);
+    }
+}
+
+// ============= Search Cache =============
+
+// Long enough for backspacing and retyping, short enough not to hide new releases
+static const gint64 SEARCH_CACHE_TTL_US = 2 * 60 * G_USEC_PER_SEC;
+static const size_t SEARCH_CACHE_MAX = 32;
+
+// Prefix hits must still match every word of the longer query
+static const double PREFIX_MATCH_MIN = 0.7;
+
+static std::string search_cache_key(const std::string& query) {
+    g_autofree gchar* folded = g_utf8_casefold(query.c_str(), -1);
+    g_autofree gchar* stripped = g_strstrip(g_strdup(folded));
+    return stripped;
+}
+
+void AddonService::remember_search(const std::string& key, const SearchAggregator& aggregator, bool complete) {
+    gint64 now = g_get_monotonic_time();
+    
+    for (auto it = search_cache_.begin(); it != search_cache_.end();) {
+        if (now - it->second.stored_at > SEARCH_CACHE_TTL_US) {
+            it = search_cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (search_cache_.size() >= SEARCH_CACHE_MAX && !search_cache_.count(key)) {
+        auto oldest = std::min_element(search_cache_.begin(), search_cache_.end(),
+            [](const auto& a, const auto& b) { return a.second.stored_at < b.second.stored_at; });
+        search_cache_.erase(oldest);
     }
+    
+    SearchCacheEntry& entry = search_cache_[key];
+    entry.results.clear();
+    for (const SearchResult* result : aggregator.ranked()) {
+        entry.results.push_back(*result);
+    }
+    entry.stored_at = now;
+    entry.complete = complete;
+}
+
+void AddonService::search_ranked(const std::string& query,
+                                 std::function<void(const std::vector<const SearchResult*>&)> on_update,
+                                 std::function<void()> done_callback,
+                                 const RequestOptions& options) {
+    std::string key = search_cache_key(query);
+    gint64 now = g_get_monotonic_time();
+    
+    // Same query answered moments ago
+    auto exact = search_cache_.find(key);
+    if (exact != search_cache_.end() && exact->second.complete &&
+        now - exact->second.stored_at <= SEARCH_CACHE_TTL_US) {
+        std::vector<const SearchResult*> ranked;
+        for (const auto& result : exact->second.results) {
+            ranked.push_back(&result);
+        }
+        if (!ranked.empty()) on_update(ranked);
+        done_callback();
+        return;
+    }
+    
+    // Install order is the user's priority order
+    std::vector<std::string> addon_order;
+    for (const auto& addon : installed_addons_) {
+        if (addon.enabled) addon_order.push_back(addon.manifest.id);
+    }
+    
+    auto aggregator = std::make_shared<SearchAggregator>(query, std::move(addon_order));
+    
+    // Items seen before answer first, and are all there is when offline
+    std::vector<SearchResult> local;
+    for (auto& meta : local_index_->search(query)) {
+        SearchResult hit;
+        hit.meta = std::move(meta);
+        local.push_back(std::move(hit));
+    }
+    if (aggregator->seed(local)) {
+        on_update(aggregator->ranked());
+    }
+    
+    // Then the longest recent prefix query's hits that still match
+    const SearchCacheEntry* prefix = nullptr;
+    size_t prefix_length = 0;
+    for (const auto& [cached_key, entry] : search_cache_) {
+        if (cached_key.size() < key.size() && cached_key.size() > prefix_length &&
+            key.compare(0, cached_key.size(), cached_key) == 0 &&
+            now - entry.stored_at <= SEARCH_CACHE_TTL_US) {
+            prefix = &entry;
+            prefix_length = cached_key.size();
+        }
+    }
+    if (prefix) {
+        std::vector<SearchResult> matching;
+        for (const auto& result : prefix->results) {
+            if (SearchAggregator::title_score(query, result.meta.name) >= PREFIX_MATCH_MIN) {
+                matching.push_back(result);
+            }
+        }
+        if (aggregator->seed(matching)) {
+            on_update(aggregator->ranked());
+        }
+    }
+    
+    // A cancelled search is incomplete and must not be cached as an answer
+    std::shared_ptr<GCancellable> cancellable;
+    if (options.cancellable) {
+        cancellable.reset(G_CANCELLABLE(g_object_ref(options.cancellable)), g_object_unref);
+    }
+    
+    search(query,
+        [this, key, aggregator, on_update](const Manifest& addon, const CatalogDefinition&,
+                                           const std::vector<MetaPreview>& results) {
+            if (aggregator->add_batch(addon, results)) {
+                remember_search(key, *aggregator, false);
+                on_update(aggregator->ranked());
+            }
+        },
+        [this, key, aggregator, done_callback, cancellable]() {
+            if (!cancellable || !g_cancellable_is_cancelled(cancellable.get())) {
+                remember_search(key, *aggregator, true);
+            }
+            done_callback();
+        },
+        options);
 }
 
 } // namespace Stremio
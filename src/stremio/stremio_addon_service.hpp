@@ -2,6 +2,11 @@
 
 #include "stremio_types.hpp"
 #include "stremio_client.hpp"
+#include "stremio_stream_probe.hpp"
+#include "stremio_meta_cache.hpp"
+#include "stremio_search_aggregator.hpp"
+#include "stremio_local_index.hpp"
+#include "stremio_catalog_cache.hpp"
 #include <functional>
 #include <memory>
 #include <string>
@@ -20,6 +25,25 @@ struct InstalledAddon {
     std::string installed_at; // ISO 8601 date
 };
 
+/**
+ * How fetch_meta_fanout combines answers from several meta addons
+ */
+enum class MetaFanoutMode {
+    FirstSuccess,   // First complete meta wins, the other requests are cancelled
+    Merge,          // First meta is the base; later ones fill in fields it lacks
+};
+
+/**
+ * Options for querying all eligible meta addons concurrently
+ */
+struct MetaFanoutOptions {
+    MetaFanoutMode mode = MetaFanoutMode::FirstSuccess;
+    guint addon_timeout_ms = 8000;          // Per-addon latency cap, 0 for none
+    guint priority_grace_ms = 300;          // How long an answer waits for addons installed above it
+    int priority = G_PRIORITY_DEFAULT;
+    GCancellable* cancellable = nullptr;    // Cancels every request (not owned)
+};
+
 /**
  * Service for managing Stremio addons
  * Handles addon installation, removal, and data persistence
@@ -27,8 +51,16 @@ struct InstalledAddon {
 class AddonService {
 public:
     using AddonsChangedCallback = std::function<void()>;
+    using ReadyCallback = std::function<void()>;
     using InstallCallback = std::function<void(bool success, const std::string& error)>;
     using ErrorCallback = std::function<void(const std::string& error)>;
+    using CachedMetaCallback = std::function<void(std::optional<MetaResponse>, const std::string& error,
+                                                  bool from_cache)>;
+    using CachedCatalogCallback = std::function<void(std::optional<CatalogResponse>, const std::string& error,
+                                                     bool from_cache)>;
+    using RevalidateCallback = std::function<void(std::optional<CatalogResponse> changed, const std::string& error)>;
+    using MetaFanoutCallback = std::function<void(std::optional<MetaResponse>, const std::string& error,
+                                                  bool final)>;
     
     AddonService();
     ~AddonService();
@@ -38,6 +70,23 @@ public:
      */
     void load();
     
+    /**
+     * Load installed addons on a worker thread. Until ready the service
+     * has no addons; addons installed meanwhile are kept.
+     */
+    void load_async();
+    
+    /**
+     * Whether the installed addons have been loaded
+     */
+    bool is_ready() const { return ready_; }
+    
+    /**
+     * Run a callback once the installed addons are loaded (right away if
+     * they are)
+     */
+    void when_ready(ReadyCallback callback);
+    
     /**
      * Save installed addons to storage
      */
@@ -109,26 +158,150 @@ public:
                        const std::string& type,
                        const std::string& catalog_id,
                        const ExtraArgs& extra,
-                       Client::CatalogCallback callback);
+                       Client::CatalogCallback callback,
+                       const RequestOptions& options = {});
     
     /**
-     * Fetch metadata from first matching addon
+     * Fetch a catalog page through the catalog cache (stale-while-revalidate).
+     * A cached page is delivered first (from_cache = true); if it was stale
+     * or there was none, the addon is asked and callback runs again only if
+     * the page changed. Errors are only reported when nothing was cached.
+     */
+    void fetch_catalog_cached(const std::string& addon_id,
+                              const std::string& type,
+                              const std::string& catalog_id,
+                              const ExtraArgs& extra,
+                              CachedCatalogCallback callback,
+                              const RequestOptions& options = {});
+    
+    /**
+     * Refetch a catalog page unless its cached copy is still fresh. Calls
+     * back exactly once: with the new page if it differs from the cached
+     * one, with nullopt if it was fresh or unchanged, or with an error.
+     */
+    void revalidate_catalog(const std::string& addon_id,
+                            const std::string& type,
+                            const std::string& catalog_id,
+                            const ExtraArgs& extra,
+                            RevalidateCallback callback,
+                            const RequestOptions& options = {});
+    
+    /**
+     * Warm the catalog cache for a page the user is likely to open next
+     * @param options Cancellation; the request always runs at low priority
+     */
+    void prefetch_catalog(const std::string& addon_id,
+                          const std::string& type,
+                          const std::string& catalog_id,
+                          const ExtraArgs& extra,
+                          const RequestOptions& options = {});
+    
+    /**
+     * Fetch metadata from whichever matching addon answers first
      */
     void fetch_meta(const std::string& type,
                     const std::string& id,
                     Client::MetaCallback callback);
     
+    /**
+     * Query every addon serving meta for the id concurrently. Answers are
+     * taken in install order: one from a lower addon is held for
+     * options.priority_grace_ms while higher ones are still out, so a slow
+     * preferred addon costs at most the grace period, and past it the
+     * fastest answer wins.
+     * FirstSuccess calls back once, with that answer. Merge calls back on
+     * the first answer and whenever a later one adds missing fields
+     * (videos, background, logo, cast, ...), then once more with
+     * final = true when all addons are done.
+     * Errors are only reported, with final = true, if no addon answered.
+     */
+    void fetch_meta_fanout(const std::string& type,
+                           const std::string& id,
+                           const MetaFanoutOptions& options,
+                           MetaFanoutCallback callback);
+    
+    /**
+     * Fetch metadata through the meta cache (stale-while-revalidate).
+     * A cached copy is delivered first (from_cache = true); if it was stale,
+     * came from another addon or there was none, the addon is asked again in
+     * the background and callback runs a second time if the meta changed.
+     * With MetaFanoutMode::Merge it runs again whenever a lower addon fills
+     * in fields the first answer lacked; the merged meta replaces the
+     * memory copy, while disk keeps the first addon's response.
+     * Network errors are only reported when nothing was cached.
+     */
+    void fetch_meta_cached(const std::string& type,
+                           const std::string& id,
+                           CachedMetaCallback callback,
+                           MetaFanoutMode mode = MetaFanoutMode::FirstSuccess);
+    
+    /**
+     * Warm the meta cache for an item the user is likely to open. Skipped if
+     * the same prefetch is running; does no network request if a fresh copy
+     * is cached. A fetch_meta_cached for the item meanwhile waits for it
+     * instead of issuing a second request.
+     * @param done Called with the meta once cached, not called on failure
+     * @param options Cancellation; the request always runs at low priority
+     */
+    void prefetch_meta(const std::string& type,
+                       const std::string& id,
+                       std::function<void(const Meta& meta)> done,
+                       const RequestOptions& options = {});
+    
+    /**
+     * The meta cache, e.g. to set per-addon TTLs or drop the memory tier
+     */
+    MetaCache& meta_cache() { return *meta_cache_; }
+    
+    /**
+     * Index of every catalog item seen, fed by catalog and search responses
+     */
+    LocalIndex& local_index() { return *local_index_; }
+    
+    /**
+     * The catalog page cache, e.g. to drop the memory tier
+     */
+    CatalogCache& catalog_cache() { return *catalog_cache_; }
+    
+    /**
+     * Addon requests on the wire, for diagnostics
+     */
+    size_t requests_in_flight() const { return client_->in_flight(); }
+    
+    /**
+     * Drop the parsed responses held in memory (meta and catalog cache
+     * memory tiers, recent searches); disk tiers are kept, so they come
+     * back cheaply. For low-memory warnings.
+     * @return Approximate bytes released
+     */
+    size_t trim_memory();
+    
     /**
      * Fetch streams from all matching addons
      * @param type Content type
      * @param video_id Video ID
      * @param callback Called for each addon's streams
      * @param done_callback Called when all addons have responded
+     * @param options Priority and cancellation, e.g. for speculative prefetch
      */
     void fetch_all_streams(const std::string& type,
                            const std::string& video_id,
                            std::function<void(const Manifest& addon, const std::vector<Stream>& streams)> callback,
-                           std::function<void()> done_callback);
+                           std::function<void()> done_callback,
+                           const RequestOptions& options = {});
+    
+    /**
+     * Measure how fast the first HTTP streams of a list respond, typically
+     * run on the result of fetch_all_streams
+     * @param streams Streams in their current order
+     * @param options Number of streams, range size and deadline
+     * @param on_result Called as each probe finishes
+     * @param done_callback Called with all results, fastest first
+     */
+    void probe_streams(const std::vector<Stream>& streams,
+                       const ProbeOptions& options,
+                       StreamProbe::ResultCallback on_result,
+                       StreamProbe::DoneCallback done_callback);
     
     /**
      * Fetch subtitles from all matching addons
@@ -145,29 +318,85 @@ public:
      * @param query Search query
      * @param callback Called for each addon's search results
      * @param done_callback Called when all addons have responded
+     * @param options Priority and cancellable shared by every catalog request
      */
     void search(const std::string& query,
                 std::function<void(const Manifest& addon, const CatalogDefinition& catalog, const std::vector<MetaPreview>& results)> callback,
-                std::function<void()> done_callback);
+                std::function<void()> done_callback,
+                const RequestOptions& options = {});
+    
+    /**
+     * Search across all addons and merge the results into one deduplicated,
+     * ranked list (see SearchAggregator).
+     *
+     * A query answered in the last couple of minutes is served from memory
+     * without any request. Otherwise hits from the local index and results
+     * of the longest recent prefix query that still match are published
+     * first, so typing "breaking b" shows the matching hits of "breaking"
+     * while the addons are asked, and search still finds items offline.
+     *
+     * @param on_update Called with the whole ranked list each time it changes
+     * @param done_callback Called when all addons have responded or the
+     *                      search was cancelled through options.cancellable
+     */
+    void search_ranked(const std::string& query,
+                       std::function<void(const std::vector<const SearchResult*>& results)> on_update,
+                       std::function<void()> done_callback,
+                       const RequestOptions& options = {});
     
     /**
      * Get catalogs that support search
      */
     std::vector<std::pair<Manifest, CatalogDefinition>> get_searchable_catalogs() const;
+    
+    /**
+     * Get enabled addons that serve a resource for a type, and for an id
+     * if one is given (by its id prefixes), in addon order
+     */
+    std::vector<InstalledAddon> get_addons_for_resource(const std::string& resource,
+                                                         const std::string& type,
+                                                         const std::string& id = "") const;
 
 private:
     std::vector<InstalledAddon> installed_addons_;
     std::unique_ptr<Client> client_;
+    std::unique_ptr<StreamProbe> probe_;
+    std::unique_ptr<MetaCache> meta_cache_;
+    std::unique_ptr<LocalIndex> local_index_;
+    std::unique_ptr<CatalogCache> catalog_cache_;
+    // Running meta prefetches by "type/id", with fetches waiting on them
+    std::map<std::string, std::vector<std::function<void()>>> meta_prefetches_;
     std::vector<AddonsChangedCallback> change_callbacks_;
+    std::vector<ReadyCallback> ready_callbacks_;
     std::string storage_path_;
+    GCancellable* cancellable_;
+    bool ready_ = false;
     
     void notify_change();
-    std::string get_storage_path();
+    void set_ready();
+    void finish_meta_prefetch(const std::string& key);
     
-    // Get addons that support a specific resource and type
-    std::vector<InstalledAddon> get_addons_for_resource(const std::string& resource,
-                                                         const std::string& type,
-                                                         const std::string& id = "") const;
+    // Recent search results by normalized query, for repeats and prefix reuse
+    struct SearchCacheEntry {
+        std::vector<SearchResult> results;
+        gint64 stored_at = 0;       // Monotonic, microseconds
+        bool complete = false;      // Every catalog answered
+    };
+    std::map<std::string, SearchCacheEntry> search_cache_;
+    void remember_search(const std::string& key, const SearchAggregator& aggregator, bool complete);
+    
+    // Called per successful addon response, in install order unless the
+    // grace period ran out; return false to cancel the rest
+    using MetaResponseHandler = std::function<bool(const Manifest& addon, const std::string& body,
+                                                   MetaResponse response)>;
+    void fan_out_meta(const std::string& type,
+                      const std::string& id,
+                      const std::vector<InstalledAddon>& addons,
+                      const MetaFanoutOptions& options,
+                      MetaResponseHandler on_response,
+                      std::function<void(bool answered, const std::string& errors)> on_done);
+    static bool serves_meta(const std::vector<InstalledAddon>& addons, const std::string& addon_id);
+    std::string get_storage_path();
 };
 
 } // namespace Stremio
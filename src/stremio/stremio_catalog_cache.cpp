@@ -0,0 +1,268 @@
+#include "stremio_catalog_cache.hpp"
+#include "stremio_parser.hpp"
+#include "stremio_gzip.hpp"
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <vector>
+
+namespace Stremio {
+
+// Catalogs change daily at most; an hour keeps genre flipping instant
+static const int64_t DEFAULT_CATALOG_TTL = 60 * 60;
+
+// Lower bound, so a cacheMaxAge of 0 doesn't turn every visit into two renders
+static const int64_t MIN_CATALOG_TTL = 60;
+
+// Disk entries this far past their TTL are ignored rather than shown stale
+static const int64_t MAX_CATALOG_STALENESS = 7 * 24 * 60 * 60;
+
+// Every genre and page browsed gets a file; at startup files not written
+// for this long are deleted, then the oldest until the rest fit the cap
+static const int64_t MAX_CATALOG_FILE_AGE = 30 * 24 * 60 * 60;
+static const goffset MAX_CATALOG_DISK_BYTES = 64 * 1024 * 1024;
+static const goffset CATALOG_DISK_TRIM_TO_BYTES = 48 * 1024 * 1024;
+
+// First line of every cache file: magic, version, fetched at, ttl
+static const char* CACHE_FILE_MAGIC = "madari-catalog";
+static const int CACHE_FILE_VERSION = 1;
+
+bool CachedCatalog::is_fresh() const {
+    return std::time(nullptr) < fetched_at + ttl;
+}
+
+namespace {
+
+struct DiskRead {
+    std::string path;
+    std::optional<CachedCatalog> result;
+};
+
+struct PendingLookup {
+    CatalogCache* cache;        // Alive unless the task was cancelled
+    std::string key;
+    CatalogCache::LookupCallback callback;
+};
+
+// Worker thread: read, decompress and parse one cache file
+void read_cache_file(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                     [[maybe_unused]] GCancellable* cancellable) {
+    DiskRead* read = static_cast<DiskRead*>(task_data);
+
+    g_autofree gchar* contents = nullptr;
+    gsize length = 0;
+    if (!g_file_get_contents(read->path.c_str(), &contents, &length, nullptr)) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    auto data = gunzip(contents, length);
+    size_t newline = data ? data->find('\n') : std::string::npos;
+    if (newline == std::string::npos) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    g_auto(GStrv) header = g_strsplit(data->substr(0, newline).c_str(), "\t", 4);
+    if (g_strv_length(header) != 4 || !g_str_equal(header[0], CACHE_FILE_MAGIC) ||
+        atoi(header[1]) != CACHE_FILE_VERSION) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    CachedCatalog cached;
+    cached.fetched_at = g_ascii_strtoll(header[2], nullptr, 10);
+    cached.ttl = g_ascii_strtoll(header[3], nullptr, 10);
+    if (std::time(nullptr) > cached.fetched_at + cached.ttl + MAX_CATALOG_STALENESS) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    std::string body = data->substr(newline + 1);
+    auto response = Parser::parse_catalog(body);
+    if (!response) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    cached.response = std::move(*response);
+    cached.body_hash = std::hash<std::string>{}(body);
+    cached.body_size = body.size();
+    read->result = std::move(cached);
+    g_task_return_boolean(task, TRUE);
+}
+
+// Worker thread: compress and atomically replace one cache file
+void write_cache_file(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                      [[maybe_unused]] GCancellable* cancellable) {
+    auto* write = static_cast<std::pair<std::string, std::string>*>(task_data);
+
+    auto compressed = gzip(write->second);
+    g_autoptr(GError) error = nullptr;
+    if (compressed &&
+        !g_file_set_contents(write->first.c_str(), compressed->data(), compressed->size(), &error)) {
+        g_warning("Failed to write catalog cache: %s", error->message);
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+// Worker thread: delete old files, then the oldest while over the cap
+void trim_cache_dir(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                    GCancellable* cancellable) {
+    const char* dir = static_cast<const char*>(task_data);
+    g_autoptr(GFile) directory = g_file_new_for_path(dir);
+    g_autoptr(GFileEnumerator) enumerator = g_file_enumerate_children(
+        directory, G_FILE_ATTRIBUTE_STANDARD_NAME "," G_FILE_ATTRIBUTE_STANDARD_SIZE ","
+                   G_FILE_ATTRIBUTE_TIME_MODIFIED,
+        G_FILE_QUERY_INFO_NONE, cancellable, nullptr);
+    if (!enumerator) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    struct DiskFile { guint64 mtime; goffset size; std::string path; };
+    std::vector<DiskFile> files;
+    goffset total = 0;
+    guint64 cutoff = static_cast<guint64>(std::time(nullptr) - MAX_CATALOG_FILE_AGE);
+
+    GFileInfo* info;
+    while ((info = g_file_enumerator_next_file(enumerator, cancellable, nullptr)) != nullptr) {
+        DiskFile file{g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED),
+                      g_file_info_get_size(info), std::string(dir) + "/" + g_file_info_get_name(info)};
+        g_object_unref(info);
+
+        if (file.mtime < cutoff) {
+            g_unlink(file.path.c_str());
+            continue;
+        }
+        total += file.size;
+        files.push_back(std::move(file));
+    }
+
+    if (total > MAX_CATALOG_DISK_BYTES) {
+        std::sort(files.begin(), files.end(), [](const DiskFile& a, const DiskFile& b) {
+            return a.mtime < b.mtime;
+        });
+        for (const auto& file : files) {
+            if (total <= CATALOG_DISK_TRIM_TO_BYTES) break;
+            if (g_unlink(file.path.c_str()) == 0) total -= file.size;
+        }
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+} // namespace
+
+CatalogCache::CatalogCache(size_t memory_capacity)
+    : capacity_(memory_capacity),
+      cancellable_(g_cancellable_new()) {
+    cache_dir_ = std::string(g_get_user_cache_dir()) + "/madari/catalog";
+    g_mkdir_with_parents(cache_dir_.c_str(), 0755);
+
+    GTask* task = g_task_new(nullptr, cancellable_, nullptr, nullptr);
+    g_task_set_task_data(task, g_strdup(cache_dir_.c_str()), g_free);
+    g_task_run_in_thread(task, trim_cache_dir);
+    g_object_unref(task);
+}
+
+CatalogCache::~CatalogCache() {
+    // Disk lookups still running call back into a cache that is gone
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+}
+
+std::string CatalogCache::make_key(const std::string& addon_id, const std::string& type,
+                                   const std::string& catalog_id, const ExtraArgs& extra) {
+    return addon_id + "/" + type + "/" + catalog_id + "/" + extra.to_path_segment();
+}
+
+std::string CatalogCache::path_for(const std::string& key) const {
+    g_autofree gchar* hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, key.c_str(), -1);
+    return cache_dir_ + "/" + hash + ".json.gz";
+}
+
+void CatalogCache::remember(const std::string& key, std::shared_ptr<CachedCatalog> value) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        memory_bytes_ -= it->second->value->body_size;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    memory_bytes_ += value->body_size;
+    lru_.push_front({key, std::move(value)});
+    index_[key] = lru_.begin();
+
+    while (lru_.size() > capacity_) {
+        memory_bytes_ -= lru_.back().value->body_size;
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+void CatalogCache::clear_memory() {
+    lru_.clear();
+    index_.clear();
+    memory_bytes_ = 0;
+}
+
+void CatalogCache::lookup(const std::string& key, LookupCallback callback) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        stats_.memory_hits++;
+        callback(*it->second->value);
+        return;
+    }
+
+    auto* pending = new PendingLookup{this, key, std::move(callback)};
+    GTask* task = g_task_new(nullptr, cancellable_,
+        [](GObject*, GAsyncResult* result, gpointer user_data) {
+            auto* pending = static_cast<PendingLookup*>(user_data);
+            if (g_task_had_error(G_TASK(result))) {
+                delete pending;
+                return;
+            }
+
+            DiskRead* read = static_cast<DiskRead*>(g_task_get_task_data(G_TASK(result)));
+
+            if (read->result) {
+                pending->cache->stats_.disk_hits++;
+                pending->cache->remember(pending->key, std::make_shared<CachedCatalog>(*read->result));
+            } else {
+                pending->cache->stats_.misses++;
+            }
+            pending->callback(std::move(read->result));
+            delete pending;
+        }, pending);
+    g_task_set_task_data(task, new DiskRead{path_for(key), std::nullopt},
+                         [](gpointer d) { delete static_cast<DiskRead*>(d); });
+    g_task_run_in_thread(task, read_cache_file);
+    g_object_unref(task);
+}
+
+void CatalogCache::store(const std::string& key, const CatalogResponse& response, const std::string& body) {
+    auto cached = std::make_shared<CachedCatalog>();
+    cached->response = response;
+    cached->fetched_at = std::time(nullptr);
+    cached->ttl = std::max<int64_t>(response.cache_max_age.value_or(DEFAULT_CATALOG_TTL), MIN_CATALOG_TTL);
+    cached->body_hash = std::hash<std::string>{}(body);
+    cached->body_size = body.size();
+
+    std::string header = std::string(CACHE_FILE_MAGIC) + "\t" + std::to_string(CACHE_FILE_VERSION) +
+                         "\t" + std::to_string(cached->fetched_at) +
+                         "\t" + std::to_string(cached->ttl) + "\n";
+
+    remember(key, std::move(cached));
+
+    GTask* task = g_task_new(nullptr, nullptr, nullptr, nullptr);
+    g_task_set_task_data(task, new std::pair<std::string, std::string>(path_for(key), header + body),
+                         [](gpointer d) { delete static_cast<std::pair<std::string, std::string>*>(d); });
+    g_task_run_in_thread(task, write_cache_file);
+    g_object_unref(task);
+}
+
+} // namespace Stremio
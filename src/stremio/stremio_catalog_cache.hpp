@@ -0,0 +1,90 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <gio/gio.h>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Stremio {
+
+/**
+ * A catalog page as cached, with when it was fetched
+ */
+struct CachedCatalog {
+    CatalogResponse response;
+    int64_t fetched_at = 0;   // Unix timestamp
+    int64_t ttl = 0;          // Seconds it counts as fresh
+    size_t body_hash = 0;     // Of the raw response, to spot unchanged revalidations
+    size_t body_size = 0;     // Of the raw response, roughly what the parsed copy costs
+
+    bool is_fresh() const;
+};
+
+/**
+ * Two-tier cache of catalog pages keyed by addon, type, catalog and extra
+ * arguments (genre, skip, ...): an in-memory LRU of parsed responses in
+ * front of gzip-compressed raw responses under the user cache dir.
+ * Mirrors MetaCache: disk I/O and parsing run on worker threads, and stale
+ * entries are still returned for the caller to revalidate. Old files are
+ * trimmed from disk by age and total size when the cache is created.
+ */
+class CatalogCache {
+public:
+    using LookupCallback = std::function<void(std::optional<CachedCatalog>)>;
+
+    explicit CatalogCache(size_t memory_capacity = 64);
+    ~CatalogCache();
+
+    static std::string make_key(const std::string& addon_id, const std::string& type,
+                                const std::string& catalog_id, const ExtraArgs& extra);
+
+    /**
+     * Find a cached page. Memory hits call back synchronously, disk hits
+     * after reading and parsing off the main thread; misses with nullopt.
+     */
+    void lookup(const std::string& key, LookupCallback callback);
+
+    /**
+     * Store a fetched page in memory and (asynchronously) on disk
+     * @param body The raw JSON the response was parsed from
+     */
+    void store(const std::string& key, const CatalogResponse& response, const std::string& body);
+
+    /**
+     * Drop the in-memory tier; disk entries are kept
+     */
+    void clear_memory();
+
+    size_t memory_size() const { return lru_.size(); }
+
+    /**
+     * Approximate bytes held by the in-memory tier
+     */
+    size_t memory_bytes() const { return memory_bytes_; }
+
+    const CacheStats& stats() const { return stats_; }
+
+private:
+    struct MemoryEntry {
+        std::string key;
+        std::shared_ptr<CachedCatalog> value;
+    };
+
+    size_t capacity_;
+    std::list<MemoryEntry> lru_;  // Most recently used first
+    size_t memory_bytes_ = 0;
+    CacheStats stats_;
+    std::unordered_map<std::string, std::list<MemoryEntry>::iterator> index_;
+    std::string cache_dir_;
+    GCancellable* cancellable_;   // Cancels disk work when the cache goes away
+
+    std::string path_for(const std::string& key) const;
+    void remember(const std::string& key, std::shared_ptr<CachedCatalog> value);
+};
+
+} // namespace Stremio
@@ -1,5 +1,6 @@
 #include "stremio_client.hpp"
 #include "stremio_parser.hpp"
+#include "../transport.hpp"
 #include <sstream>
 
 namespace Stremio {
@@ -40,7 +41,8 @@ std::string Client::build_url(const std::string& base_url, const std::string& pa
 }
 
 void Client::make_request(const std::string& url, 
-                          std::function<void(const std::string& body, const std::string& error)> callback) {
+                          std::function<void(const std::string& body, const std::string& error)> callback,
+                          const RequestOptions& options) {
     SoupMessage* msg = soup_message_new("GET", url.c_str());
     if (!msg) {
         callback("", "Invalid URL: " + url);
@@ -52,51 +54,27 @@ void Client::make_request(const std::string& url,
     soup_message_headers_append(headers, "Accept", "application/json");
     soup_message_headers_append(headers, "User-Agent", "Madari/1.0");
     
-    // Create callback data
-    struct RequestData {
-        std::function<void(const std::string&, const std::string&)> callback;
-    };
-    auto* data = new RequestData{std::move(callback)};
+    (*in_flight_)++;
     
-    soup_session_send_and_read_async(
-        session_,
-        msg,
-        G_PRIORITY_DEFAULT,
-        nullptr, // cancellable
-        [](GObject* source, GAsyncResult* result, gpointer user_data) {
-            auto* data = static_cast<RequestData*>(user_data);
-            g_autoptr(GError) error = nullptr;
-            
-            GBytes* bytes = soup_session_send_and_read_finish(
-                SOUP_SESSION(source), result, &error);
+    // in_flight outlives the client if the session does
+    Madari::Transport::send_and_read(session_, msg, options.priority, options.cancellable,
+        [in_flight = in_flight_, callback = std::move(callback)](GBytes* bytes, guint status, const GError* error) {
+            (*in_flight)--;
             
             if (error) {
-                data->callback("", std::string("Request failed: ") + error->message);
-                delete data;
+                callback("", std::string("Request failed: ") + error->message);
                 return;
             }
             
-            SoupMessage* msg = soup_session_get_async_result_message(
-                SOUP_SESSION(source), result);
-            guint status = soup_message_get_status(msg);
-            
             if (status < 200 || status >= 300) {
-                data->callback("", "HTTP error: " + std::to_string(status));
-                g_bytes_unref(bytes);
-                delete data;
+                callback("", "HTTP error: " + std::to_string(status));
                 return;
             }
             
-            gsize size;
-            const char* body_data = static_cast<const char*>(g_bytes_get_data(bytes, &size));
-            std::string body(body_data, size);
-            
-            g_bytes_unref(bytes);
-            data->callback(body, "");
-            delete data;
-        },
-        data
-    );
+            gsize size = 0;
+            const char* body_data = bytes ? static_cast<const char*>(g_bytes_get_data(bytes, &size)) : nullptr;
+            callback(std::string(body_data ? body_data : "", size), "");
+        });
     
     g_object_unref(msg);
 }
@@ -125,11 +103,10 @@ void Client::fetch_manifest(const std::string& url, ManifestCallback callback) {
     });
 }
 
-void Client::fetch_catalog(const Manifest& manifest,
-                           const std::string& type,
-                           const std::string& catalog_id,
-                           const ExtraArgs& extra,
-                           CatalogCallback callback) {
+std::string Client::catalog_url(const Manifest& manifest,
+                                const std::string& type,
+                                const std::string& catalog_id,
+                                const ExtraArgs& extra) {
     std::ostringstream path;
     path << "/catalog/" << type << "/" << catalog_id;
     
@@ -139,9 +116,25 @@ void Client::fetch_catalog(const Manifest& manifest,
     }
     path << ".json";
     
-    std::string url = build_url(manifest.transport_url, path.str());
-    
-    make_request(url, [callback](const std::string& body, const std::string& error) {
+    return build_url(manifest.transport_url, path.str());
+}
+
+void Client::fetch_catalog_body(const Manifest& manifest,
+                                const std::string& type,
+                                const std::string& catalog_id,
+                                const ExtraArgs& extra,
+                                BodyCallback callback,
+                                const RequestOptions& options) {
+    make_request(catalog_url(manifest, type, catalog_id, extra), std::move(callback), options);
+}
+
+void Client::fetch_catalog(const Manifest& manifest,
+                           const std::string& type,
+                           const std::string& catalog_id,
+                           const ExtraArgs& extra,
+                           CatalogCallback callback,
+                           const RequestOptions& options) {
+    fetch_catalog_body(manifest, type, catalog_id, extra, [callback](const std::string& body, const std::string& error) {
         if (!error.empty()) {
             callback(std::nullopt, error);
             return;
@@ -154,19 +147,28 @@ void Client::fetch_catalog(const Manifest& manifest,
         }
         
         callback(response, "");
-    });
+    }, options);
 }
 
-void Client::fetch_meta(const Manifest& manifest,
-                        const std::string& type,
-                        const std::string& id,
-                        MetaCallback callback) {
+void Client::fetch_meta_body(const Manifest& manifest,
+                             const std::string& type,
+                             const std::string& id,
+                             BodyCallback callback,
+                             const RequestOptions& options) {
     std::ostringstream path;
     path << "/meta/" << type << "/" << id << ".json";
     
     std::string url = build_url(manifest.transport_url, path.str());
     
-    make_request(url, [callback](const std::string& body, const std::string& error) {
+    make_request(url, std::move(callback), options);
+}
+
+void Client::fetch_meta(const Manifest& manifest,
+                        const std::string& type,
+                        const std::string& id,
+                        MetaCallback callback,
+                        const RequestOptions& options) {
+    fetch_meta_body(manifest, type, id, [callback](const std::string& body, const std::string& error) {
         if (!error.empty()) {
             callback(std::nullopt, error);
             return;
@@ -179,13 +181,14 @@ void Client::fetch_meta(const Manifest& manifest,
         }
         
         callback(response, "");
-    });
+    }, options);
 }
 
 void Client::fetch_streams(const Manifest& manifest,
                            const std::string& type,
                            const std::string& video_id,
-                           StreamsCallback callback) {
+                           StreamsCallback callback,
+                           const RequestOptions& options) {
     std::ostringstream path;
     path << "/stream/" << type << "/" << video_id << ".json";
     
@@ -204,7 +207,7 @@ void Client::fetch_streams(const Manifest& manifest,
         }
         
         callback(response, "");
-    });
+    }, options);
 }
 
 void Client::fetch_subtitles(const Manifest& manifest,
@@ -212,7 +215,8 @@ void Client::fetch_subtitles(const Manifest& manifest,
                              const std::string& id,
                              const std::string& video_id,
                              std::optional<int64_t> video_size,
-                             SubtitlesCallback callback) {
+                             SubtitlesCallback callback,
+                             const RequestOptions& options) {
     std::ostringstream path;
     path << "/subtitles/" << type << "/" << id;
     
@@ -239,7 +243,7 @@ void Client::fetch_subtitles(const Manifest& manifest,
         }
         
         callback(response, "");
-    });
+    }, options);
 }
 
 } // namespace Stremio
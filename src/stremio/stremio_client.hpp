@@ -8,6 +8,14 @@
 
 namespace Stremio {
 
+/**
+ * Per-request scheduling options
+ */
+struct RequestOptions {
+    int priority = G_PRIORITY_DEFAULT;      // I/O priority handed to libsoup
+    GCancellable* cancellable = nullptr;    // Cancel to abort the request (not owned)
+};
+
 /**
  * HTTP Client for interacting with Stremio addons
  */
@@ -18,6 +26,7 @@ public:
     using MetaCallback = std::function<void(std::optional<MetaResponse>, const std::string& error)>;
     using StreamsCallback = std::function<void(std::optional<StreamsResponse>, const std::string& error)>;
     using SubtitlesCallback = std::function<void(std::optional<SubtitlesResponse>, const std::string& error)>;
+    using BodyCallback = std::function<void(const std::string& body, const std::string& error)>;
 
     Client();
     ~Client();
@@ -36,24 +45,47 @@ public:
      * @param catalog_id The catalog ID
      * @param extra Optional extra arguments (search, skip, etc.)
      * @param callback Called with the catalog response or error
+     * @param options Priority and cancellation for the request
      */
     void fetch_catalog(const Manifest& manifest, 
                        const std::string& type, 
                        const std::string& catalog_id,
                        const ExtraArgs& extra,
-                       CatalogCallback callback);
-    
+                       CatalogCallback callback,
+                       const RequestOptions& options = {});
+
+    /**
+     * Fetch the raw catalog response, for callers that keep the JSON (e.g. to cache it)
+     */
+    void fetch_catalog_body(const Manifest& manifest,
+                            const std::string& type,
+                            const std::string& catalog_id,
+                            const ExtraArgs& extra,
+                            BodyCallback callback,
+                            const RequestOptions& options = {});
+
     /**
      * Fetch metadata for an item
      * @param manifest The addon manifest
      * @param type Content type
      * @param id Item ID
      * @param callback Called with the meta response or error
+     * @param options Priority and cancellation for the request
      */
     void fetch_meta(const Manifest& manifest,
                     const std::string& type,
                     const std::string& id,
-                    MetaCallback callback);
+                    MetaCallback callback,
+                    const RequestOptions& options = {});
+    
+    /**
+     * Fetch the raw meta response, for callers that keep the JSON (e.g. to cache it)
+     */
+    void fetch_meta_body(const Manifest& manifest,
+                         const std::string& type,
+                         const std::string& id,
+                         BodyCallback callback,
+                         const RequestOptions& options = {});
     
     /**
      * Fetch streams for an item
@@ -61,11 +93,13 @@ public:
      * @param type Content type
      * @param video_id Video ID (for movies, same as item ID; for series, includes season/episode)
      * @param callback Called with the streams response or error
+     * @param options Priority and cancellation for the request
      */
     void fetch_streams(const Manifest& manifest,
                        const std::string& type,
                        const std::string& video_id,
-                       StreamsCallback callback);
+                       StreamsCallback callback,
+                       const RequestOptions& options = {});
     
     /**
      * Fetch subtitles for a video
@@ -75,22 +109,39 @@ public:
      * @param video_id Video ID
      * @param video_size Video file size in bytes (optional)
      * @param callback Called with the subtitles response or error
+     * @param options Priority and cancellation for the request
      */
     void fetch_subtitles(const Manifest& manifest,
                          const std::string& type,
                          const std::string& id,
                          const std::string& video_id,
                          std::optional<int64_t> video_size,
-                         SubtitlesCallback callback);
+                         SubtitlesCallback callback,
+                         const RequestOptions& options = {});
+    
+    /**
+     * Requests sent and not yet answered
+     */
+    size_t in_flight() const { return *in_flight_; }
+    
+    /**
+     * URL of a catalog page, e.g. .../catalog/movie/top/genre=Drama&skip=100.json
+     */
+    static std::string catalog_url(const Manifest& manifest,
+                                   const std::string& type,
+                                   const std::string& catalog_id,
+                                   const ExtraArgs& extra);
 
 private:
     SoupSession* session_;
+    std::shared_ptr<size_t> in_flight_ = std::make_shared<size_t>(0);
     
-    std::string build_url(const std::string& base_url, const std::string& path);
-    std::string get_base_url(const std::string& transport_url);
+    static std::string build_url(const std::string& base_url, const std::string& path);
+    static std::string get_base_url(const std::string& transport_url);
     
     void make_request(const std::string& url, 
-                      std::function<void(const std::string& body, const std::string& error)> callback);
+                      std::function<void(const std::string& body, const std::string& error)> callback,
+                      const RequestOptions& options = {});
 };
 
 } // namespace Stremio
@@ -0,0 +1,43 @@
+#include "stremio_gzip.hpp"
+#include <gio/gio.h>
+
+namespace Stremio {
+
+std::optional<std::string> gzip(const std::string& data) {
+    g_autoptr(GZlibCompressor) compressor = g_zlib_compressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1);
+    g_autoptr(GOutputStream) memory = g_memory_output_stream_new_resizable();
+    g_autoptr(GOutputStream) out = g_converter_output_stream_new(memory, G_CONVERTER(compressor));
+    g_autoptr(GError) error = nullptr;
+
+    if (!g_output_stream_write_all(out, data.data(), data.size(), nullptr, nullptr, &error) ||
+        !g_output_stream_close(out, nullptr, &error)) {
+        g_warning("Failed to compress cache entry: %s", error->message);
+        return std::nullopt;
+    }
+
+    GMemoryOutputStream* result = G_MEMORY_OUTPUT_STREAM(memory);
+    return std::string(static_cast<const char*>(g_memory_output_stream_get_data(result)),
+                       g_memory_output_stream_get_data_size(result));
+}
+
+std::optional<std::string> gunzip(const char* data, gsize size) {
+    g_autoptr(GZlibDecompressor) decompressor = g_zlib_decompressor_new(G_ZLIB_COMPRESSOR_FORMAT_GZIP);
+    g_autoptr(GInputStream) memory = g_memory_input_stream_new_from_data(data, size, nullptr);
+    g_autoptr(GInputStream) in = g_converter_input_stream_new(memory, G_CONVERTER(decompressor));
+    g_autoptr(GError) error = nullptr;
+
+    std::string result;
+    char buffer[16384];
+    for (;;) {
+        gssize n = g_input_stream_read(in, buffer, sizeof(buffer), nullptr, &error);
+        if (n < 0) {
+            g_warning("Failed to decompress cache entry: %s", error->message);
+            return std::nullopt;
+        }
+        if (n == 0) break;
+        result.append(buffer, n);
+    }
+    return result;
+}
+
+} // namespace Stremio
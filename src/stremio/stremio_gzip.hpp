@@ -0,0 +1,16 @@
+#pragma once
+
+#include <glib.h>
+#include <optional>
+#include <string>
+
+namespace Stremio {
+
+/**
+ * gzip helpers for the on-disk response caches. Safe to call from worker
+ * threads; failures are logged and return nullopt.
+ */
+std::optional<std::string> gzip(const std::string& data);
+std::optional<std::string> gunzip(const char* data, gsize size);
+
+} // namespace Stremio
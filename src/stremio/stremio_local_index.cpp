@@ -0,0 +1,420 @@
+#include "stremio_local_index.hpp"
+#include "stremio_parser.hpp"
+#include "stremio_search_aggregator.hpp"
+#include <json-glib/json-glib.h>
+#include <gio/gio.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace Stremio {
+
+// Write a few seconds after the last change, so a home screen load is one save
+static const guint SAVE_DELAY_SECONDS = 5;
+
+// Rebuild the term map once this share of documents are stale copies
+static const double MAX_DEAD_RATIO = 0.25;
+
+namespace {
+
+const double FIELD_WEIGHT[] = { 1.0, 0.6, 0.3 };   // NAME, PERSON, GENRE
+
+const double EXACT_MATCH = 1.0;
+const double PREFIX_MATCH = 0.7;
+const double FUZZY_MATCH = 0.4;
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+size_t length_difference(const std::string& a, const std::string& b) {
+    return a.size() > b.size() ? a.size() - b.size() : b.size() - a.size();
+}
+
+// Levenshtein distance between a and b, or max + 1 once it exceeds max.
+// prev and cur are scratch rows, reused across calls so a query does not
+// allocate per candidate term.
+size_t edit_distance(const std::string& a, const std::string& b, size_t max,
+                     std::vector<size_t>& prev, std::vector<size_t>& cur) {
+    if (length_difference(a, b) > max) return max + 1;
+
+    prev.resize(b.size() + 1);
+    cur.resize(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); j++) prev[j] = j;
+
+    for (size_t i = 1; i <= a.size(); i++) {
+        cur[0] = i;
+        size_t row_min = cur[0];
+        for (size_t j = 1; j <= b.size(); j++) {
+            size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            cur[j] = std::min({ prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost });
+            row_min = std::min(row_min, cur[j]);
+        }
+        if (row_min > max) return max + 1;
+        std::swap(prev, cur);
+    }
+    return prev[b.size()];
+}
+
+// Typos tolerated in a query word of this many bytes
+size_t allowed_typos(size_t length) {
+    if (length >= 8) return 2;
+    if (length >= 4) return 1;
+    return 0;
+}
+
+void add_strings(JsonBuilder* builder, const char* member, const std::vector<std::string>& values) {
+    if (values.empty()) return;
+    json_builder_set_member_name(builder, member);
+    json_builder_begin_array(builder);
+    for (const auto& value : values) {
+        json_builder_add_string_value(builder, value.c_str());
+    }
+    json_builder_end_array(builder);
+}
+
+void add_optional(JsonBuilder* builder, const char* member, const std::optional<std::string>& value) {
+    if (!value) return;
+    json_builder_set_member_name(builder, member);
+    json_builder_add_string_value(builder, value->c_str());
+}
+
+struct IndexRead {
+    std::string path;
+    std::vector<MetaPreview> metas;
+};
+
+struct IndexWrite {
+    std::string path;
+    std::string contents;
+};
+
+// Worker thread: read and parse the saved index
+void read_index_file(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                     [[maybe_unused]] GCancellable* cancellable) {
+    IndexRead* read = static_cast<IndexRead*>(task_data);
+
+    g_autofree gchar* contents = nullptr;
+    if (g_file_get_contents(read->path.c_str(), &contents, nullptr, nullptr)) {
+        if (auto response = Parser::parse_catalog(contents)) {
+            read->metas = std::move(response->metas);
+        }
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+// Worker thread: atomically replace the saved index
+void write_index_file(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                      [[maybe_unused]] GCancellable* cancellable) {
+    IndexWrite* write = static_cast<IndexWrite*>(task_data);
+
+    g_autoptr(GError) error = nullptr;
+    if (!g_file_set_contents(write->path.c_str(), write->contents.data(), write->contents.size(), &error)) {
+        g_warning("Failed to save search index: %s", error->message);
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+} // namespace
+
+LocalIndex::LocalIndex(size_t capacity)
+    : capacity_(capacity),
+      cancellable_(g_cancellable_new()) {
+    std::string dir = std::string(g_get_user_cache_dir()) + "/madari";
+    g_mkdir_with_parents(dir.c_str(), 0755);
+    path_ = dir + "/search-index.json";
+}
+
+LocalIndex::~LocalIndex() {
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+
+    // Items seen since the last save would otherwise be lost at exit
+    flush();
+}
+
+void LocalIndex::load() {
+    GTask* task = g_task_new(nullptr, cancellable_,
+        [](GObject*, GAsyncResult* result, gpointer user_data) {
+            // Cancelled when the index went away first
+            if (g_task_had_error(G_TASK(result))) return;
+
+            LocalIndex* self = static_cast<LocalIndex*>(user_data);
+            IndexRead* read = static_cast<IndexRead*>(g_task_get_task_data(G_TASK(result)));
+
+            // Saved items are older than anything added while reading, so
+            // they go in below them and never replace them
+            std::vector<Doc> added = std::move(self->docs_);
+            self->docs_.clear();
+            self->by_id_.clear();
+            self->terms_.clear();
+            self->dead_ = 0;
+            self->next_seen_ = 1;
+
+            for (auto& meta : read->metas) {
+                self->insert(std::move(meta), self->next_seen_++);
+            }
+            for (auto& doc : added) {
+                if (doc.live) self->insert(std::move(doc.meta), self->next_seen_++);
+            }
+            if (self->by_id_.size() > self->capacity_) {
+                self->compact();
+            }
+
+            // Saves wait for the read so they cannot replace the file with
+            // only what was added meanwhile
+            self->loaded_ = true;
+            if (!added.empty()) self->schedule_save();
+        }, this);
+    g_task_set_task_data(task, new IndexRead{path_, {}},
+                         [](gpointer d) { delete static_cast<IndexRead*>(d); });
+    g_task_run_in_thread(task, read_index_file);
+    g_object_unref(task);
+}
+
+void LocalIndex::insert(MetaPreview meta, uint64_t seen) {
+    auto it = by_id_.find(meta.id);
+    if (it != by_id_.end()) {
+        Doc& existing = docs_[it->second];
+        // Same indexed text: refresh in place, the postings still hold
+        if (existing.meta.name == meta.name && existing.meta.cast == meta.cast &&
+            existing.meta.director == meta.director && existing.meta.genres == meta.genres) {
+            existing.meta = std::move(meta);
+            existing.seen = seen;
+            return;
+        }
+        existing.live = false;
+        dead_++;
+    }
+
+    uint32_t doc = static_cast<uint32_t>(docs_.size());
+    by_id_[meta.id] = doc;
+    docs_.push_back({std::move(meta), seen, true});
+    index_doc(doc);
+}
+
+void LocalIndex::index_doc(uint32_t doc) {
+    const MetaPreview& meta = docs_[doc].meta;
+
+    auto post = [this, doc](const std::string& text, Field field) {
+        for (auto& word : SearchAggregator::tokenize(text)) {
+            auto& postings = terms_[std::move(word)];
+            // A word repeated within the document is one posting per field
+            if (postings.empty() || postings.back().doc != doc || postings.back().field != field) {
+                postings.push_back({doc, field});
+            }
+        }
+    };
+
+    post(meta.name, NAME);
+    for (const auto& person : meta.director) post(person, PERSON);
+    for (const auto& person : meta.cast) post(person, PERSON);
+    for (const auto& genre : meta.genres) post(genre, GENRE);
+}
+
+void LocalIndex::compact() {
+    std::vector<Doc> live;
+    live.reserve(by_id_.size());
+    for (auto& doc : docs_) {
+        if (doc.live) live.push_back(std::move(doc));
+    }
+
+    // Over capacity: keep the most recently seen
+    if (live.size() > capacity_) {
+        std::sort(live.begin(), live.end(), [](const Doc& a, const Doc& b) { return a.seen > b.seen; });
+        live.resize(capacity_);
+    }
+    std::sort(live.begin(), live.end(), [](const Doc& a, const Doc& b) { return a.seen < b.seen; });
+
+    docs_ = std::move(live);
+    by_id_.clear();
+    terms_.clear();
+    dead_ = 0;
+    for (uint32_t i = 0; i < docs_.size(); i++) {
+        by_id_[docs_[i].meta.id] = i;
+        index_doc(i);
+    }
+}
+
+void LocalIndex::add(const std::vector<MetaPreview>& metas) {
+    for (const auto& meta : metas) {
+        if (meta.id.empty() || meta.name.empty()) continue;
+
+        // Descriptions and links are not searched and would bloat the file
+        MetaPreview stored = meta;
+        stored.description.reset();
+        stored.links.clear();
+        insert(std::move(stored), next_seen_++);
+    }
+
+    if (by_id_.size() > capacity_ || dead_ > docs_.size() * MAX_DEAD_RATIO) {
+        compact();
+    }
+    schedule_save();
+}
+
+std::vector<MetaPreview> LocalIndex::search(const std::string& query, size_t limit) const {
+    auto words = SearchAggregator::tokenize(query);
+    if (words.empty()) return {};
+
+    // Running total per document; only documents matching every word so far
+    std::unordered_map<uint32_t, double> totals;
+    std::vector<size_t> prev_row, cur_row;
+
+    for (size_t w = 0; w < words.size(); w++) {
+        const std::string& word = words[w];
+        std::unordered_map<uint32_t, double> best;
+
+        auto collect = [this, &best](const std::vector<Posting>& postings, double match) {
+            for (const Posting& posting : postings) {
+                if (!docs_[posting.doc].live) continue;
+                double score = match * FIELD_WEIGHT[posting.field];
+                double& current = best[posting.doc];
+                current = std::max(current, score);
+            }
+        };
+
+        // Exact and prefix matches share one walk of the sorted terms
+        for (auto it = terms_.lower_bound(word); it != terms_.end() && starts_with(it->first, word); ++it) {
+            collect(it->second, it->first.size() == word.size() ? EXACT_MATCH : PREFIX_MATCH);
+        }
+
+        // Near misses, among terms with the same first byte and a similar length
+        size_t typos = allowed_typos(word.size());
+        if (best.empty() && typos > 0) {
+            std::string first(1, word[0]);
+            for (auto it = terms_.lower_bound(first); it != terms_.end() && it->first[0] == word[0]; ++it) {
+                if (length_difference(word, it->first) > typos) continue;
+                if (edit_distance(word, it->first, typos, prev_row, cur_row) <= typos) {
+                    collect(it->second, FUZZY_MATCH);
+                }
+            }
+        }
+
+        if (w == 0) {
+            totals = std::move(best);
+        } else {
+            for (auto it = totals.begin(); it != totals.end();) {
+                auto hit = best.find(it->first);
+                if (hit == best.end()) {
+                    it = totals.erase(it);
+                } else {
+                    it->second += hit->second;
+                    ++it;
+                }
+            }
+        }
+        if (totals.empty()) return {};
+    }
+
+    std::vector<std::pair<uint32_t, double>> ranked(totals.begin(), totals.end());
+    auto better = [this](const auto& a, const auto& b) {
+        if (a.second != b.second) return a.second > b.second;
+        return docs_[a.first].seen > docs_[b.first].seen;
+    };
+    if (ranked.size() > limit) {
+        std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(), better);
+        ranked.resize(limit);
+    } else {
+        std::sort(ranked.begin(), ranked.end(), better);
+    }
+
+    std::vector<MetaPreview> result;
+    result.reserve(ranked.size());
+    for (const auto& [doc, score] : ranked) {
+        result.push_back(docs_[doc].meta);
+    }
+    return result;
+}
+
+std::string LocalIndex::serialize() const {
+    std::vector<const Doc*> live;
+    live.reserve(by_id_.size());
+    for (const auto& doc : docs_) {
+        if (doc.live) live.push_back(&doc);
+    }
+    std::sort(live.begin(), live.end(), [](const Doc* a, const Doc* b) { return a->seen < b->seen; });
+
+    // Same shape as a catalog response, so loading is Parser::parse_catalog
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "metas");
+    json_builder_begin_array(builder);
+    for (const Doc* doc : live) {
+        const MetaPreview& meta = doc->meta;
+        json_builder_begin_object(builder);
+        json_builder_set_member_name(builder, "id");
+        json_builder_add_string_value(builder, meta.id.c_str());
+        json_builder_set_member_name(builder, "type");
+        json_builder_add_string_value(builder, meta.type.c_str());
+        json_builder_set_member_name(builder, "name");
+        json_builder_add_string_value(builder, meta.name.c_str());
+        add_optional(builder, "poster", meta.poster);
+        add_optional(builder, "posterShape", meta.poster_shape);
+        add_optional(builder, "releaseInfo", meta.release_info);
+        add_optional(builder, "imdbRating", meta.imdb_rating);
+        add_strings(builder, "genres", meta.genres);
+        add_strings(builder, "director", meta.director);
+        add_strings(builder, "cast", meta.cast);
+        json_builder_end_object(builder);
+    }
+    json_builder_end_array(builder);
+    json_builder_end_object(builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+    g_autofree gchar* data = json_generator_to_data(generator, nullptr);
+    return data;
+}
+
+void LocalIndex::schedule_save() {
+    if (save_source_ || !loaded_) return;
+
+    save_source_ = g_timeout_add_seconds(SAVE_DELAY_SECONDS, [](gpointer user_data) -> gboolean {
+        LocalIndex* self = static_cast<LocalIndex*>(user_data);
+        self->save_source_ = 0;
+
+        // Serializing is cheap next to the write, which goes to a worker
+        GTask* task = g_task_new(nullptr, nullptr, nullptr, nullptr);
+        g_task_set_task_data(task, new IndexWrite{self->path_, self->serialize()},
+                             [](gpointer d) { delete static_cast<IndexWrite*>(d); });
+        g_task_run_in_thread(task, write_index_file);
+        g_object_unref(task);
+        return G_SOURCE_REMOVE;
+    }, this);
+}
+
+size_t LocalIndex::memory_bytes() const {
+    // Per-node overhead of the tree and hash map, roughly
+    const size_t NODE_OVERHEAD = 48;
+
+    size_t bytes = docs_.capacity() * sizeof(Doc);
+    for (const auto& doc : docs_) {
+        const MetaPreview& meta = doc.meta;
+        bytes += meta.id.size() + meta.type.size() + meta.name.size() +
+                 meta.poster.value_or("").size() + meta.description.value_or("").size();
+        for (const auto& name : meta.cast) bytes += name.size();
+        for (const auto& name : meta.director) bytes += name.size();
+        for (const auto& genre : meta.genres) bytes += genre.size();
+    }
+    for (const auto& [term, postings] : terms_) {
+        bytes += NODE_OVERHEAD + term.size() + postings.capacity() * sizeof(Posting);
+    }
+    bytes += by_id_.size() * (NODE_OVERHEAD + sizeof(uint32_t));
+    return bytes;
+}
+
+void LocalIndex::flush() {
+    if (!save_source_) return;
+
+    g_source_remove(save_source_);
+    save_source_ = 0;
+
+    std::string contents = serialize();
+    g_autoptr(GError) error = nullptr;
+    if (!g_file_set_contents(path_.c_str(), contents.data(), contents.size(), &error)) {
+        g_warning("Failed to save search index: %s", error->message);
+    }
+}
+
+} // namespace Stremio
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <gio/gio.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stremio {
+
+/**
+ * Full-text index of every catalog item the app has seen, so search can
+ * answer from memory before any addon responds, and offline.
+ *
+ * Name, cast, director and genres are split into folded words and kept in
+ * a sorted term map, giving exact, prefix and (for words with no prefix
+ * hit) edit-distance matches. The items are saved to the user cache dir in
+ * catalog-response form, oldest first, and read back on a worker thread.
+ */
+class LocalIndex {
+public:
+    explicit LocalIndex(size_t capacity = 20000);
+    ~LocalIndex();
+
+    /**
+     * Read the saved index off the main thread. Items added before it
+     * finishes are kept and count as newer than the saved ones.
+     */
+    void load();
+
+    /**
+     * Index items from a parsed catalog or search response. Items already
+     * present are refreshed; the index is saved a few seconds later.
+     */
+    void add(const std::vector<MetaPreview>& metas);
+
+    /**
+     * Items matching every word of query in any indexed field, best first.
+     * Exact word matches beat prefixes, which beat near misses; name
+     * matches beat cast and director, which beat genres.
+     */
+    std::vector<MetaPreview> search(const std::string& query, size_t limit = 40) const;
+
+    /**
+     * Write pending changes now; also done on destruction
+     */
+    void flush();
+
+    size_t size() const { return by_id_.size(); }
+
+    /**
+     * Approximate bytes held by documents and postings, for diagnostics
+     */
+    size_t memory_bytes() const;
+
+private:
+    enum Field : uint8_t { NAME, PERSON, GENRE };
+
+    struct Posting {
+        uint32_t doc;
+        Field field;
+    };
+
+    struct Doc {
+        MetaPreview meta;
+        uint64_t seen = 0;      // Higher is more recent
+        bool live = true;       // False once replaced by a newer copy
+    };
+
+    size_t capacity_;
+    std::vector<Doc> docs_;
+    std::unordered_map<std::string, uint32_t> by_id_;
+    std::map<std::string, std::vector<Posting>> terms_;
+    uint64_t next_seen_ = 1;
+    size_t dead_ = 0;
+    guint save_source_ = 0;
+    std::string path_;
+    bool loaded_ = false;
+    GCancellable* cancellable_;
+
+    void insert(MetaPreview meta, uint64_t seen);
+    void index_doc(uint32_t doc);
+    void compact();
+    void schedule_save();
+    std::string serialize() const;
+};
+
+} // namespace Stremio
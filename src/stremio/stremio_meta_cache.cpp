@@ -0,0 +1,206 @@
+#include "stremio_meta_cache.hpp"
+#include "stremio_parser.hpp"
+#include "stremio_gzip.hpp"
+#include <gio/gio.h>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+
+namespace Stremio {
+
+// Freshness when the response doesn't say
+static const int64_t DEFAULT_META_TTL = 6 * 60 * 60;
+
+// Lower bound, so a cacheMaxAge of 0 doesn't turn every visit into two renders
+static const int64_t MIN_META_TTL = 60;
+
+// Disk entries this far past their TTL are ignored rather than shown stale
+static const int64_t MAX_META_STALENESS = 30 * 24 * 60 * 60;
+
+// First line of every cache file: magic, version, addon id, fetched at, ttl
+static const char* CACHE_FILE_MAGIC = "madari-meta";
+static const int CACHE_FILE_VERSION = 1;
+
+bool CachedMeta::is_fresh() const {
+    return std::time(nullptr) < fetched_at + ttl;
+}
+
+namespace {
+
+struct DiskRead {
+    std::string path;
+    std::optional<CachedMeta> result;
+};
+
+struct PendingLookup {
+    MetaCache* cache;
+    std::string key;
+    MetaCache::LookupCallback callback;
+};
+
+// Worker thread: read, decompress and parse one cache file
+void read_cache_file(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                     [[maybe_unused]] GCancellable* cancellable) {
+    DiskRead* read = static_cast<DiskRead*>(task_data);
+
+    g_autofree gchar* contents = nullptr;
+    gsize length = 0;
+    if (!g_file_get_contents(read->path.c_str(), &contents, &length, nullptr)) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    auto data = gunzip(contents, length);
+    size_t newline = data ? data->find('\n') : std::string::npos;
+    if (newline == std::string::npos) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    g_auto(GStrv) header = g_strsplit(data->substr(0, newline).c_str(), "\t", 5);
+    if (g_strv_length(header) != 5 || !g_str_equal(header[0], CACHE_FILE_MAGIC) ||
+        atoi(header[1]) != CACHE_FILE_VERSION) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    CachedMeta cached;
+    cached.addon_id = header[2];
+    cached.fetched_at = g_ascii_strtoll(header[3], nullptr, 10);
+    cached.ttl = g_ascii_strtoll(header[4], nullptr, 10);
+    if (std::time(nullptr) > cached.fetched_at + cached.ttl + MAX_META_STALENESS) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    std::string body = data->substr(newline + 1);
+    auto response = Parser::parse_meta(body);
+    if (!response) {
+        g_task_return_boolean(task, FALSE);
+        return;
+    }
+
+    cached.meta = std::move(response->meta);
+    cached.body_hash = std::hash<std::string>{}(body);
+    cached.body_size = body.size();
+    read->result = std::move(cached);
+    g_task_return_boolean(task, TRUE);
+}
+
+// Worker thread: compress and atomically replace one cache file
+void write_cache_file(GTask* task, [[maybe_unused]] gpointer source, gpointer task_data,
+                      [[maybe_unused]] GCancellable* cancellable) {
+    auto* write = static_cast<std::pair<std::string, std::string>*>(task_data);
+
+    auto compressed = gzip(write->second);
+    g_autoptr(GError) error = nullptr;
+    if (compressed &&
+        !g_file_set_contents(write->first.c_str(), compressed->data(), compressed->size(), &error)) {
+        g_warning("Failed to write meta cache: %s", error->message);
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+} // namespace
+
+MetaCache::MetaCache(size_t memory_capacity)
+    : capacity_(memory_capacity) {
+    cache_dir_ = std::string(g_get_user_cache_dir()) + "/madari/meta";
+    g_mkdir_with_parents(cache_dir_.c_str(), 0755);
+}
+
+MetaCache::~MetaCache() = default;
+
+std::string MetaCache::make_key(const std::string& type, const std::string& id) {
+    return type + "/" + id;
+}
+
+std::string MetaCache::path_for(const std::string& key) const {
+    g_autofree gchar* hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, key.c_str(), -1);
+    return cache_dir_ + "/" + hash + ".json.gz";
+}
+
+void MetaCache::remember(const std::string& key, std::shared_ptr<CachedMeta> value) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        memory_bytes_ -= it->second->value->body_size;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    memory_bytes_ += value->body_size;
+    lru_.push_front({key, std::move(value)});
+    index_[key] = lru_.begin();
+
+    while (lru_.size() > capacity_) {
+        memory_bytes_ -= lru_.back().value->body_size;
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+void MetaCache::clear_memory() {
+    lru_.clear();
+    index_.clear();
+    memory_bytes_ = 0;
+}
+
+void MetaCache::lookup(const std::string& type, const std::string& id, LookupCallback callback) {
+    std::string key = make_key(type, id);
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        stats_.memory_hits++;
+        callback(*it->second->value);
+        return;
+    }
+
+    auto* pending = new PendingLookup{this, key, std::move(callback)};
+    GTask* task = g_task_new(nullptr, nullptr,
+        [](GObject*, GAsyncResult* result, gpointer user_data) {
+            auto* pending = static_cast<PendingLookup*>(user_data);
+            DiskRead* read = static_cast<DiskRead*>(g_task_get_task_data(G_TASK(result)));
+
+            if (read->result) {
+                pending->cache->stats_.disk_hits++;
+                pending->cache->remember(pending->key, std::make_shared<CachedMeta>(*read->result));
+            } else {
+                pending->cache->stats_.misses++;
+            }
+            pending->callback(std::move(read->result));
+            delete pending;
+        }, pending);
+    g_task_set_task_data(task, new DiskRead{path_for(key), std::nullopt},
+                         [](gpointer d) { delete static_cast<DiskRead*>(d); });
+    g_task_run_in_thread(task, read_cache_file);
+    g_object_unref(task);
+}
+
+void MetaCache::store(const std::string& type, const std::string& id, const std::string& addon_id,
+                      const MetaResponse& response, const std::string& body) {
+    std::string key = make_key(type, id);
+
+    auto cached = std::make_shared<CachedMeta>();
+    cached->meta = response.meta;
+    cached->addon_id = addon_id;
+    cached->fetched_at = std::time(nullptr);
+    cached->ttl = std::max<int64_t>(response.cache_max_age.value_or(DEFAULT_META_TTL), MIN_META_TTL);
+    cached->body_hash = std::hash<std::string>{}(body);
+    cached->body_size = body.size();
+
+    std::string header = std::string(CACHE_FILE_MAGIC) + "\t" + std::to_string(CACHE_FILE_VERSION) +
+                         "\t" + addon_id + "\t" + std::to_string(cached->fetched_at) +
+                         "\t" + std::to_string(cached->ttl) + "\n";
+
+    remember(key, std::move(cached));
+
+    GTask* task = g_task_new(nullptr, nullptr, nullptr, nullptr);
+    g_task_set_task_data(task, new std::pair<std::string, std::string>(path_for(key), header + body),
+                         [](gpointer d) { delete static_cast<std::pair<std::string, std::string>*>(d); });
+    g_task_run_in_thread(task, write_cache_file);
+    g_object_unref(task);
+}
+
+} // namespace Stremio
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Stremio {
+
+/**
+ * A meta as cached, with where and when it was fetched
+ */
+struct CachedMeta {
+    Meta meta;
+    std::string addon_id;     // Addon that served it
+    int64_t fetched_at = 0;   // Unix timestamp
+    int64_t ttl = 0;          // Seconds it counts as fresh
+    size_t body_hash = 0;     // Of the raw response, to spot unchanged revalidations
+    size_t body_size = 0;     // Of the raw response, roughly what the parsed copy costs
+
+    bool is_fresh() const;
+};
+
+/**
+ * Two-tier cache of meta responses keyed by (type, id): an in-memory LRU
+ * of parsed Meta objects in front of gzip-compressed raw responses under
+ * the user cache dir. Disk reads, parsing and writes run on worker threads.
+ *
+ * Entries past their TTL are still returned (stale-while-revalidate); the
+ * caller decides whether to refetch. The TTL is the response's cacheMaxAge
+ * when the addon sends one, else a default.
+ */
+class MetaCache {
+public:
+    using LookupCallback = std::function<void(std::optional<CachedMeta>)>;
+
+    explicit MetaCache(size_t memory_capacity = 32);
+    ~MetaCache();
+
+    /**
+     * Find a cached meta. Memory hits call back synchronously, disk hits
+     * after reading and parsing off the main thread; misses with nullopt.
+     */
+    void lookup(const std::string& type, const std::string& id, LookupCallback callback);
+
+    /**
+     * Store a fetched response in memory and (asynchronously) on disk
+     * @param body The raw JSON the response was parsed from
+     */
+    void store(const std::string& type, const std::string& id, const std::string& addon_id,
+               const MetaResponse& response, const std::string& body);
+
+    /**
+     * Drop the in-memory tier; disk entries are kept
+     */
+    void clear_memory();
+
+    size_t memory_size() const { return lru_.size(); }
+
+    /**
+     * Approximate bytes held by the in-memory tier
+     */
+    size_t memory_bytes() const { return memory_bytes_; }
+
+    const CacheStats& stats() const { return stats_; }
+
+private:
+    struct MemoryEntry {
+        std::string key;
+        std::shared_ptr<CachedMeta> value;
+    };
+
+    size_t capacity_;
+    std::list<MemoryEntry> lru_;  // Most recently used first
+    size_t memory_bytes_ = 0;
+    CacheStats stats_;
+    std::unordered_map<std::string, std::list<MemoryEntry>::iterator> index_;
+    std::string cache_dir_;
+
+    static std::string make_key(const std::string& type, const std::string& id);
+    std::string path_for(const std::string& key) const;
+    void remember(const std::string& key, std::shared_ptr<CachedMeta> value);
+};
+
+} // namespace Stremio
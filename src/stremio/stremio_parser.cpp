@@ -1,4 +1,6 @@
 #include "stremio_parser.hpp"
+#include "stremio_video_index.hpp"
+#include "../profiler.hpp"
 #include <memory>
 #include <algorithm>
 
@@ -98,7 +100,12 @@ CatalogDefinition Parser::parse_catalog_definition(JsonObject* obj) {
                         if (json_object_has_member(item, "isRequired")) {
                             is_required = json_object_get_boolean_member(item, "isRequired");
                         }
-                        
+
+                        // Newer manifests list the genre choices here instead of "genres"
+                        if (name == "genre" && cat.genres.empty()) {
+                            cat.genres = get_string_array(item, "options");
+                        }
+
                         if (is_required) {
                             // Add to extra_required if not already present
                             if (std::find(cat.extra_required.begin(), cat.extra_required.end(), name) == cat.extra_required.end()) {
@@ -315,18 +322,11 @@ Meta Parser::parse_meta_object(JsonObject* obj) {
         }
     }
     
-    // Parse videos
+    // Index videos; full Video objects are parsed per season when viewed
     if (json_object_has_member(obj, "videos")) {
         JsonNode* videos_node = json_object_get_member(obj, "videos");
         if (json_node_get_node_type(videos_node) == JSON_NODE_ARRAY) {
-            JsonArray* videos_array = json_node_get_array(videos_node);
-            guint len = json_array_get_length(videos_array);
-            for (guint i = 0; i < len; i++) {
-                JsonNode* video_node = json_array_get_element(videos_array, i);
-                if (json_node_get_node_type(video_node) == JSON_NODE_OBJECT) {
-                    meta.videos.push_back(parse_video(json_node_get_object(video_node)));
-                }
-            }
+            meta.videos = std::make_shared<VideoIndex>(json_node_get_array(videos_node));
         }
     }
     
@@ -414,6 +414,9 @@ std::optional<Manifest> Parser::parse_manifest(const std::string& json, const st
 }
 
 std::optional<CatalogResponse> Parser::parse_catalog(const std::string& json) {
+    Madari::ProfileSpan span("parse catalog", "stremio");
+    if (Madari::Profiler::enabled()) span.set_detail(std::to_string(json.size()) + " bytes");
+    
     g_autoptr(JsonParser) parser = json_parser_new();
     g_autoptr(GError) error = nullptr;
     
@@ -444,10 +447,14 @@ std::optional<CatalogResponse> Parser::parse_catalog(const std::string& json) {
         }
     }
     
+    response.cache_max_age = get_optional_int(obj, "cacheMaxAge");
     return response;
 }
 
 std::optional<MetaResponse> Parser::parse_meta(const std::string& json) {
+    Madari::ProfileSpan span("parse meta", "stremio");
+    if (Madari::Profiler::enabled()) span.set_detail(std::to_string(json.size()) + " bytes");
+    
     g_autoptr(JsonParser) parser = json_parser_new();
     g_autoptr(GError) error = nullptr;
     
@@ -474,10 +481,14 @@ std::optional<MetaResponse> Parser::parse_meta(const std::string& json) {
     
     MetaResponse response;
     response.meta = parse_meta_object(json_node_get_object(meta_node));
+    response.cache_max_age = get_optional_int(obj, "cacheMaxAge");
     return response;
 }
 
 std::optional<StreamsResponse> Parser::parse_streams(const std::string& json) {
+    Madari::ProfileSpan span("parse streams", "stremio");
+    if (Madari::Profiler::enabled()) span.set_detail(std::to_string(json.size()) + " bytes");
+    
     g_autoptr(JsonParser) parser = json_parser_new();
     g_autoptr(GError) error = nullptr;
     
@@ -38,6 +38,8 @@ public:
     static std::optional<SubtitlesResponse> parse_subtitles(const std::string& json);
 
 private:
+    friend class VideoIndex;
+    
     // Helper functions
     static std::string get_string(JsonObject* obj, const char* member);
     static std::optional<std::string> get_optional_string(JsonObject* obj, const char* member);
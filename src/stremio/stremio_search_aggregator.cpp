@@ -0,0 +1,186 @@
+#include "stremio_search_aggregator.hpp"
+#include <glib.h>
+#include <algorithm>
+
+namespace Stremio {
+
+namespace {
+
+// Weights of the score components, summing to 1
+const double TITLE_WEIGHT = 0.6;
+const double ADDON_WEIGHT = 0.2;
+const double POSITION_WEIGHT = 0.1;
+const double AGREEMENT_WEIGHT = 0.1;
+
+// Responses are usually relevance ordered; past this the position says little
+const size_t POSITION_HORIZON = 50;
+
+bool starts_with(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+double position_score(size_t position) {
+    return 1.0 - static_cast<double>(std::min(position, POSITION_HORIZON)) / POSITION_HORIZON;
+}
+
+bool ranks_before(const SearchResult* a, const SearchResult* b) {
+    if (a->score != b->score) return a->score > b->score;
+    return a->arrival < b->arrival;
+}
+
+// Bonus for results several addons returned
+double agreement(const SearchResult& entry) {
+    if (entry.addon_ids.size() < 2) return 0;
+    return AGREEMENT_WEIGHT * std::min<size_t>(entry.addon_ids.size() - 1, 3) / 3;
+}
+
+template <typename T>
+void fill_missing(std::optional<T>& base, const std::optional<T>& other) {
+    if (!base && other) base = other;
+}
+
+template <typename T>
+void fill_missing(std::vector<T>& base, const std::vector<T>& other) {
+    if (base.empty() && !other.empty()) base = other;
+}
+
+} // namespace
+
+SearchAggregator::SearchAggregator(const std::string& query, std::vector<std::string> addon_order)
+    : query_(query), addon_order_(std::move(addon_order)) {}
+
+std::vector<std::string> SearchAggregator::tokenize(const std::string& s) {
+    std::vector<std::string> result;
+    g_autofree gchar* normalized = g_utf8_normalize(s.c_str(), -1, G_NORMALIZE_ALL);
+    if (!normalized) return result;
+    g_autofree gchar* folded = g_utf8_casefold(normalized, -1);
+
+    std::string current;
+    for (const gchar* p = folded; *p; p = g_utf8_next_char(p)) {
+        gunichar c = g_utf8_get_char(p);
+        if (g_unichar_isalnum(c)) {
+            char buf[6];
+            current.append(buf, g_unichar_to_utf8(c, buf));
+        } else if (g_unichar_ismark(c)) {
+            // Combining accents left by decomposition: "é" matches "e"
+            continue;
+        } else if (!current.empty()) {
+            result.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) result.push_back(std::move(current));
+    return result;
+}
+
+double SearchAggregator::title_score(const std::string& query, const std::string& title) {
+    auto q = tokenize(query);
+    auto t = tokenize(title);
+    if (q.empty() || t.empty()) return 0;
+
+    if (q == t) return 1.0;
+
+    // Title begins with the query, the last word possibly still being typed
+    if (q.size() <= t.size()) {
+        bool leading = true;
+        for (size_t i = 0; i < q.size() && leading; i++) {
+            leading = (i + 1 == q.size()) ? starts_with(t[i], q[i]) : t[i] == q[i];
+        }
+        if (leading) return 0.85;
+    }
+
+    // Otherwise by the share of query words that begin some title word
+    size_t found = 0;
+    for (const auto& word : q) {
+        for (const auto& candidate : t) {
+            if (starts_with(candidate, word)) {
+                found++;
+                break;
+            }
+        }
+    }
+    if (found == q.size()) return 0.7;
+    return 0.5 * found / q.size();
+}
+
+double SearchAggregator::addon_score(const std::string& addon_id) const {
+    auto it = std::find(addon_order_.begin(), addon_order_.end(), addon_id);
+    if (it == addon_order_.end()) return 0;
+    return 1.0 - static_cast<double>(it - addon_order_.begin()) / addon_order_.size();
+}
+
+bool SearchAggregator::seed(const std::vector<SearchResult>& results) {
+    bool changed = false;
+    for (const auto& result : results) {
+        if (result.meta.id.empty() || by_id_.count(result.meta.id)) continue;
+
+        SearchResult& entry = entries_.emplace_back(result);
+        entry.arrival = entries_.size() - 1;
+        entry.title_match = title_score(query_, entry.meta.name);
+        entry.score = TITLE_WEIGHT * entry.title_match + entry.best_support + agreement(entry);
+
+        by_id_[entry.meta.id] = &entry;
+        ranked_.push_back(&entry);
+        changed = true;
+    }
+
+    if (changed) {
+        std::stable_sort(ranked_.begin(), ranked_.end(), ranks_before);
+    }
+    return changed;
+}
+
+bool SearchAggregator::add_batch(const Manifest& addon, const std::vector<MetaPreview>& metas) {
+    bool changed = false;
+    double source = addon_score(addon.id);
+
+    for (size_t i = 0; i < metas.size(); i++) {
+        const MetaPreview& meta = metas[i];
+        if (meta.id.empty()) continue;
+
+        double support = ADDON_WEIGHT * source + POSITION_WEIGHT * position_score(i);
+
+        auto it = by_id_.find(meta.id);
+        if (it == by_id_.end()) {
+            SearchResult& entry = entries_.emplace_back();
+            entry.meta = meta;
+            entry.arrival = entries_.size() - 1;
+            entry.addon_ids.push_back(addon.id);
+            entry.title_match = title_score(query_, meta.name);
+            entry.best_support = support;
+            entry.score = TITLE_WEIGHT * entry.title_match + support;
+
+            by_id_[meta.id] = &entry;
+            ranked_.push_back(&entry);
+            changed = true;
+            continue;
+        }
+
+        SearchResult& entry = *it->second;
+        if (std::find(entry.addon_ids.begin(), entry.addon_ids.end(), addon.id) != entry.addon_ids.end()) {
+            continue;
+        }
+        entry.addon_ids.push_back(addon.id);
+
+        // Fill what the first addon left out, e.g. a poster or cast
+        fill_missing(entry.meta.poster, meta.poster);
+        fill_missing(entry.meta.poster_shape, meta.poster_shape);
+        fill_missing(entry.meta.description, meta.description);
+        fill_missing(entry.meta.release_info, meta.release_info);
+        fill_missing(entry.meta.imdb_rating, meta.imdb_rating);
+        fill_missing(entry.meta.genres, meta.genres);
+        fill_missing(entry.meta.director, meta.director);
+        fill_missing(entry.meta.cast, meta.cast);
+
+        entry.best_support = std::max(entry.best_support, support);
+        entry.score = TITLE_WEIGHT * entry.title_match + entry.best_support + agreement(entry);
+        changed = true;
+    }
+
+    if (changed) {
+        std::stable_sort(ranked_.begin(), ranked_.end(), ranks_before);
+    }
+    return changed;
+}
+
+} // namespace Stremio
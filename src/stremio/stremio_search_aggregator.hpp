@@ -0,0 +1,82 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stremio {
+
+/**
+ * A search hit as placed in the merged result list
+ */
+struct SearchResult {
+    MetaPreview meta;                       // From the first addon, gaps filled by later ones
+    double score = 0;
+    size_t arrival = 0;                     // Order in which it was first seen
+    std::vector<std::string> addon_ids;     // Every addon that returned it, empty for local index hits
+    double title_match = 0;                 // title_score() of the name
+    double best_support = 0;                // Best addon priority + position seen so far
+};
+
+/**
+ * Merges search responses from several catalogs into one ranked list.
+ *
+ * Results are deduplicated by meta id as batches arrive. The score combines
+ * how well the title matches the query, the priority of the best addon that
+ * returned the item (install order), its position in that addon's response,
+ * and how many addons agree on it.
+ */
+class SearchAggregator {
+public:
+    /**
+     * @param addon_order Addon ids, highest priority first
+     */
+    SearchAggregator(const std::string& query, std::vector<std::string> addon_order);
+
+    /**
+     * Lowercase, accent-folded words of text, split at anything that is
+     * not a letter or digit
+     */
+    static std::vector<std::string> tokenize(const std::string& text);
+
+    /**
+     * How well a title matches a query, from 0 (no shared words) to 1
+     * (same title ignoring case and punctuation)
+     */
+    static double title_score(const std::string& query, const std::string& title);
+
+    /**
+     * Add one catalog's results
+     * @return Whether the ranked list changed
+     */
+    bool add_batch(const Manifest& addon, const std::vector<MetaPreview>& metas);
+
+    /**
+     * Start from results kept from an earlier, related query (e.g. a prefix
+     * of this one). They are rescored against this query; addon responses
+     * added later merge into them as usual.
+     * @return Whether anything was added
+     */
+    bool seed(const std::vector<SearchResult>& results);
+
+    /**
+     * All results, best first. Pointers stay valid for the aggregator's lifetime.
+     */
+    const std::vector<const SearchResult*>& ranked() const { return ranked_; }
+
+    const std::string& query() const { return query_; }
+    size_t size() const { return ranked_.size(); }
+
+private:
+    std::string query_;
+    std::vector<std::string> addon_order_;
+    std::deque<SearchResult> entries_;              // Stable addresses
+    std::vector<const SearchResult*> ranked_;
+    std::unordered_map<std::string, SearchResult*> by_id_;
+
+    double addon_score(const std::string& addon_id) const;
+};
+
+} // namespace Stremio
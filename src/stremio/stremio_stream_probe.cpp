@@ -0,0 +1,257 @@
+#include "stremio_stream_probe.hpp"
+#include <algorithm>
+#include <memory>
+
+namespace Stremio {
+
+namespace {
+
+// Read the range in chunks so throughput is measured on the body, not on one big buffer
+constexpr gsize PROBE_READ_CHUNK = 64 * 1024;
+
+struct ProbeBatch {
+    std::vector<ProbeResult> results;
+    size_t pending = 0;
+    StreamProbe::ResultCallback on_result;
+    StreamProbe::DoneCallback done;
+};
+
+struct ProbeRequest {
+    std::shared_ptr<ProbeBatch> batch;
+    size_t slot = 0;                    // Position in batch->results
+    SoupMessage* msg = nullptr;
+    GInputStream* body = nullptr;
+    GCancellable* cancellable = nullptr; // Cancelled by the deadline or the caller
+    GCancellable* parent = nullptr;
+    gulong parent_handler = 0;
+    guint deadline_id = 0;
+    bool timed_out = false;
+    int priority = G_PRIORITY_DEFAULT;
+    size_t wanted = 0;
+    gint64 started_at = 0;
+    gint64 headers_at = 0;
+    int64_t bytes = 0;
+};
+
+void finish_probe(ProbeRequest* req, const std::string& error) {
+    gint64 now = g_get_monotonic_time();
+
+    ProbeResult& result = req->batch->results[req->slot];
+    result.bytes = req->bytes;
+    if (req->headers_at > 0) {
+        result.ttfb_us = req->headers_at - req->started_at;
+        gint64 elapsed = now - req->headers_at;
+        if (elapsed > 0 && req->bytes > 0) {
+            result.bytes_per_second = req->bytes * 1000000.0 / elapsed;
+        }
+    }
+    // A probe cut off by the deadline still tells us how fast the source is
+    result.ok = req->headers_at > 0 && req->bytes > 0;
+    if (!result.ok) {
+        result.error = req->timed_out ? "Timed out" : error;
+    }
+
+    if (req->deadline_id > 0) {
+        g_source_remove(req->deadline_id);
+    }
+    if (req->parent) {
+        g_cancellable_disconnect(req->parent, req->parent_handler);
+        g_object_unref(req->parent);
+    }
+    g_clear_object(&req->body);
+    g_clear_object(&req->msg);
+    g_clear_object(&req->cancellable);
+
+    auto batch = req->batch;
+    delete req;
+
+    if (batch->on_result) {
+        batch->on_result(result);
+    }
+
+    batch->pending--;
+    if (batch->pending == 0 && batch->done) {
+        std::vector<ProbeResult> sorted = batch->results;
+        StreamProbe::sort_by_speed(sorted);
+        batch->done(sorted);
+    }
+}
+
+void read_next_chunk(ProbeRequest* req);
+
+void on_chunk_read(GObject* source, GAsyncResult* result, gpointer user_data) {
+    auto* req = static_cast<ProbeRequest*>(user_data);
+    g_autoptr(GError) error = nullptr;
+
+    GBytes* chunk = g_input_stream_read_bytes_finish(G_INPUT_STREAM(source), result, &error);
+    if (error) {
+        finish_probe(req, error->message);
+        return;
+    }
+
+    gsize size = g_bytes_get_size(chunk);
+    g_bytes_unref(chunk);
+
+    if (size == 0) {
+        // Source ended before the full range - still a valid measurement
+        finish_probe(req, "");
+        return;
+    }
+
+    req->bytes += static_cast<int64_t>(size);
+    if (static_cast<size_t>(req->bytes) >= req->wanted) {
+        finish_probe(req, "");
+        return;
+    }
+
+    read_next_chunk(req);
+}
+
+void read_next_chunk(ProbeRequest* req) {
+    gsize remaining = req->wanted - static_cast<size_t>(req->bytes);
+    g_input_stream_read_bytes_async(req->body,
+                                    std::min(remaining, PROBE_READ_CHUNK),
+                                    req->priority,
+                                    req->cancellable,
+                                    on_chunk_read,
+                                    req);
+}
+
+void on_probe_sent(GObject* source, GAsyncResult* result, gpointer user_data) {
+    auto* req = static_cast<ProbeRequest*>(user_data);
+    g_autoptr(GError) error = nullptr;
+
+    GInputStream* body = soup_session_send_finish(SOUP_SESSION(source), result, &error);
+    if (error) {
+        finish_probe(req, std::string("Request failed: ") + error->message);
+        return;
+    }
+
+    req->headers_at = g_get_monotonic_time();
+    req->body = body;
+
+    guint status = soup_message_get_status(req->msg);
+    if (status < 200 || status >= 300) {
+        req->headers_at = 0;
+        finish_probe(req, "HTTP error: " + std::to_string(status));
+        return;
+    }
+
+    read_next_chunk(req);
+}
+
+} // namespace
+
+StreamProbe::StreamProbe() {
+    // Debrid services serve many streams from one host, let them run side by side
+    session_ = soup_session_new_with_options(
+        "max-conns-per-host", 8,
+        "user-agent", "Madari/1.0",
+        nullptr);
+}
+
+StreamProbe::~StreamProbe() {
+    if (session_) {
+        g_object_unref(session_);
+    }
+}
+
+bool StreamProbe::is_probeable(const Stream& stream) {
+    if (!stream.url.has_value()) return false;
+    const std::string& url = *stream.url;
+    return url.rfind("http://", 0) == 0 || url.rfind("https://", 0) == 0;
+}
+
+void StreamProbe::probe(const std::vector<Stream>& streams,
+                        const ProbeOptions& options,
+                        ResultCallback on_result,
+                        DoneCallback done) {
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < streams.size() && targets.size() < options.max_streams; i++) {
+        if (is_probeable(streams[i])) {
+            targets.push_back(i);
+        }
+    }
+
+    if (targets.empty() || options.range_bytes == 0) {
+        if (done) done({});
+        return;
+    }
+
+    auto batch = std::make_shared<ProbeBatch>();
+    batch->results.resize(targets.size());
+    batch->pending = targets.size();
+    batch->on_result = std::move(on_result);
+    batch->done = std::move(done);
+
+    std::string range = "bytes=0-" + std::to_string(options.range_bytes - 1);
+
+    for (size_t slot = 0; slot < targets.size(); slot++) {
+        const Stream& stream = streams[targets[slot]];
+        batch->results[slot].index = targets[slot];
+
+        auto* req = new ProbeRequest();
+        req->batch = batch;
+        req->slot = slot;
+        req->priority = options.priority;
+        req->wanted = options.range_bytes;
+        req->cancellable = g_cancellable_new();
+
+        req->msg = soup_message_new("GET", stream.url->c_str());
+        if (!req->msg) {
+            finish_probe(req, "Invalid URL");
+            continue;
+        }
+
+        SoupMessageHeaders* headers = soup_message_get_request_headers(req->msg);
+        // Addons that need proxy headers for playback need them for the probe too
+        for (const auto& [name, value] : stream.behavior_hints.proxy_headers_request) {
+            soup_message_headers_replace(headers, name.c_str(), value.c_str());
+        }
+        soup_message_headers_replace(headers, "Range", range.c_str());
+
+        if (options.cancellable) {
+            req->parent = G_CANCELLABLE(g_object_ref(options.cancellable));
+            req->parent_handler = g_cancellable_connect(
+                options.cancellable,
+                G_CALLBACK(+[]([[maybe_unused]] GCancellable* parent, gpointer child) {
+                    g_cancellable_cancel(G_CANCELLABLE(child));
+                }),
+                req->cancellable, nullptr);
+        }
+
+        req->deadline_id = g_timeout_add(options.timeout_ms, [](gpointer user_data) -> gboolean {
+            auto* req = static_cast<ProbeRequest*>(user_data);
+            req->deadline_id = 0;
+            req->timed_out = true;
+            g_cancellable_cancel(req->cancellable);
+            return G_SOURCE_REMOVE;
+        }, req);
+
+        req->started_at = g_get_monotonic_time();
+        soup_session_send_async(session_, req->msg, options.priority, req->cancellable,
+                                on_probe_sent, req);
+    }
+}
+
+void StreamProbe::sort_by_speed(std::vector<ProbeResult>& results) {
+    std::stable_sort(results.begin(), results.end(), [](const ProbeResult& a, const ProbeResult& b) {
+        if (a.ok != b.ok) return a.ok;
+        if (a.bytes_per_second != b.bytes_per_second) return a.bytes_per_second > b.bytes_per_second;
+        return a.ttfb_us < b.ttfb_us;
+    });
+}
+
+std::string StreamProbe::describe(const ProbeResult& result) {
+    if (!result.ok) {
+        return result.error.empty() ? "Unreachable" : result.error;
+    }
+
+    char buf[64];
+    double mb_per_second = result.bytes_per_second / (1024.0 * 1024.0);
+    g_snprintf(buf, sizeof(buf), "%lld ms · %.1f MB/s",
+               static_cast<long long>(result.ttfb_us / 1000), mb_per_second);
+    return buf;
+}
+
+} // namespace Stremio
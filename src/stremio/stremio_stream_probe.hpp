@@ -0,0 +1,81 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <libsoup/soup.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Stremio {
+
+/**
+ * Measured responsiveness of a single stream source
+ */
+struct ProbeResult {
+    size_t index = 0;               // Index into the probed stream list
+    bool ok = false;                // Got a 2xx response and at least one byte
+    int64_t ttfb_us = -1;           // Request start to response headers
+    int64_t bytes = 0;              // Bytes read from the range
+    double bytes_per_second = 0;    // Body throughput after the headers arrived
+    std::string error;
+};
+
+/**
+ * Probe settings
+ */
+struct ProbeOptions {
+    size_t max_streams = 6;                 // Probe at most the first N HTTP streams
+    size_t range_bytes = 512 * 1024;        // Size of the range request per stream
+    guint timeout_ms = 4000;                // Deadline per probe, partial reads still count
+    int priority = G_PRIORITY_DEFAULT;
+    GCancellable* cancellable = nullptr;    // Cancel to abort all probes (not owned)
+};
+
+/**
+ * Measures time-to-first-byte and throughput of HTTP stream sources with
+ * small concurrent range requests, so streams can be ordered by how fast
+ * they actually deliver. Torrents and external links are not probed.
+ *
+ * Works against any reachable URL, including a local test server.
+ */
+class StreamProbe {
+public:
+    using ResultCallback = std::function<void(const ProbeResult& result)>;
+    using DoneCallback = std::function<void(const std::vector<ProbeResult>& results)>;
+
+    StreamProbe();
+    ~StreamProbe();
+
+    /**
+     * Whether a stream is a direct HTTP(S) source that can be probed
+     */
+    static bool is_probeable(const Stream& stream);
+
+    /**
+     * Probe the first options.max_streams probeable streams concurrently
+     * @param streams Streams in their current order
+     * @param options Range size, deadline, priority and cancellation
+     * @param on_result Called as each probe finishes
+     * @param done Called once with all results, fastest first
+     */
+    void probe(const std::vector<Stream>& streams,
+               const ProbeOptions& options,
+               ResultCallback on_result,
+               DoneCallback done);
+
+    /**
+     * Order results fastest first: successful probes by throughput, then by
+     * TTFB; failed probes last
+     */
+    static void sort_by_speed(std::vector<ProbeResult>& results);
+
+    /**
+     * Short human readable summary, e.g. "120 ms · 8.4 MB/s"
+     */
+    static std::string describe(const ProbeResult& result);
+
+private:
+    SoupSession* session_;
+};
+
+} // namespace Stremio
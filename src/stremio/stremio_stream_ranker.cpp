@@ -0,0 +1,285 @@
+#include "stremio_stream_ranker.hpp"
+#include <glib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace Stremio {
+
+namespace {
+
+// Word boundaries that also treat "." "-" "_" and emoji as separators
+#define WB_START "(?<![0-9a-z])"
+#define WB_END "(?![0-9a-z])"
+
+/**
+ * Matchers for addon naming conventions, compiled once per process
+ */
+struct Matchers {
+    GRegex* resolution;
+    GRegex* codec;
+    GRegex* hdr;
+    GRegex* size;
+    GRegex* seeders;
+    GRegex* cached;
+    GRegex* uncached;
+    GRegex* low_quality;
+
+    static GRegex* compile(const char* pattern) {
+        g_autoptr(GError) error = nullptr;
+        GRegex* regex = g_regex_new(pattern,
+                                    static_cast<GRegexCompileFlags>(G_REGEX_CASELESS | G_REGEX_OPTIMIZE),
+                                    static_cast<GRegexMatchFlags>(0), &error);
+        if (!regex) {
+            g_warning("Stream matcher failed to compile: %s", error ? error->message : pattern);
+        }
+        return regex;
+    }
+
+    Matchers()
+        : resolution(compile(WB_START "(?:(4320|2160|1440|1080|720|576|480|360)[pi]|(8k|4k|uhd|qhd|fhd))" WB_END)),
+          codec(compile(WB_START "(?:(x265|h\\.?265|hevc)|(x264|h\\.?264|avc)|(av1)|(vp9))" WB_END)),
+          hdr(compile(WB_START "(?:hdr10\\+?|hdr|dv|dovi|dolby[ ._-]?vision)" WB_END)),
+          size(compile("([0-9]+(?:[.,][0-9]+)?)[ \\t]*(tb|tib|gb|gib|mb|mib)" WB_END)),
+          seeders(compile("(?:👤|👥|" WB_START "seed(?:er)?s?[: ]+)[ \\t]*([0-9]+)")),
+          cached(compile("\\[[a-z]{2}\\+\\]|⚡|" WB_START "(?:cached|instant)" WB_END)),
+          uncached(compile("\\[[a-z]{2} download\\]|⏳|" WB_START "(?:uncached|not cached)" WB_END)),
+          low_quality(compile(WB_START "(?:cam|camrip|hdcam|hdts|hd-ts|telesync|telecine|screener|dvdscr)" WB_END)) {}
+};
+
+#undef WB_START
+#undef WB_END
+
+const Matchers& matchers() {
+    static const Matchers instance;
+    return instance;
+}
+
+// Run a matcher, returning the match info (caller frees) or nullptr
+GMatchInfo* match(GRegex* regex, const std::string& text) {
+    if (!regex) return nullptr;
+    GMatchInfo* info = nullptr;
+    if (g_regex_match(regex, text.c_str(), static_cast<GRegexMatchFlags>(0), &info)) {
+        return info;
+    }
+    g_match_info_free(info);
+    return nullptr;
+}
+
+bool matches(GRegex* regex, const std::string& text) {
+    return regex && g_regex_match(regex, text.c_str(), static_cast<GRegexMatchFlags>(0), nullptr);
+}
+
+// Whether capture group n took part in the match
+bool group_matched(GMatchInfo* info, int n) {
+    gint start = -1, end = -1;
+    return g_match_info_fetch_pos(info, n, &start, &end) && start >= 0;
+}
+
+bool ranks_before(const RankedStream* a, const RankedStream* b) {
+    if (a->score != b->score) return a->score > b->score;
+    return a->arrival < b->arrival;
+}
+
+} // namespace
+
+StreamTraits StreamRanker::analyze(const Stream& stream) {
+    const Matchers& m = matchers();
+    StreamTraits traits;
+
+    std::string text;
+    if (stream.name) text += *stream.name + "\n";
+    if (stream.title) text += *stream.title + "\n";
+    if (stream.description) text += *stream.description + "\n";
+    if (stream.behavior_hints.filename) text += *stream.behavior_hints.filename;
+
+    if (GMatchInfo* info = match(m.resolution, text)) {
+        if (group_matched(info, 1)) {
+            g_autofree gchar* digits = g_match_info_fetch(info, 1);
+            traits.resolution = atoi(digits);
+        } else {
+            g_autofree gchar* word = g_match_info_fetch(info, 2);
+            g_autofree gchar* lower = g_ascii_strdown(word, -1);
+            if (g_str_equal(lower, "8k")) traits.resolution = 4320;
+            else if (g_str_equal(lower, "qhd")) traits.resolution = 1440;
+            else if (g_str_equal(lower, "fhd")) traits.resolution = 1080;
+            else traits.resolution = 2160;  // 4k, uhd
+        }
+        g_match_info_free(info);
+    }
+
+    if (GMatchInfo* info = match(m.codec, text)) {
+        if (group_matched(info, 1)) traits.codec = VideoCodec::H265;
+        else if (group_matched(info, 2)) traits.codec = VideoCodec::H264;
+        else if (group_matched(info, 3)) traits.codec = VideoCodec::AV1;
+        else traits.codec = VideoCodec::VP9;
+        g_match_info_free(info);
+    }
+
+    traits.hdr = matches(m.hdr, text);
+
+    if (stream.behavior_hints.video_size && *stream.behavior_hints.video_size > 0) {
+        traits.size_bytes = *stream.behavior_hints.video_size;
+    } else if (GMatchInfo* info = match(m.size, text)) {
+        g_autofree gchar* number = g_match_info_fetch(info, 1);
+        g_autofree gchar* unit = g_match_info_fetch(info, 2);
+        g_strdelimit(number, ",", '.');
+        double value = g_ascii_strtod(number, nullptr);
+        double scale = (unit[0] == 't' || unit[0] == 'T') ? 1024.0 * 1024.0 * 1024.0 * 1024.0 :
+                       (unit[0] == 'g' || unit[0] == 'G') ? 1024.0 * 1024.0 * 1024.0 :
+                                                            1024.0 * 1024.0;
+        traits.size_bytes = static_cast<int64_t>(value * scale);
+        g_match_info_free(info);
+    }
+
+    if (GMatchInfo* info = match(m.seeders, text)) {
+        g_autofree gchar* count = g_match_info_fetch(info, 1);
+        traits.seeders = atoi(count);
+        g_match_info_free(info);
+    }
+
+    // "not cached" also contains "cached", so the negative marker wins
+    traits.uncached = matches(m.uncached, text);
+    traits.cached = !traits.uncached && matches(m.cached, text);
+    traits.low_quality = matches(m.low_quality, text);
+
+    return traits;
+}
+
+double StreamRanker::score(const StreamTraits& traits, const Stream& stream) {
+    double score = 0;
+
+    if (traits.resolution >= 2160) score += 40;
+    else if (traits.resolution >= 1440) score += 34;
+    else if (traits.resolution >= 1080) score += 30;
+    else if (traits.resolution >= 720) score += 20;
+    else if (traits.resolution > 0) score += 10;
+    else score += 15;  // Unknown, usually a regular HD release
+
+    if (traits.low_quality) score -= 40;
+    if (traits.hdr) score += 4;
+    if (traits.codec == VideoCodec::H265 || traits.codec == VideoCodec::AV1) score += 2;
+
+    if (traits.cached) {
+        score += 25;
+    } else if (traits.uncached) {
+        score -= 15;
+    }
+
+    bool torrent = stream.info_hash.has_value() && !stream.url.has_value();
+    if (torrent && !traits.cached) {
+        if (traits.seeders == 0) {
+            score -= 25;
+        } else if (traits.seeders > 0) {
+            score += std::min(15.0, 3.0 * std::log2(1.0 + traits.seeders));
+        }
+    }
+
+    // Direct links need no torrent engine; external links can't play in-app
+    if (stream.url.has_value()) {
+        score += 3;
+    } else if (!stream.info_hash.has_value() && !stream.yt_id.has_value()) {
+        score -= 50;
+    }
+
+    if (traits.size_bytes > 0) {
+        score += std::min(5.0, traits.size_bytes / (4.0 * 1024.0 * 1024.0 * 1024.0));
+    }
+
+    return score;
+}
+
+std::string StreamRanker::dedupe_key(const Stream& stream) {
+    if (stream.info_hash) {
+        g_autofree gchar* hash = g_ascii_strdown(stream.info_hash->c_str(), -1);
+        return std::string("bt:") + hash + "/" + std::to_string(stream.file_idx.value_or(-1));
+    }
+    if (stream.url) return *stream.url;
+    if (stream.yt_id) return "yt:" + *stream.yt_id;
+    if (stream.external_url) return "ext:" + *stream.external_url;
+    return "";
+}
+
+std::string StreamRanker::describe(const StreamTraits& traits) {
+    std::vector<std::string> parts;
+
+    if (traits.resolution > 0) parts.push_back(std::to_string(traits.resolution) + "p");
+    if (traits.hdr) parts.push_back("HDR");
+    switch (traits.codec) {
+        case VideoCodec::H265: parts.push_back("HEVC"); break;
+        case VideoCodec::H264: parts.push_back("H.264"); break;
+        case VideoCodec::AV1: parts.push_back("AV1"); break;
+        case VideoCodec::VP9: parts.push_back("VP9"); break;
+        case VideoCodec::Unknown: break;
+    }
+    if (traits.size_bytes > 0) {
+        g_autofree gchar* size = g_format_size_full(traits.size_bytes, G_FORMAT_SIZE_IEC_UNITS);
+        parts.push_back(size);
+    }
+    if (traits.seeders >= 0) parts.push_back(std::to_string(traits.seeders) + " seeders");
+    if (traits.cached) parts.push_back("Cached");
+    else if (traits.uncached) parts.push_back("Not cached");
+
+    std::string result;
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (i > 0) result += " · ";
+        result += parts[i];
+    }
+    return result;
+}
+
+std::vector<const RankedStream*> StreamRanker::add_batch(const Manifest& addon,
+                                                         const std::vector<Stream>& streams,
+                                                         std::vector<const RankedStream*>* folded) {
+    std::vector<const RankedStream*> added;
+    added.reserve(streams.size());
+
+    for (const auto& stream : streams) {
+        std::string key = dedupe_key(stream);
+        if (!key.empty()) {
+            auto it = by_key_.find(key);
+            if (it != by_key_.end()) {
+                RankedStream* existing = it->second;
+                if (existing->addon_id != addon.id &&
+                    std::find(existing->also_from.begin(), existing->also_from.end(), addon.name) ==
+                        existing->also_from.end()) {
+                    existing->also_from.push_back(addon.name);
+                    if (folded) folded->push_back(existing);
+                }
+                continue;
+            }
+        }
+
+        RankedStream& entry = entries_.emplace_back();
+        entry.stream = stream;
+        entry.addon_id = addon.id;
+        entry.addon_name = addon.name;
+        entry.traits = analyze(stream);
+        entry.score = score(entry.traits, stream);
+        if (preference_) {
+            entry.learned = preference_(addon.id, stream);
+            entry.score += entry.learned;
+        }
+        entry.arrival = entries_.size() - 1;
+
+        if (!key.empty()) {
+            by_key_.emplace(std::move(key), &entry);
+        }
+
+        // Newest arrival, so upper_bound keeps earlier streams first on equal score
+        auto pos = std::upper_bound(ranked_.begin(), ranked_.end(), &entry, ranks_before);
+        ranked_.insert(pos, &entry);
+        added.push_back(&entry);
+    }
+
+    std::sort(added.begin(), added.end(), ranks_before);
+    return added;
+}
+
+void StreamRanker::clear() {
+    ranked_.clear();
+    by_key_.clear();
+    entries_.clear();
+}
+
+} // namespace Stremio
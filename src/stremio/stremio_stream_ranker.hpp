@@ -0,0 +1,121 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Stremio {
+
+/**
+ * Video codec detected from stream naming
+ */
+enum class VideoCodec {
+    Unknown,
+    H264,
+    H265,
+    AV1,
+    VP9,
+};
+
+/**
+ * Properties extracted from an addon's free-form name/title/description
+ */
+struct StreamTraits {
+    int resolution = 0;             // Vertical resolution (2160, 1080, ...), 0 if unknown
+    VideoCodec codec = VideoCodec::Unknown;
+    bool hdr = false;               // HDR10, HDR10+ or Dolby Vision
+    int64_t size_bytes = -1;        // From behaviorHints.videoSize or the text
+    int seeders = -1;               // Torrent seeders, -1 if not reported
+    bool cached = false;            // Debrid cached / instantly available
+    bool uncached = false;          // Explicitly needs a debrid download first
+    bool low_quality = false;       // CAM, telesync, screener
+};
+
+/**
+ * A stream as placed in the ranked list
+ */
+struct RankedStream {
+    Stream stream;
+    std::string addon_id;
+    std::string addon_name;
+    StreamTraits traits;
+    double score = 0;
+    double learned = 0;                     // Part of score from past playback outcomes
+    size_t arrival = 0;                     // Order in which it was first seen
+    std::vector<std::string> also_from;     // Other addons offering the same source
+};
+
+/**
+ * Analyzes, deduplicates and ranks streams as addon batches arrive.
+ *
+ * Matchers are compiled once and shared; ranking is updated by inserting
+ * each new stream at its sorted position rather than re-sorting. Finding
+ * the position takes O(log n) comparisons, but the insert shifts the
+ * pointers after it, so a batch is O(batch * n) in pointer moves. Those
+ * are a memmove, which stays cheap at the few thousand streams a title
+ * gets; bench-sdk's rank_streams cases track it.
+ */
+class StreamRanker {
+public:
+    /**
+     * Extra score for a stream from an addon, e.g. learned from how
+     * earlier playbacks from the same source went
+     */
+    using PreferenceFn = std::function<double(const std::string& addon_id, const Stream& stream)>;
+
+    /**
+     * Extract traits from a stream's text and behavior hints
+     */
+    static StreamTraits analyze(const Stream& stream);
+
+    /**
+     * Score used for ordering, higher is better
+     */
+    static double score(const StreamTraits& traits, const Stream& stream);
+
+    /**
+     * Identity of the underlying source: info hash + file index for
+     * torrents, otherwise the URL. Empty if the stream has neither.
+     */
+    static std::string dedupe_key(const Stream& stream);
+
+    /**
+     * Short description of the traits, e.g. "2160p · HDR · HEVC · 12.4 GB"
+     */
+    static std::string describe(const StreamTraits& traits);
+
+    /**
+     * Set the preference hook; applies to streams added afterwards
+     */
+    void set_preference(PreferenceFn preference) { preference_ = std::move(preference); }
+
+    /**
+     * Add one addon's batch
+     * @param folded If set, receives the existing entries this batch
+     *        duplicated, whose also_from gained the addon
+     * @return Newly added entries (duplicates are folded into the existing
+     *         entry's also_from), in ranked order. Pointers stay valid until clear().
+     */
+    std::vector<const RankedStream*> add_batch(const Manifest& addon, const std::vector<Stream>& streams,
+                                               std::vector<const RankedStream*>* folded = nullptr);
+
+    /**
+     * All streams, best first
+     */
+    const std::vector<const RankedStream*>& ranked() const { return ranked_; }
+
+    size_t size() const { return ranked_.size(); }
+
+    void clear();
+
+private:
+    std::deque<RankedStream> entries_;              // Stable addresses
+    std::vector<const RankedStream*> ranked_;
+    std::unordered_map<std::string, RankedStream*> by_key_;
+    PreferenceFn preference_;
+};
+
+} // namespace Stremio
@@ -4,6 +4,7 @@
 #include <vector>
 #include <optional>
 #include <map>
+#include <memory>
 #include <json-glib/json-glib.h>
 
 namespace Stremio {
@@ -16,6 +17,7 @@ struct Subtitle;
 struct Video;
 struct Catalog;
 struct Manifest;
+class VideoIndex;
 
 /**
  * Catalog definition in manifest
@@ -143,11 +145,13 @@ struct Meta {
     std::vector<std::string> cast;
     std::vector<std::string> writer;
     std::vector<MetaLink> links;
-    std::vector<Video> videos;
+    std::shared_ptr<VideoIndex> videos;  // Parsed per season on demand, null if none
     std::vector<Trailer> trailers;
     
     // Behavior hints
     std::optional<std::string> default_video_id;
+    
+    bool has_videos() const;
 };
 
 /**
@@ -198,6 +202,7 @@ struct Stream {
  */
 struct CatalogResponse {
     std::vector<MetaPreview> metas;
+    std::optional<int> cache_max_age;  // Seconds the addon allows caching for
 };
 
 /**
@@ -205,6 +210,7 @@ struct CatalogResponse {
  */
 struct MetaResponse {
     Meta meta;
+    std::optional<int> cache_max_age;  // Seconds the addon allows caching for
 };
 
 /**
@@ -233,4 +239,18 @@ struct ExtraArgs {
     std::string to_path_segment() const;
 };
 
+/**
+ * Lookup counters of a two-tier cache, for diagnostics
+ */
+struct CacheStats {
+    uint64_t memory_hits = 0;
+    uint64_t disk_hits = 0;
+    uint64_t misses = 0;
+    
+    double hit_rate() const {
+        uint64_t total = memory_hits + disk_hits + misses;
+        return total > 0 ? static_cast<double>(memory_hits + disk_hits) / total : 0.0;
+    }
+};
+
 } // namespace Stremio
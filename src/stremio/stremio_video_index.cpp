@@ -0,0 +1,102 @@
+#include "stremio_video_index.hpp"
+#include "stremio_parser.hpp"
+
+namespace Stremio {
+
+VideoIndex::VideoIndex(JsonArray* videos) {
+    guint len = json_array_get_length(videos);
+    refs_.reserve(len);
+
+    // Only id, season and episode are read here; titles, overviews and
+    // embedded streams wait until their season is shown
+    std::map<int, JsonArray*> elements;
+    for (guint i = 0; i < len; i++) {
+        JsonNode* node = json_array_get_element(videos, i);
+        if (json_node_get_node_type(node) != JSON_NODE_OBJECT) continue;
+
+        JsonObject* obj = json_node_get_object(node);
+        VideoRef ref;
+        ref.id = Parser::get_string(obj, "id");
+        ref.season = Parser::get_optional_int(obj, "season");
+        ref.episode = Parser::get_optional_int(obj, "episode");
+
+        JsonArray*& season = elements[season_key(ref.season)];
+        if (!season) season = json_array_new();
+        json_array_add_element(season, json_node_copy(node));
+        refs_.push_back(std::move(ref));
+    }
+
+    // Text is a fraction of the size of the tree it came from, which the
+    // caller drops once the meta is parsed
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    for (auto& [number, array] : elements) {
+        Season& season = seasons_[number];
+        season.count = json_array_get_length(array);
+
+        g_autoptr(JsonNode) root = json_node_init_array(json_node_alloc(), array);
+        json_generator_set_root(generator, root);
+        gsize length = 0;
+        g_autofree gchar* text = json_generator_to_data(generator, &length);
+        season.json.assign(text, length);
+        json_array_unref(array);
+    }
+}
+
+std::vector<int> VideoIndex::seasons() const {
+    std::vector<int> result;
+    result.reserve(seasons_.size());
+    for (const auto& [number, season] : seasons_) {
+        result.push_back(number);
+    }
+    return result;
+}
+
+size_t VideoIndex::season_size(int season) const {
+    auto it = seasons_.find(season);
+    return it != seasons_.end() ? it->second.count : 0;
+}
+
+const std::vector<Video>& VideoIndex::season(int number) {
+    static const std::vector<Video> none;
+
+    auto it = seasons_.find(number);
+    if (it == seasons_.end()) return none;
+
+    Season& season = it->second;
+    if (season.videos) return *season.videos;
+
+    std::vector<Video> videos;
+    videos.reserve(season.count);
+    g_autoptr(JsonParser) parser = json_parser_new();
+    if (json_parser_load_from_data(parser, season.json.data(), static_cast<gssize>(season.json.size()), nullptr)) {
+        JsonArray* array = json_node_get_array(json_parser_get_root(parser));
+        guint len = json_array_get_length(array);
+        for (guint i = 0; i < len; i++) {
+            videos.push_back(Parser::parse_video(json_array_get_object_element(array, i)));
+        }
+    }
+    season.videos = std::move(videos);
+
+    // Parsed; the text is no longer needed
+    std::string().swap(season.json);
+
+    return *season.videos;
+}
+
+const Video* VideoIndex::find(const std::string& id) {
+    for (const auto& ref : refs_) {
+        if (ref.id != id) continue;
+
+        for (const auto& video : season(season_key(ref.season))) {
+            if (video.id == id) return &video;
+        }
+        break;
+    }
+    return nullptr;
+}
+
+bool Meta::has_videos() const {
+    return videos && !videos->empty();
+}
+
+} // namespace Stremio
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "stremio_types.hpp"
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Stremio {
+
+/**
+ * Identity of a video, read without parsing the rest of it
+ */
+struct VideoRef {
+    std::string id;
+    std::optional<int> season;
+    std::optional<int> episode;
+};
+
+/**
+ * Videos of a meta, indexed by season in one pass over the response and
+ * parsed into full Video objects (streams included) a season at a time, on
+ * first use.
+ *
+ * The response's JSON tree is not kept: each season is held as compact JSON
+ * text until it is materialized, so seasons never opened cost their text
+ * and the index only. Videos without a season number are grouped under
+ * season 1. Not thread-safe; use from the main loop.
+ */
+class VideoIndex {
+public:
+    explicit VideoIndex(JsonArray* videos);
+
+    VideoIndex(const VideoIndex&) = delete;
+    VideoIndex& operator=(const VideoIndex&) = delete;
+
+    bool empty() const { return refs_.empty(); }
+    size_t size() const { return refs_.size(); }
+
+    /**
+     * Every video's id, season and episode, in response order
+     */
+    const std::vector<VideoRef>& refs() const { return refs_; }
+
+    /**
+     * Season numbers, ascending
+     */
+    std::vector<int> seasons() const;
+
+    /**
+     * Number of videos in a season, without materializing it
+     */
+    size_t season_size(int season) const;
+
+    /**
+     * Full videos of a season in response order, parsed on first call.
+     * Empty for an unknown season.
+     */
+    const std::vector<Video>& season(int season);
+
+    /**
+     * Video by id, materializing its season. nullptr if not found.
+     */
+    const Video* find(const std::string& id);
+
+private:
+    struct Season {
+        size_t count = 0;
+        std::string json;                         // The season's videos as an array, until materialized
+        std::optional<std::vector<Video>> videos; // Set once materialized
+    };
+
+    std::vector<VideoRef> refs_;
+    std::map<int, Season> seasons_;
+
+    static int season_key(const std::optional<int>& season) { return season.value_or(1); }
+};
+
+} // namespace Stremio
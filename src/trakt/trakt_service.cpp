@@ -1,5 +1,8 @@
 #include "trakt_service.hpp"
 #include "trakt_types.hpp"
+#include "../profiler.hpp"
+#include "../log.hpp"
+#include "../transport.hpp"
 
 #include <json-glib/json-glib.h>
 #include <libsoup/soup.h>
@@ -140,11 +143,25 @@ static Episode parse_episode(JsonObject* obj) {
     return ep;
 }
 
-TraktService::TraktService() {
+// Settings before anything is saved
+static TraktConfig default_config() {
+    TraktConfig config{};
+    config.enabled = false;
+    config.sync_watchlist = true;
+    config.sync_history = true;
+    config.sync_progress = true;
+    return config;
+}
+
+TraktService::TraktService()
+    : config_(default_config()),
+      cancellable_(g_cancellable_new()) {
     storage_path_ = get_storage_path();
 }
 
 TraktService::~TraktService() {
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
     save();
 }
 
@@ -155,63 +172,114 @@ std::string TraktService::get_storage_path() {
     return dir + "/trakt.json";
 }
 
-void TraktService::load() {
-    config_ = TraktConfig{};
-    config_.enabled = false;
-    config_.sync_watchlist = true;
-    config_.sync_history = true;
-    config_.sync_progress = true;
+// Parse the saved config; touches no service state, so it runs on a worker
+static TraktConfig read_config(const std::string& path) {
+    Madari::ProfileSpan span("load trakt config", "services");
+    TraktConfig config = default_config();
     
     g_autoptr(JsonParser) parser = json_parser_new();
     g_autoptr(GError) error = nullptr;
     
-    if (!json_parser_load_from_file(parser, storage_path_.c_str(), &error)) {
+    if (!json_parser_load_from_file(parser, path.c_str(), &error)) {
         g_info("No Trakt config found: %s", error ? error->message : "unknown");
-        return;
+        return config;
     }
     
     JsonNode* root = json_parser_get_root(parser);
-    if (!root || !JSON_NODE_HOLDS_OBJECT(root)) return;
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root)) return config;
     
     JsonObject* obj = json_node_get_object(root);
     
     if (json_object_has_member(obj, "client_id")) {
         const char* s = json_object_get_string_member(obj, "client_id");
-        if (s) config_.client_id = s;
+        if (s) config.client_id = s;
     }
     if (json_object_has_member(obj, "client_secret")) {
         const char* s = json_object_get_string_member(obj, "client_secret");
-        if (s) config_.client_secret = s;
+        if (s) config.client_secret = s;
     }
     if (json_object_has_member(obj, "access_token")) {
         const char* s = json_object_get_string_member(obj, "access_token");
-        if (s) config_.access_token = s;
+        if (s) config.access_token = s;
     }
     if (json_object_has_member(obj, "refresh_token")) {
         const char* s = json_object_get_string_member(obj, "refresh_token");
-        if (s) config_.refresh_token = s;
+        if (s) config.refresh_token = s;
     }
     if (json_object_has_member(obj, "expires_at"))
-        config_.expires_at = json_object_get_int_member(obj, "expires_at");
+        config.expires_at = json_object_get_int_member(obj, "expires_at");
     if (json_object_has_member(obj, "enabled"))
-        config_.enabled = json_object_get_boolean_member(obj, "enabled");
+        config.enabled = json_object_get_boolean_member(obj, "enabled");
     if (json_object_has_member(obj, "sync_watchlist"))
-        config_.sync_watchlist = json_object_get_boolean_member(obj, "sync_watchlist");
+        config.sync_watchlist = json_object_get_boolean_member(obj, "sync_watchlist");
     if (json_object_has_member(obj, "sync_history"))
-        config_.sync_history = json_object_get_boolean_member(obj, "sync_history");
+        config.sync_history = json_object_get_boolean_member(obj, "sync_history");
     if (json_object_has_member(obj, "sync_progress"))
-        config_.sync_progress = json_object_get_boolean_member(obj, "sync_progress");
+        config.sync_progress = json_object_get_boolean_member(obj, "sync_progress");
     if (json_object_has_member(obj, "username")) {
         const char* s = json_object_get_string_member(obj, "username");
-        if (s && strlen(s) > 0) config_.username = s;
+        if (s && strlen(s) > 0) config.username = s;
     }
     if (json_object_has_member(obj, "avatar_url")) {
         const char* s = json_object_get_string_member(obj, "avatar_url");
-        if (s && strlen(s) > 0) config_.avatar_url = s;
+        if (s && strlen(s) > 0) config.avatar_url = s;
+    }
+    return config;
+}
+
+void TraktService::load() {
+    config_ = read_config(storage_path_);
+    set_ready();
+}
+
+void TraktService::load_async() {
+    struct ConfigRead {
+        std::string path;
+        TraktConfig config;
+    };
+    
+    GTask* task = g_task_new(nullptr, cancellable_,
+        [](GObject*, GAsyncResult* result, gpointer user_data) {
+            // Cancelled when the service went away first
+            if (g_task_had_error(G_TASK(result))) return;
+            
+            auto* self = static_cast<TraktService*>(user_data);
+            auto* read = static_cast<ConfigRead*>(g_task_get_task_data(G_TASK(result)));
+            self->config_ = std::move(read->config);
+            self->set_ready();
+            self->notify_change();
+        }, this);
+    g_task_set_task_data(task, new ConfigRead{storage_path_, {}},
+                         [](gpointer d) { delete static_cast<ConfigRead*>(d); });
+    g_task_run_in_thread(task, [](GTask* task, gpointer, gpointer task_data, GCancellable*) {
+        auto* read = static_cast<ConfigRead*>(task_data);
+        read->config = read_config(read->path);
+        g_task_return_boolean(task, TRUE);
+    });
+    g_object_unref(task);
+}
+
+void TraktService::when_ready(ReadyCallback callback) {
+    if (ready_) {
+        callback();
+        return;
+    }
+    ready_callbacks_.push_back(std::move(callback));
+}
+
+void TraktService::set_ready() {
+    ready_ = true;
+    auto callbacks = std::move(ready_callbacks_);
+    ready_callbacks_.clear();
+    for (const auto& callback : callbacks) {
+        callback();
     }
 }
 
 void TraktService::save() {
+    // Nothing to write over the saved config until it has been read
+    if (!ready_) return;
+    
     g_autoptr(JsonBuilder) builder = json_builder_new();
     
     json_builder_begin_object(builder);
@@ -326,42 +394,27 @@ void TraktService::make_request(const std::string& method, const std::string& en
         soup_message_headers_append(headers, "Authorization", auth.c_str());
     }
     
+    g_autoptr(GBytes) request_body = nullptr;
     if (!body.empty()) {
-        GBytes* bytes = g_bytes_new(body.c_str(), body.size());
-        soup_message_set_request_body_from_bytes(msg, "application/json", bytes);
-        g_bytes_unref(bytes);
+        request_body = g_bytes_new(body.c_str(), body.size());
+        soup_message_set_request_body_from_bytes(msg, "application/json", request_body);
     }
     
     // Create session for request
     SoupSession* session = soup_session_new();
     
-    struct RequestData {
-        std::function<void(const std::string&, int, const std::string&)> callback;
-        SoupSession* session;
-        SoupMessage* msg;
-    };
-    
-    RequestData* data = new RequestData{callback, session, msg};
-    
-    soup_session_send_and_read_async(session, msg, G_PRIORITY_DEFAULT, nullptr,
-        [](GObject* source, GAsyncResult* result, gpointer user_data) {
-            RequestData* data = static_cast<RequestData*>(user_data);
-            
-            g_autoptr(GError) error = nullptr;
-            GBytes* bytes = soup_session_send_and_read_finish(SOUP_SESSION(source), result, &error);
-            
+    Madari::Transport::send_and_read(session, msg, G_PRIORITY_DEFAULT, nullptr,
+        [callback, session](GBytes* bytes, guint status, const GError* error) {
             if (error) {
                 g_warning("[Trakt] Request error: %s", error->message);
-                data->callback("", 0, error->message);
+                callback("", 0, error->message);
             } else {
-                gsize size;
-                const char* response_data = static_cast<const char*>(g_bytes_get_data(bytes, &size));
-                std::string response(response_data, size);
-                
-                guint status = soup_message_get_status(data->msg);
+                gsize size = 0;
+                const char* response_data = bytes ? static_cast<const char*>(g_bytes_get_data(bytes, &size)) : nullptr;
+                std::string response(response_data ? response_data : "", size);
                 
                 if (status >= 200 && status < 300) {
-                    data->callback(response, status, "");
+                    callback(response, status, "");
                 } else {
                     std::string err = "HTTP " + std::to_string(status);
                     // Try to parse error message from response
@@ -381,16 +434,14 @@ void TraktService::make_request(const std::string& method, const std::string& en
                         }
                     }
                     g_warning("[Trakt] Request failed: %s", err.c_str());
-                    data->callback(response, status, err);
+                    callback(response, status, err);
                 }
-                
-                g_bytes_unref(bytes);
             }
             
-            g_object_unref(data->session);
-            g_object_unref(data->msg);
-            delete data;
-        }, data);
+            g_object_unref(session);
+        }, request_body);
+    
+    g_object_unref(msg);
 }
 
 void TraktService::ensure_valid_token(std::function<void(bool valid)> callback) {
@@ -1571,7 +1622,7 @@ void TraktService::scrobble_start(const std::string& content_type, const Content
         }
         
         std::string body = build_scrobble_body(content_type, ids, progress);
-        g_print("[Trakt] Scrobble start: %s\n", body.c_str());
+        MADARI_LOG_DEBUG("trakt", "scrobble start", {"body", body});
         
         make_request("POST", "/scrobble/start", body, true,
             [callback](const std::string& response, int status, const std::string& error) {
@@ -1579,7 +1630,7 @@ void TraktService::scrobble_start(const std::string& content_type, const Content
                     g_warning("[Trakt] Scrobble start failed: %s (status: %d)", error.c_str(), status);
                     callback(false, error);
                 } else {
-                    g_print("[Trakt] Scrobble start success\n");
+                    MADARI_LOG_DEBUG("trakt", "scrobble start done");
                     callback(true, "");
                 }
             });
@@ -1600,7 +1651,7 @@ void TraktService::scrobble_pause(const std::string& content_type, const Content
         }
         
         std::string body = build_scrobble_body(content_type, ids, progress);
-        g_print("[Trakt] Scrobble pause: %s\n", body.c_str());
+        MADARI_LOG_DEBUG("trakt", "scrobble pause", {"body", body});
         
         make_request("POST", "/scrobble/pause", body, true,
             [callback](const std::string& response, int status, const std::string& error) {
@@ -1608,7 +1659,7 @@ void TraktService::scrobble_pause(const std::string& content_type, const Content
                     g_warning("[Trakt] Scrobble pause failed: %s (status: %d)", error.c_str(), status);
                     callback(false, error);
                 } else {
-                    g_print("[Trakt] Scrobble pause success\n");
+                    MADARI_LOG_DEBUG("trakt", "scrobble pause done");
                     callback(true, "");
                 }
             });
@@ -1629,7 +1680,7 @@ void TraktService::scrobble_stop(const std::string& content_type, const ContentI
         }
         
         std::string body = build_scrobble_body(content_type, ids, progress);
-        g_print("[Trakt] Scrobble stop (progress: %.1f%%): %s\n", progress, body.c_str());
+        MADARI_LOG_DEBUG("trakt", "scrobble stop", {"progress", progress}, {"body", body});
         
         make_request("POST", "/scrobble/stop", body, true,
             [callback, progress](const std::string& response, int status, const std::string& error) {
@@ -1637,11 +1688,7 @@ void TraktService::scrobble_stop(const std::string& content_type, const ContentI
                     g_warning("[Trakt] Scrobble stop failed: %s (status: %d)", error.c_str(), status);
                     callback(false, error);
                 } else {
-                    if (progress >= 80.0) {
-                        g_print("[Trakt] Scrobble stop success - marked as watched\n");
-                    } else {
-                        g_print("[Trakt] Scrobble stop success - saved progress\n");
-                    }
+                    MADARI_LOG_DEBUG("trakt", "scrobble stop done", {"watched", progress >= 80.0});
                     callback(true, "");
                 }
             });
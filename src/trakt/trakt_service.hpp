@@ -1,6 +1,7 @@
 #pragma once
 
 #include "trakt_types.hpp"
+#include <gio/gio.h>
 #include <functional>
 #include <memory>
 #include <string>
@@ -16,6 +17,7 @@ class TraktService {
 public:
     // Callback types
     using ConfigChangedCallback = std::function<void()>;
+    using ReadyCallback = std::function<void()>;
     using AuthCallback = std::function<void(bool success, const std::string& error)>;
     using DeviceCodeCallback = std::function<void(std::optional<DeviceCode> code, const std::string& error)>;
     using TokenPollCallback = std::function<void(bool success, bool pending, const std::string& error)>;
@@ -39,6 +41,22 @@ public:
      */
     void load();
     
+    /**
+     * Load configuration on a worker thread; config change callbacks fire
+     * once it is in
+     */
+    void load_async();
+    
+    /**
+     * Whether the saved configuration has been loaded
+     */
+    bool is_ready() const { return ready_; }
+    
+    /**
+     * Run a callback once the configuration is loaded (right away if it is)
+     */
+    void when_ready(ReadyCallback callback);
+    
     /**
      * Save configuration to storage
      */
@@ -206,9 +224,13 @@ public:
 private:
     TraktConfig config_;
     std::vector<ConfigChangedCallback> change_callbacks_;
+    std::vector<ReadyCallback> ready_callbacks_;
     std::string storage_path_;
+    GCancellable* cancellable_;
+    bool ready_ = false;
     
     void notify_change();
+    void set_ready();
     std::string get_storage_path();
     
     // Internal HTTP request helper
@@ -0,0 +1,476 @@
+#include "transport.hpp"
+#include "log.hpp"
+#include <json-glib/json-glib.h>
+#include <algorithm>
+#include <cstring>
+
+namespace Madari {
+
+namespace {
+
+struct State {
+    Transport::Mode mode = Transport::Mode::Live;
+    std::string dir;
+    bool recorded_timing = true;
+    std::vector<FaultRule> faults;
+    GRand* rand = g_rand_new_with_seed(1);
+};
+
+State& state() {
+    static State instance;
+    return instance;
+}
+
+struct Request {
+    Transport::Callback callback;
+    SoupMessage* msg = nullptr;
+    GCancellable* cancellable = nullptr;
+    std::string url;
+    std::string archive_path;       // Record and replay only
+    gint64 started;
+
+    // Added by the matching fault rule
+    guint delay_ms = 0;
+    guint64 bandwidth = 0;
+
+    // The outcome, held while a delay runs
+    GBytes* body = nullptr;
+    guint status = 0;
+    GError* error = nullptr;
+    guint source = 0;
+    gulong cancelled_handler = 0;
+
+    ~Request() {
+        if (body) g_bytes_unref(body);
+        g_clear_error(&error);
+        g_clear_object(&msg);
+        g_clear_object(&cancellable);
+    }
+};
+
+// "example.com" covers api.example.com too
+bool host_matches(const std::string& pattern, const char* host) {
+    if (pattern == "*") return true;
+    if (!host) return false;
+    size_t host_length = strlen(host);
+    if (host_length == pattern.size()) return pattern == host;
+    return host_length > pattern.size() &&
+           host[host_length - pattern.size() - 1] == '.' &&
+           pattern == host + host_length - pattern.size();
+}
+
+const FaultRule* match_rule(const char* host) {
+    for (const auto& rule : state().faults) {
+        if (host_matches(rule.host, host)) return &rule;
+    }
+    return nullptr;
+}
+
+// Request body members that change from run to run: playback progress,
+// timestamps, and tokens and codes that come from recorded (redacted)
+// responses when replaying
+const char* const VOLATILE_MEMBERS[] = {"progress", "watched_at", "refresh_token", "token", "code"};
+
+void drop_volatile_members(JsonNode* node) {
+    if (JSON_NODE_HOLDS_ARRAY(node)) {
+        JsonArray* array = json_node_get_array(node);
+        for (guint i = 0; i < json_array_get_length(array); i++) {
+            drop_volatile_members(json_array_get_element(array, i));
+        }
+    } else if (JSON_NODE_HOLDS_OBJECT(node)) {
+        JsonObject* object = json_node_get_object(node);
+        for (const char* member : VOLATILE_MEMBERS) {
+            if (json_object_has_member(object, member)) json_object_remove_member(object, member);
+        }
+        JsonObjectIter iter;
+        JsonNode* value;
+        json_object_iter_init(&iter, object);
+        while (json_object_iter_next(&iter, nullptr, &value)) {
+            drop_volatile_members(value);
+        }
+    }
+}
+
+// What of a request body identifies the request: JSON without its volatile
+// members, other bodies as they are
+std::string body_key(GBytes* body) {
+    gsize size = 0;
+    const char* data = static_cast<const char*>(g_bytes_get_data(body, &size));
+    g_autoptr(JsonParser) parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, data, static_cast<gssize>(size), nullptr)) {
+        return std::string(data, size);
+    }
+
+    JsonNode* root = json_parser_get_root(parser);
+    if (!root) return std::string(data, size);
+    drop_volatile_members(root);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    json_generator_set_root(generator, root);
+    gsize length = 0;
+    g_autofree gchar* text = json_generator_to_data(generator, &length);
+    return std::string(text, length);
+}
+
+// One file per request: a line of JSON with the URL, status and timing,
+// then the body as received. POSTs to one URL (scrobbles of different
+// items) differ by body; repeats of the same one share a file.
+std::string archive_path(SoupMessage* msg, const std::string& url, GBytes* request_body) {
+    std::string key = std::string(soup_message_get_method(msg)) + " " + url;
+    if (request_body && g_bytes_get_size(request_body) > 0) {
+        key += "\n" + body_key(request_body);
+    }
+    g_autofree gchar* hash = g_compute_checksum_for_string(G_CHECKSUM_SHA1, key.c_str(), static_cast<gssize>(key.size()));
+    return state().dir + "/" + hash + ".http";
+}
+
+// Members of OAuth responses that would let a recording sign in as the user
+const char* const SECRET_MEMBERS[] = {"access_token", "refresh_token", "device_code"};
+
+bool is_oauth(SoupMessage* msg) {
+    const char* path = g_uri_get_path(soup_message_get_uri(msg));
+    return path && strstr(path, "/oauth/") != nullptr;
+}
+
+// The body with its secrets replaced, or nothing if it can't be parsed
+GBytes* redact_secrets(GBytes* body) {
+    gsize size = 0;
+    const char* data = static_cast<const char*>(g_bytes_get_data(body, &size));
+    g_autoptr(JsonParser) parser = json_parser_new();
+    if (!json_parser_load_from_data(parser, data, static_cast<gssize>(size), nullptr)) return nullptr;
+
+    JsonNode* root = json_parser_get_root(parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT(root)) return nullptr;
+    JsonObject* object = json_node_get_object(root);
+    for (const char* member : SECRET_MEMBERS) {
+        if (json_object_has_member(object, member)) json_object_set_string_member(object, member, "redacted");
+    }
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    json_generator_set_root(generator, root);
+    gsize length = 0;
+    gchar* text = json_generator_to_data(generator, &length);
+    return g_bytes_new_take(text, length);
+}
+
+void finish(Request* req) {
+    req->callback(req->body, req->status, req->error);
+    delete req;
+}
+
+gboolean on_delay_done(gpointer user_data) {
+    Request* req = static_cast<Request*>(user_data);
+    req->source = 0;
+    if (req->cancellable && req->cancelled_handler) {
+        g_cancellable_disconnect(req->cancellable, req->cancelled_handler);
+    }
+    if (g_cancellable_is_cancelled(req->cancellable) && !req->error) {
+        g_clear_pointer(&req->body, g_bytes_unref);
+        req->status = 0;
+        g_cancellable_set_error_if_cancelled(req->cancellable, &req->error);
+    }
+    finish(req);
+    return G_SOURCE_REMOVE;
+}
+
+// Can't disconnect from inside the handler, so finish from an idle
+void on_delay_cancelled(GCancellable*, gpointer user_data) {
+    Request* req = static_cast<Request*>(user_data);
+    if (!req->source) return;
+    g_source_remove(req->source);
+    req->source = g_idle_add(on_delay_done, req);
+}
+
+// Deliver the outcome once the simulated conditions allow
+void complete(Request* req, gint64 recorded_us = 0) {
+    gint64 elapsed_us = g_get_monotonic_time() - req->started;
+    gint64 due_us = recorded_us + req->delay_ms * gint64(1000);
+    if (req->bandwidth && req->body) {
+        due_us += gint64(g_bytes_get_size(req->body) * G_USEC_PER_SEC / req->bandwidth);
+    }
+    if (due_us <= elapsed_us) {
+        finish(req);
+        return;
+    }
+
+    req->source = g_timeout_add(static_cast<guint>((due_us - elapsed_us) / 1000), on_delay_done, req);
+    if (req->cancellable) {
+        req->cancelled_handler = g_cancellable_connect(req->cancellable, G_CALLBACK(on_delay_cancelled), req, nullptr);
+    }
+}
+
+// Injected failures never reach the network, but still answer asynchronously
+void fail_later(Request* req, guint delay_ms, guint status, GError* error) {
+    req->status = status;
+    req->error = error;
+    req->started = g_get_monotonic_time();
+    req->delay_ms = std::max(delay_ms, 1u);
+    req->bandwidth = 0;
+    complete(req);
+}
+
+void record(Request* req, gint64 elapsed_us) {
+    g_autoptr(GBytes) body = req->body ? g_bytes_ref(req->body) : nullptr;
+    bool redacted = req->body && is_oauth(req->msg);
+    if (redacted) {
+        g_bytes_unref(body);
+        body = redact_secrets(req->body);
+    }
+
+    g_autoptr(JsonBuilder) builder = json_builder_new();
+    json_builder_begin_object(builder);
+    json_builder_set_member_name(builder, "method");
+    json_builder_add_string_value(builder, soup_message_get_method(req->msg));
+    json_builder_set_member_name(builder, "url");
+    json_builder_add_string_value(builder, req->url.c_str());
+    json_builder_set_member_name(builder, "status");
+    json_builder_add_int_value(builder, req->status);
+    json_builder_set_member_name(builder, "elapsed_us");
+    json_builder_add_int_value(builder, elapsed_us);
+    if (redacted) {
+        json_builder_set_member_name(builder, "redacted");
+        json_builder_add_boolean_value(builder, TRUE);
+    }
+    json_builder_end_object(builder);
+
+    g_autoptr(JsonGenerator) generator = json_generator_new();
+    g_autoptr(JsonNode) root = json_builder_get_root(builder);
+    json_generator_set_root(generator, root);
+    gsize header_length = 0;
+    g_autofree gchar* header = json_generator_to_data(generator, &header_length);
+
+    GByteArray* data = g_byte_array_new();
+    g_byte_array_append(data, reinterpret_cast<const guint8*>(header), header_length);
+    g_byte_array_append(data, reinterpret_cast<const guint8*>("\n"), 1);
+    if (body) {
+        g_byte_array_append(data, static_cast<const guint8*>(g_bytes_get_data(body, nullptr)),
+                            g_bytes_get_size(body));
+    }
+    g_autoptr(GBytes) bytes = g_byte_array_free_to_bytes(data);
+
+    g_autoptr(GFile) file = g_file_new_for_path(req->archive_path.c_str());
+    g_file_replace_contents_bytes_async(file, bytes, nullptr, FALSE, G_FILE_CREATE_NONE, nullptr,
+        [](GObject* source, GAsyncResult* result, gpointer) {
+            g_autoptr(GError) error = nullptr;
+            if (!g_file_replace_contents_finish(G_FILE(source), result, nullptr, &error)) {
+                g_warning("Failed to record response: %s", error->message);
+            }
+        }, nullptr);
+}
+
+void on_sent(GObject* source, GAsyncResult* result, gpointer user_data) {
+    Request* req = static_cast<Request*>(user_data);
+    req->body = soup_session_send_and_read_finish(SOUP_SESSION(source), result, &req->error);
+    if (!req->error) {
+        req->status = soup_message_get_status(req->msg);
+        if (state().mode == Transport::Mode::Record) {
+            record(req, g_get_monotonic_time() - req->started);
+        }
+    }
+    complete(req);
+}
+
+void on_replay_loaded(GObject* source, GAsyncResult* result, gpointer user_data) {
+    Request* req = static_cast<Request*>(user_data);
+    g_autoptr(GBytes) data = g_file_load_bytes_finish(G_FILE(source), result, nullptr, &req->error);
+    if (!data) {
+        if (g_error_matches(req->error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND)) {
+            MADARI_LOG_DEBUG("transport", "not in recording", {"url", req->url});
+            g_clear_error(&req->error);
+            g_set_error(&req->error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND, "Not in recording: %s", req->url.c_str());
+        }
+        complete(req);
+        return;
+    }
+
+    gsize size = 0;
+    const char* bytes = static_cast<const char*>(g_bytes_get_data(data, &size));
+    const char* newline = size ? static_cast<const char*>(memchr(bytes, '\n', size)) : nullptr;
+    g_autoptr(JsonParser) parser = json_parser_new();
+    if (!newline || !json_parser_load_from_data(parser, bytes, newline - bytes, nullptr) ||
+        !JSON_NODE_HOLDS_OBJECT(json_parser_get_root(parser))) {
+        g_set_error(&req->error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Bad recording for %s", req->url.c_str());
+        complete(req);
+        return;
+    }
+
+    JsonObject* header = json_node_get_object(json_parser_get_root(parser));
+    req->status = static_cast<guint>(json_object_get_int_member_with_default(header, "status", 0));
+    gint64 elapsed_us = json_object_get_int_member_with_default(header, "elapsed_us", 0);
+    gsize offset = newline - bytes + 1;
+    req->body = g_bytes_new_from_bytes(data, offset, size - offset);
+    complete(req, state().recorded_timing ? elapsed_us : 0);
+}
+
+bool parse_rate(const char* text, double* rate) {
+    char* end = nullptr;
+    *rate = g_ascii_strtod(text, &end);
+    return end != text && *rate >= 0 && *rate <= 1;
+}
+
+bool parse_rule_field(FaultRule* rule, const char* key, const char* value) {
+    guint64 number = 0;
+    char* end = nullptr;
+    if (strcmp(key, "host") == 0) {
+        rule->host = value;
+        return *value != '\0';
+    }
+    if (strcmp(key, "latency") == 0) {
+        if (!g_ascii_string_to_unsigned(value, 10, 0, G_MAXUINT32, &number, nullptr)) return false;
+        rule->latency_ms = static_cast<guint>(number);
+        return true;
+    }
+    if (strcmp(key, "jitter") == 0) {
+        if (!g_ascii_string_to_unsigned(value, 10, 0, G_MAXUINT32, &number, nullptr)) return false;
+        rule->jitter_ms = static_cast<guint>(number);
+        return true;
+    }
+    if (strcmp(key, "bandwidth") == 0) {
+        number = g_ascii_strtoull(value, &end, 10);
+        if (end == value) return false;
+        if (g_ascii_tolower(*end) == 'k') {
+            number *= 1024;
+            end++;
+        } else if (g_ascii_tolower(*end) == 'm') {
+            number *= 1024 * 1024;
+            end++;
+        }
+        rule->bandwidth = number;
+        return number > 0 && *end == '\0';
+    }
+    if (strcmp(key, "error") == 0 || strcmp(key, "timeout") == 0) {
+        // STATUS@RATE for errors, RATE or RATE@MS for timeouts
+        g_auto(GStrv) parts = g_strsplit(value, "@", 2);
+        if (strcmp(key, "error") == 0) {
+            if (!parts[1] || !g_ascii_string_to_unsigned(parts[0], 10, 100, 599, &number, nullptr)) return false;
+            rule->error_status = static_cast<guint>(number);
+            return parse_rate(parts[1], &rule->error_rate);
+        }
+        if (!parse_rate(parts[0], &rule->timeout_rate)) return false;
+        if (!parts[1]) return true;
+        if (!g_ascii_string_to_unsigned(parts[1], 10, 0, G_MAXUINT32, &number, nullptr)) return false;
+        rule->timeout_ms = static_cast<guint>(number);
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void Transport::init() {
+    const char* transport = g_getenv("MADARI_TRANSPORT");
+    if (transport && *transport) {
+        g_auto(GStrv) parts = g_strsplit(transport, ":", 2);
+        if (parts[1] && strcmp(parts[0], "record") == 0) {
+            set_record(parts[1]);
+        } else if (parts[1] && strcmp(parts[0], "replay") == 0) {
+            set_replay(parts[1], true);
+        } else if (parts[1] && strcmp(parts[0], "replay-instant") == 0) {
+            set_replay(parts[1], false);
+        } else if (strcmp(transport, "live") != 0) {
+            g_warning("Unknown MADARI_TRANSPORT '%s'", transport);
+        }
+    }
+
+    const char* faults = g_getenv("MADARI_NET_FAULTS");
+    if (faults && *faults) {
+        std::vector<FaultRule> rules;
+        if (parse_faults(faults, &rules)) {
+            set_faults(std::move(rules));
+        } else {
+            g_warning("Ignoring malformed MADARI_NET_FAULTS '%s'", faults);
+        }
+    }
+}
+
+void Transport::set_live() {
+    state().mode = Mode::Live;
+}
+
+void Transport::set_record(const std::string& dir) {
+    g_mkdir_with_parents(dir.c_str(), 0755);
+    state().mode = Mode::Record;
+    state().dir = dir;
+    g_message("Recording responses to %s", dir.c_str());
+}
+
+void Transport::set_replay(const std::string& dir, bool recorded_timing) {
+    state().mode = Mode::Replay;
+    state().dir = dir;
+    state().recorded_timing = recorded_timing;
+    g_message("Replaying responses from %s", dir.c_str());
+}
+
+Transport::Mode Transport::mode() {
+    return state().mode;
+}
+
+bool Transport::parse_faults(const std::string& spec, std::vector<FaultRule>* rules) {
+    g_auto(GStrv) rule_specs = g_strsplit(spec.c_str(), ";", -1);
+    for (int i = 0; rule_specs[i]; i++) {
+        if (!*g_strstrip(rule_specs[i])) continue;
+
+        FaultRule rule;
+        g_auto(GStrv) fields = g_strsplit(rule_specs[i], ",", -1);
+        for (int j = 0; fields[j]; j++) {
+            g_auto(GStrv) pair = g_strsplit(g_strstrip(fields[j]), "=", 2);
+            if (!pair[0] || !pair[1] || !parse_rule_field(&rule, pair[0], pair[1])) {
+                return false;
+            }
+        }
+        rules->push_back(std::move(rule));
+    }
+    return true;
+}
+
+void Transport::set_faults(std::vector<FaultRule> rules) {
+    state().faults = std::move(rules);
+}
+
+void Transport::set_seed(guint32 seed) {
+    g_rand_set_seed(state().rand, seed);
+}
+
+void Transport::send_and_read(SoupSession* session, SoupMessage* msg, int priority,
+                              GCancellable* cancellable, Callback callback,
+                              GBytes* request_body) {
+    State& s = state();
+    GUri* uri = soup_message_get_uri(msg);
+
+    Request* req = new Request();
+    req->callback = std::move(callback);
+    req->msg = SOUP_MESSAGE(g_object_ref(msg));
+    req->cancellable = cancellable ? G_CANCELLABLE(g_object_ref(cancellable)) : nullptr;
+    req->started = g_get_monotonic_time();
+    if (s.mode != Mode::Live) {
+        g_autofree gchar* url = g_uri_to_string(uri);
+        req->url = url;
+        req->archive_path = archive_path(msg, req->url, request_body);
+    }
+
+    if (const FaultRule* rule = match_rule(g_uri_get_host(uri))) {
+        if (g_rand_double(s.rand) < rule->timeout_rate) {
+            fail_later(req, rule->timeout_ms, 0,
+                       g_error_new_literal(G_IO_ERROR, G_IO_ERROR_TIMED_OUT, "Socket I/O timed out (injected)"));
+            return;
+        }
+        guint delay_ms = rule->latency_ms;
+        if (rule->jitter_ms) delay_ms += static_cast<guint>(g_rand_int_range(s.rand, 0, rule->jitter_ms + 1));
+        if (g_rand_double(s.rand) < rule->error_rate) {
+            fail_later(req, delay_ms, rule->error_status, nullptr);
+            return;
+        }
+        req->delay_ms = delay_ms;
+        req->bandwidth = rule->bandwidth;
+    }
+
+    if (s.mode == Mode::Replay) {
+        g_autoptr(GFile) file = g_file_new_for_path(req->archive_path.c_str());
+        g_file_load_bytes_async(file, cancellable, on_replay_loaded, req);
+        return;
+    }
+
+    soup_session_send_and_read_async(session, msg, priority, cancellable, on_sent, req);
+}
+
+} // namespace Madari
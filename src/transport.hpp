@@ -0,0 +1,97 @@
+#pragma once
+
+#include <libsoup/soup.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Madari {
+
+/**
+ * Network conditions to simulate for requests to a host
+ */
+struct FaultRule {
+    std::string host = "*";         // "*", or a host and its subdomains
+    guint latency_ms = 0;           // Added to every response
+    guint jitter_ms = 0;            // Up to this much more, at random
+    guint64 bandwidth = 0;          // Body bytes per second, 0 for no cap
+    double error_rate = 0;          // Share of requests answered with error_status
+    guint error_status = 503;
+    double timeout_rate = 0;        // Share of requests that never answer
+    guint timeout_ms = 30000;       // When those fail, as the session timeout would
+};
+
+/**
+ * Where addon, Trakt and image requests go. Live by default; can instead
+ * record every response (body and timing) to a directory, or replay a
+ * recording without touching the network. Fault rules add latency,
+ * bandwidth caps, timeouts and HTTP errors per host in any mode, with a
+ * fixed random seed so runs repeat.
+ *
+ * OAuth responses are recorded with their tokens replaced, since
+ * recordings end up attached to bug reports.
+ *
+ * Set up from the environment by init():
+ *   MADARI_TRANSPORT=record:DIR | replay:DIR | replay-instant:DIR
+ *   MADARI_NET_FAULTS="host=strem.io,latency=300,jitter=100;host=*,error=503@0.05"
+ * Rule keys: host, latency, jitter (ms), bandwidth (bytes/s, k and m
+ * suffixes), error=STATUS@RATE, timeout=RATE or timeout=RATE@MS.
+ *
+ * Main thread only.
+ */
+class Transport {
+public:
+    enum class Mode {
+        Live,
+        Record,
+        Replay,
+    };
+
+    /**
+     * Called once with the whole body (nullptr on failure), the HTTP status
+     * (0 if there was no response) and the error, if any
+     */
+    using Callback = std::function<void(GBytes* body, guint status, const GError* error)>;
+
+    /**
+     * Read MADARI_TRANSPORT and MADARI_NET_FAULTS
+     */
+    static void init();
+
+    static void set_live();
+    static void set_record(const std::string& dir);
+
+    /**
+     * Serve responses from a recording; with recorded_timing each takes
+     * as long as it did when recorded. Requests not in it fail.
+     */
+    static void set_replay(const std::string& dir, bool recorded_timing = true);
+
+    static Mode mode();
+
+    /**
+     * Parse MADARI_NET_FAULTS syntax; false if any rule is malformed
+     */
+    static bool parse_faults(const std::string& spec, std::vector<FaultRule>* rules);
+
+    /**
+     * Replace the fault rules; the first rule matching a host applies
+     */
+    static void set_faults(std::vector<FaultRule> rules);
+
+    static void set_seed(guint32 seed);
+
+    /**
+     * soup_session_send_and_read_async through the transport. msg is
+     * sent on session in live and record modes. request_body is the body
+     * set on msg, if any, which libsoup can't hand back; recordings are
+     * keyed on it so requests differing only in body are kept apart.
+     * Members that change between runs (scrobble progress, timestamps,
+     * tokens) are left out of the key, so a replay finds them.
+     */
+    static void send_and_read(SoupSession* session, SoupMessage* msg, int priority,
+                              GCancellable* cancellable, Callback callback,
+                              GBytes* request_body = nullptr);
+};
+
+} // namespace Madari
@@ -1,4 +1,5 @@
 #include "watch_history.hpp"
+#include "profiler.hpp"
 #include <json-glib/json-glib.h>
 #include <glib.h>
 #include <algorithm>
@@ -7,6 +8,9 @@
 
 namespace Madari {
 
+// Write a few seconds after the last change, so a burst of updates is one save
+static const guint SAVE_DELAY_SECONDS = 5;
+
 // Helper function to format time
 static std::string format_time(double seconds) {
     if (seconds < 0) seconds = 0;
@@ -47,12 +51,17 @@ std::string WatchHistoryEntry::get_remaining_string() const {
     }
 }
 
-WatchHistoryService::WatchHistoryService() {
+WatchHistoryService::WatchHistoryService()
+    : cancellable_(g_cancellable_new()) {
     storage_path_ = get_storage_path();
 }
 
 WatchHistoryService::~WatchHistoryService() {
+    g_cancellable_cancel(cancellable_);
+    g_object_unref(cancellable_);
+    
     // Save on destruction
+    g_clear_handle_id(&save_source_, g_source_remove);
     save();
 }
 
@@ -63,25 +72,27 @@ std::string WatchHistoryService::get_storage_path() {
     return app_dir + "/watch_history.json";
 }
 
-void WatchHistoryService::load() {
-    history_.clear();
+// Parse the saved history; touches no service state, so it runs on a worker
+static std::vector<WatchHistoryEntry> read_history(const std::string& path) {
+    ProfileSpan span("load watch history", "services");
+    std::vector<WatchHistoryEntry> history;
     
-    if (!g_file_test(storage_path_.c_str(), G_FILE_TEST_EXISTS)) {
-        return;
+    if (!g_file_test(path.c_str(), G_FILE_TEST_EXISTS)) {
+        return history;
     }
     
     g_autoptr(GError) error = nullptr;
     g_autoptr(JsonParser) parser = json_parser_new();
     
-    if (!json_parser_load_from_file(parser, storage_path_.c_str(), &error)) {
+    if (!json_parser_load_from_file(parser, path.c_str(), &error)) {
         g_warning("Failed to load watch history: %s", error->message);
-        return;
+        return history;
     }
     
     JsonNode *root = json_parser_get_root(parser);
     if (!root || !JSON_NODE_HOLDS_ARRAY(root)) {
         g_warning("Invalid watch history format");
-        return;
+        return history;
     }
     
     JsonArray *array = json_node_get_array(root);
@@ -129,18 +140,85 @@ void WatchHistoryService::load() {
         
         // Only add valid entries
         if (!entry.meta_id.empty() && !entry.video_id.empty()) {
-            history_.push_back(entry);
+            history.push_back(entry);
         }
     }
     
     // Sort by last_watched (most recent first)
-    std::sort(history_.begin(), history_.end(), 
+    std::sort(history.begin(), history.end(), 
         [](const WatchHistoryEntry& a, const WatchHistoryEntry& b) {
             return a.last_watched > b.last_watched;
         });
+    return history;
+}
+
+void WatchHistoryService::load() {
+    history_ = read_history(storage_path_);
+    set_ready();
+}
+
+void WatchHistoryService::load_async() {
+    struct HistoryRead {
+        std::string path;
+        std::vector<WatchHistoryEntry> history;
+    };
+    
+    GTask *task = g_task_new(nullptr, cancellable_,
+        [](GObject*, GAsyncResult *result, gpointer user_data) {
+            // Cancelled when the service went away first
+            if (g_task_had_error(G_TASK(result))) return;
+            
+            auto *self = static_cast<WatchHistoryService*>(user_data);
+            auto *read = static_cast<HistoryRead*>(g_task_get_task_data(G_TASK(result)));
+            
+            // Anything recorded while reading is newer than the file
+            bool changed_while_loading = !self->history_.empty();
+            for (auto& entry : read->history) {
+                if (self->find_entry_index(entry.meta_id, entry.video_id) < 0) {
+                    self->history_.push_back(std::move(entry));
+                }
+            }
+            std::sort(self->history_.begin(), self->history_.end(),
+                [](const WatchHistoryEntry& a, const WatchHistoryEntry& b) {
+                    return a.last_watched > b.last_watched;
+                });
+            
+            self->set_ready();
+            if (changed_while_loading) {
+                self->notify_change();
+            }
+        }, this);
+    g_task_set_task_data(task, new HistoryRead{storage_path_, {}},
+                         [](gpointer d) { delete static_cast<HistoryRead*>(d); });
+    g_task_run_in_thread(task, [](GTask *task, gpointer, gpointer task_data, GCancellable*) {
+        auto *read = static_cast<HistoryRead*>(task_data);
+        read->history = read_history(read->path);
+        g_task_return_boolean(task, TRUE);
+    });
+    g_object_unref(task);
+}
+
+void WatchHistoryService::when_ready(ReadyCallback callback) {
+    if (ready_) {
+        callback();
+        return;
+    }
+    ready_callbacks_.push_back(std::move(callback));
+}
+
+void WatchHistoryService::set_ready() {
+    ready_ = true;
+    auto callbacks = std::move(ready_callbacks_);
+    ready_callbacks_.clear();
+    for (const auto& callback : callbacks) {
+        callback();
+    }
 }
 
 void WatchHistoryService::save() {
+    // Until the file is read, history_ only holds what was added since
+    if (!ready_) return;
+    
     g_autoptr(JsonBuilder) builder = json_builder_new();
     
     json_builder_begin_array(builder);
@@ -358,9 +436,37 @@ void WatchHistoryService::on_history_changed(HistoryChangedCallback callback) {
     change_callbacks_.push_back(callback);
 }
 
-void WatchHistoryService::notify_change() {
-    // Save to disk
+size_t WatchHistoryService::memory_bytes() const {
+    size_t bytes = history_.capacity() * sizeof(WatchHistoryEntry);
+    for (const auto& entry : history_) {
+        bytes += entry.meta_id.capacity() + entry.meta_type.capacity() + entry.video_id.capacity() +
+                 entry.title.capacity() + entry.poster_url.capacity() +
+                 entry.series_title.value_or("").size() + entry.binge_group.value_or("").size();
+    }
+    return bytes;
+}
+
+void WatchHistoryService::schedule_save() {
+    if (save_source_) return;
+    
+    save_source_ = g_timeout_add_seconds(SAVE_DELAY_SECONDS, [](gpointer user_data) -> gboolean {
+        auto *self = static_cast<WatchHistoryService*>(user_data);
+        self->save_source_ = 0;
+        self->save();
+        return G_SOURCE_REMOVE;
+    }, this);
+}
+
+void WatchHistoryService::flush() {
+    if (!save_source_) return;
+    
+    g_clear_handle_id(&save_source_, g_source_remove);
     save();
+}
+
+void WatchHistoryService::notify_change() {
+    // Save to disk shortly
+    schedule_save();
     
     // Notify listeners
     for (const auto& callback : change_callbacks_) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <gio/gio.h>
 #include <string>
 #include <vector>
 #include <optional>
@@ -82,6 +83,7 @@ struct WatchHistoryEntry {
 class WatchHistoryService {
 public:
     using HistoryChangedCallback = std::function<void()>;
+    using ReadyCallback = std::function<void()>;
     
     WatchHistoryService();
     ~WatchHistoryService();
@@ -91,11 +93,32 @@ public:
      */
     void load();
     
+    /**
+     * Load history from disk on a worker thread. Until ready the service
+     * is empty but usable; entries added meanwhile are kept.
+     */
+    void load_async();
+    
+    /**
+     * Whether the saved history has been loaded
+     */
+    bool is_ready() const { return ready_; }
+    
+    /**
+     * Run a callback once the saved history is loaded (right away if it is)
+     */
+    void when_ready(ReadyCallback callback);
+    
     /**
      * Save history to disk
      */
     void save();
     
+    /**
+     * Write changes made since the last save now; also done on destruction
+     */
+    void flush();
+    
     /**
      * Update watch progress for a content item
      * Creates new entry if doesn't exist, updates if exists
@@ -150,13 +173,26 @@ public:
      * Subscribe to history changes
      */
     void on_history_changed(HistoryChangedCallback callback);
+    
+    size_t size() const { return history_.size(); }
+    
+    /**
+     * Approximate bytes held by the loaded history
+     */
+    size_t memory_bytes() const;
 
 private:
     std::vector<WatchHistoryEntry> history_;
     std::vector<HistoryChangedCallback> change_callbacks_;
+    std::vector<ReadyCallback> ready_callbacks_;
     std::string storage_path_;
+    GCancellable *cancellable_;
+    guint save_source_ = 0;
+    bool ready_ = false;
     
     void notify_change();
+    void schedule_save();
+    void set_ready();
     std::string get_storage_path();
     
     // Find entry index, returns -1 if not found
@@ -1,19 +1,57 @@
 #include "window.hpp"
 #include "detail_view.hpp"
+#include "catalog_view.hpp"
 #include "stremio/stremio.hpp"
 #include "trakt/trakt.hpp"
 #include "watch_history.hpp"
+#include "stream_list.hpp"
+#include "image_loader.hpp"
+#include "profiler.hpp"
+#include "log.hpp"
 #include <libsoup/soup.h>
 #include <mpv/client.h>
 #include <mpv/render_gl.h>
 #include <epoxy/gl.h>
 #include <epoxy/egl.h>
 #include <algorithm>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
 
+// Search result item, one per merged result in ranked order
+#define MADARI_TYPE_SEARCH_ITEM (madari_search_item_get_type())
+G_DECLARE_FINAL_TYPE(MadariSearchItem, madari_search_item, MADARI, SEARCH_ITEM, GObject)
+
+struct _MadariSearchItem {
+    GObject parent_instance;
+    Stremio::MetaPreview *meta;
+};
+
+G_DEFINE_TYPE(MadariSearchItem, madari_search_item, G_TYPE_OBJECT)
+
+static void madari_search_item_finalize(GObject *object) {
+    delete MADARI_SEARCH_ITEM(object)->meta;
+    G_OBJECT_CLASS(madari_search_item_parent_class)->finalize(object);
+}
+
+static void madari_search_item_class_init(MadariSearchItemClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = madari_search_item_finalize;
+}
+
+static void madari_search_item_init(MadariSearchItem *self) {
+    self->meta = nullptr;
+}
+
+static MadariSearchItem *madari_search_item_new(const Stremio::MetaPreview& meta) {
+    MadariSearchItem *self = MADARI_SEARCH_ITEM(g_object_new(MADARI_TYPE_SEARCH_ITEM, nullptr));
+    self->meta = new Stremio::MetaPreview(meta);
+    return self;
+}
+
 struct _MadariWindow {
     AdwApplicationWindow parent_instance;
 
@@ -72,6 +110,10 @@ struct _MadariWindow {
     std::string *player_current_title;
     std::vector<std::pair<int, std::string>> *audio_tracks;
     std::vector<std::pair<int, std::string>> *subtitle_tracks;
+    gint64 player_load_started;         // Monotonic time of the last loadfile
+    gboolean player_first_frame_pending; // Waiting for the first PLAYBACK_RESTART after loadfile
+    Madari::PlaybackSource *player_source;  // Addon/URL/binge group of the playing file, for outcome stats
+    Madari::PlaybackSource *queued_source;  // Same for the prefetched next episode
     
     // Series episode context
     std::string *current_meta_id;
@@ -90,6 +132,11 @@ struct _MadariWindow {
     std::vector<EpisodeInfo> *episode_list;
     int current_episode_index;
     
+    // Gapless next episode: stream resolved near the end and appended to mpv's playlist
+    int prefetched_episode_index;        // Episode queued after the current file, -1 if none
+    gboolean next_episode_resolving;     // Next episode lookup already started for this file
+    guint playback_generation;           // Bumped whenever the playing file is replaced
+    
     // Next/Previous episode buttons
     GtkButton *player_prev_btn;
     GtkButton *player_next_btn;
@@ -120,12 +167,24 @@ struct _MadariWindow {
     // Track pending catalog loads
     int pending_catalogs;
     
+    // Home rows whose posters were dropped under memory pressure
+    gboolean home_images_released;
+    
+    // Speculative meta loads for hovered/focused posters
+    GCancellable *meta_prefetch_cancellable;
+    int meta_prefetch_budget;            // Prefetches left this session
+    
     // Current filter
     std::string *current_filter;
     
     // Search state
     std::string *current_search_query;
     gboolean is_searching;
+    GListStore *search_results;          // MadariSearchItem, best first, for the current query
+    GCancellable *search_cancellable;    // Catalog requests of the current query
+    guint search_generation;             // Bumped per query, so late callbacks can tell they are stale
+    GtkLabel *search_title;              // Results header, while it is in catalogs_box
+    GtkFlowBox *search_flow;             // Results grid, while it is in catalogs_box
     
     // Watch history tracking
     std::string *current_poster_url;    // Poster URL for watch history
@@ -149,6 +208,7 @@ static void load_catalog_content(MadariWindow *self, GtkBox *items_box,
                                   const std::string& addon_id, const std::string& type,
                                   const std::string& catalog_id);
 static GtkWidget* create_poster_item(const Stremio::MetaPreview& meta);
+static void request_mpv_log_messages(MadariWindow *self);
 
 // ============ Trakt Scrobbling ============
 
@@ -217,75 +277,15 @@ static void trigger_scrobble(MadariWindow *self, const char* action) {
 }
 
 static void clear_catalogs_box(MadariWindow *self) {
+    self->search_title = nullptr;
+    self->search_flow = nullptr;
+    
     GtkWidget *child;
     while ((child = gtk_widget_get_first_child(GTK_WIDGET(self->catalogs_box))) != nullptr) {
         gtk_box_remove(self->catalogs_box, child);
     }
 }
 
-// Global soup session for image loading with limited concurrent requests
-static SoupSession* get_image_session() {
-    static SoupSession *session = nullptr;
-    if (!session) {
-        // max-conns and max-conns-per-host are construct-only properties
-        session = SOUP_SESSION(g_object_new(SOUP_TYPE_SESSION,
-                     "timeout", 30,
-                     "max-conns", 8,
-                     "max-conns-per-host", 4,
-                     nullptr));
-    }
-    return session;
-}
-
-static void do_load_image(GtkPicture *picture, const char *url) {
-    SoupMessage *msg = soup_message_new("GET", url);
-    if (!msg) return;
-    
-    // prevent picture from being destroyed while loading
-    g_object_ref(picture);
-    
-    soup_session_send_and_read_async(
-        get_image_session(),
-        msg,
-        G_PRIORITY_LOW,  // Use low priority to not block UI
-        nullptr,
-        [](GObject *source, GAsyncResult *result, gpointer user_data) {
-            GtkPicture *picture = GTK_PICTURE(user_data);
-            g_autoptr(GError) error = nullptr;
-            
-            GBytes *bytes = soup_session_send_and_read_finish(SOUP_SESSION(source), result, &error);
-            
-            if (bytes && !error) {
-                gsize size;
-                const guchar *data = static_cast<const guchar*>(g_bytes_get_data(bytes, &size));
-                
-                if (data && size > 0) {
-                    g_autoptr(GInputStream) stream = g_memory_input_stream_new_from_data(
-                        g_memdup2(data, size), size, g_free);
-                    
-                    GdkPixbuf *pixbuf = gdk_pixbuf_new_from_stream_at_scale(
-                        stream, 160, 240, TRUE, nullptr, nullptr);
-                    
-                    if (pixbuf) {
-                        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-                        GdkTexture *texture = gdk_texture_new_for_pixbuf(pixbuf);
-                        G_GNUC_END_IGNORE_DEPRECATIONS
-                        gtk_picture_set_paintable(picture, GDK_PAINTABLE(texture));
-                        g_object_unref(texture);
-                        g_object_unref(pixbuf);
-                    }
-                }
-                g_bytes_unref(bytes);
-            }
-            
-            g_object_unref(picture);
-        },
-        picture
-    );
-    
-    g_object_unref(msg);
-}
-
 // Lazy load - only load when widget becomes visible
 static void on_picture_map(GtkWidget *widget, [[maybe_unused]] gpointer user_data) {
     const char *url = static_cast<const char*>(g_object_get_data(G_OBJECT(widget), "image-url"));
@@ -302,7 +302,7 @@ static void on_picture_map(GtkWidget *widget, [[maybe_unused]] gpointer user_dat
             }
             const char *url = static_cast<const char*>(g_object_get_data(G_OBJECT(widget), "image-url"));
             if (url) {
-                do_load_image(GTK_PICTURE(widget), url);
+                madari_image_load(GTK_PICTURE(widget), url, 160, 240);
             }
             g_object_unref(widget);
             return G_SOURCE_REMOVE;
@@ -319,14 +319,105 @@ static void load_image_async(GtkPicture *picture, const std::string& url) {
     // If widget is already mapped, load immediately
     if (gtk_widget_get_mapped(GTK_WIDGET(picture))) {
         g_object_set_data(G_OBJECT(picture), "image-loaded", GINT_TO_POINTER(TRUE));
-        do_load_image(picture, url.c_str());
+        madari_image_load(picture, url, 160, 240);
     } else {
         // Otherwise, wait for map signal
         g_signal_connect(picture, "map", G_CALLBACK(on_picture_map), nullptr);
     }
 }
 
-static GtkWidget* create_poster_item(const Stremio::MetaPreview& meta) {
+// ============= Meta Prefetch =============
+
+// How long the pointer must rest on (or focus stay in) a poster before prefetching
+static const guint META_PREFETCH_DWELL_MS = 300;
+
+// Prefetches per window session, so sweeping over a wall of posters stays cheap
+static const int META_PREFETCH_BUDGET = 40;
+
+// Warm the meta cache and the detail page's images for a poster
+static void prefetch_poster_meta(GtkWidget *box) {
+    if (g_object_get_data(G_OBJECT(box), "meta-prefetched")) return;
+    
+    GtkRoot *root = gtk_widget_get_root(box);
+    if (!MADARI_IS_WINDOW(root)) return;
+    MadariWindow *self = MADARI_WINDOW(root);
+    if (self->meta_prefetch_budget <= 0) return;
+    
+    Stremio::AddonService *service = madari_application_get_addon_service(self->app);
+    const std::string *meta_id = static_cast<const std::string*>(g_object_get_data(G_OBJECT(box), "meta-id"));
+    const std::string *meta_type = static_cast<const std::string*>(g_object_get_data(G_OBJECT(box), "meta-type"));
+    if (!service || !meta_id || !meta_type) return;
+    
+    g_object_set_data(G_OBJECT(box), "meta-prefetched", GINT_TO_POINTER(TRUE));
+    self->meta_prefetch_budget--;
+    
+    if (!self->meta_prefetch_cancellable) {
+        self->meta_prefetch_cancellable = g_cancellable_new();
+    }
+    Stremio::RequestOptions options;
+    options.cancellable = self->meta_prefetch_cancellable;
+    
+    // The images go with the meta prefetches when those are cancelled
+    std::shared_ptr<GCancellable> cancellable(G_CANCELLABLE(g_object_ref(options.cancellable)),
+                                              [](GCancellable *c) { g_object_unref(c); });
+    service->prefetch_meta(*meta_type, *meta_id, [cancellable](const Stremio::Meta& meta) {
+        if (g_cancellable_is_cancelled(cancellable.get())) return;
+        
+        // At the sizes the detail page loads them
+        if (meta.background.has_value()) {
+            madari_image_prefetch(*meta.background, 1200, 400, cancellable.get());
+        }
+        if (meta.poster.has_value()) {
+            madari_image_prefetch(*meta.poster, 200, 300, cancellable.get());
+        }
+    }, options);
+}
+
+static void cancel_poster_dwell(GtkWidget *box) {
+    guint source_id = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(box), "prefetch-dwell"));
+    if (source_id) {
+        g_source_remove(source_id);
+        g_object_set_data(G_OBJECT(box), "prefetch-dwell", nullptr);
+    }
+}
+
+static void start_poster_dwell(GtkWidget *box) {
+    if (g_object_get_data(G_OBJECT(box), "meta-prefetched")) return;
+    cancel_poster_dwell(box);
+    
+    guint source_id = g_timeout_add_full(G_PRIORITY_DEFAULT, META_PREFETCH_DWELL_MS, [](gpointer data) -> gboolean {
+        GtkWidget *box = GTK_WIDGET(data);
+        g_object_set_data(G_OBJECT(box), "prefetch-dwell", nullptr);
+        prefetch_poster_meta(box);
+        return G_SOURCE_REMOVE;
+    }, g_object_ref(box), g_object_unref);
+    g_object_set_data(G_OBJECT(box), "prefetch-dwell", GUINT_TO_POINTER(source_id));
+}
+
+// Drop prefetches for posters that are going away
+static void cancel_meta_prefetches(MadariWindow *self) {
+    if (self->meta_prefetch_cancellable) {
+        g_cancellable_cancel(self->meta_prefetch_cancellable);
+        g_clear_object(&self->meta_prefetch_cancellable);
+    }
+}
+
+static void open_poster_detail(GtkWidget *box) {
+    const std::string *meta_id = static_cast<const std::string*>(g_object_get_data(G_OBJECT(box), "meta-id"));
+    const std::string *meta_type = static_cast<const std::string*>(g_object_get_data(G_OBJECT(box), "meta-type"));
+    
+    if (meta_id && meta_type) {
+        // Find the window
+        GtkRoot *root = gtk_widget_get_root(box);
+        if (MADARI_IS_WINDOW(root)) {
+            madari_window_show_detail(MADARI_WINDOW(root), meta_id->c_str(), meta_type->c_str());
+        }
+    }
+}
+
+// Poster card without content; poster_set_meta fills it. Grid cells build
+// one per slot and rebind it as they scroll.
+static GtkWidget* build_poster_item() {
     GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 6);
     gtk_widget_set_size_request(box, 160, -1);
     
@@ -353,23 +444,18 @@ static GtkWidget* create_poster_item(const Stremio::MetaPreview& meta) {
     
     gtk_overlay_set_child(GTK_OVERLAY(overlay), placeholder_box);
     
-    // Actual poster image (loads over placeholder)
-    if (meta.poster.has_value() && !meta.poster->empty()) {
-        GtkWidget *picture = gtk_picture_new();
-        gtk_picture_set_content_fit(GTK_PICTURE(picture), GTK_CONTENT_FIT_COVER);
-        gtk_widget_set_size_request(picture, 160, 240);
-        
-        // Load image asynchronously with lazy loading
-        load_image_async(GTK_PICTURE(picture), *meta.poster);
-        
-        gtk_overlay_add_overlay(GTK_OVERLAY(overlay), picture);
-    }
+    // Actual poster image (loads over placeholder), lazily once mapped
+    GtkWidget *picture = gtk_picture_new();
+    gtk_picture_set_content_fit(GTK_PICTURE(picture), GTK_CONTENT_FIT_COVER);
+    gtk_widget_set_size_request(picture, 160, 240);
+    g_signal_connect(picture, "map", G_CALLBACK(on_picture_map), nullptr);
+    gtk_overlay_add_overlay(GTK_OVERLAY(overlay), picture);
     
     gtk_frame_set_child(GTK_FRAME(frame), overlay);
     gtk_box_append(GTK_BOX(box), frame);
     
     // Title
-    GtkWidget *title_label = gtk_label_new(meta.name.c_str());
+    GtkWidget *title_label = gtk_label_new(nullptr);
     gtk_label_set_max_width_chars(GTK_LABEL(title_label), 16);
     gtk_label_set_ellipsize(GTK_LABEL(title_label), PANGO_ELLIPSIZE_END);
     gtk_label_set_lines(GTK_LABEL(title_label), 1);
@@ -378,6 +464,94 @@ static GtkWidget* create_poster_item(const Stremio::MetaPreview& meta) {
     gtk_box_append(GTK_BOX(box), title_label);
     
     // Year/rating info
+    GtkWidget *info_label = gtk_label_new(nullptr);
+    gtk_widget_add_css_class(info_label, "dim-label");
+    gtk_widget_add_css_class(info_label, "caption");
+    gtk_label_set_ellipsize(GTK_LABEL(info_label), PANGO_ELLIPSIZE_END);
+    gtk_widget_set_halign(info_label, GTK_ALIGN_START);
+    gtk_box_append(GTK_BOX(box), info_label);
+    
+    g_object_set_data(G_OBJECT(box), "poster-picture", picture);
+    g_object_set_data(G_OBJECT(box), "poster-title", title_label);
+    g_object_set_data(G_OBJECT(box), "poster-info", info_label);
+    
+    // Make clickable
+    GtkGesture *click = gtk_gesture_click_new();
+    gtk_gesture_single_set_button(GTK_GESTURE_SINGLE(click), GDK_BUTTON_PRIMARY);
+    g_signal_connect(click, "pressed", G_CALLBACK(+[](GtkGestureClick*, gint, gdouble, gdouble, gpointer user_data) {
+        open_poster_detail(GTK_WIDGET(user_data));
+    }), box);
+    gtk_widget_add_controller(box, GTK_EVENT_CONTROLLER(click));
+    
+    // Keyboard: focusable, opens on Enter/Space
+    gtk_widget_set_focusable(box, TRUE);
+    GtkEventController *keys = gtk_event_controller_key_new();
+    g_signal_connect(keys, "key-pressed", G_CALLBACK(+[](GtkEventControllerKey*, guint keyval, guint,
+                                                        GdkModifierType, gpointer user_data) -> gboolean {
+        if (keyval == GDK_KEY_Return || keyval == GDK_KEY_KP_Enter || keyval == GDK_KEY_space) {
+            open_poster_detail(GTK_WIDGET(user_data));
+            return TRUE;
+        }
+        return FALSE;
+    }), box);
+    gtk_widget_add_controller(box, keys);
+    
+    // Prefetch the detail page when the pointer rests on the poster or it gets focus
+    GtkEventController *motion = gtk_event_controller_motion_new();
+    g_signal_connect(motion, "enter", G_CALLBACK(+[](GtkEventControllerMotion*, gdouble, gdouble, gpointer user_data) {
+        start_poster_dwell(GTK_WIDGET(user_data));
+    }), box);
+    g_signal_connect(motion, "leave", G_CALLBACK(+[](GtkEventControllerMotion*, gpointer user_data) {
+        cancel_poster_dwell(GTK_WIDGET(user_data));
+    }), box);
+    gtk_widget_add_controller(box, motion);
+    
+    GtkEventController *focus = gtk_event_controller_focus_new();
+    g_signal_connect(focus, "enter", G_CALLBACK(+[](GtkEventControllerFocus*, gpointer user_data) {
+        start_poster_dwell(GTK_WIDGET(user_data));
+    }), box);
+    g_signal_connect(focus, "leave", G_CALLBACK(+[](GtkEventControllerFocus*, gpointer user_data) {
+        cancel_poster_dwell(GTK_WIDGET(user_data));
+    }), box);
+    gtk_widget_add_controller(box, focus);
+    
+    // Hover effect
+    gtk_widget_set_cursor_from_name(box, "pointer");
+    
+    return box;
+}
+
+// Show meta in a poster card, replacing whatever it showed before
+static void poster_set_meta(GtkWidget *box, const Stremio::MetaPreview& meta) {
+    GtkWidget *picture = GTK_WIDGET(g_object_get_data(G_OBJECT(box), "poster-picture"));
+    GtkWidget *title_label = GTK_WIDGET(g_object_get_data(G_OBJECT(box), "poster-title"));
+    GtkWidget *info_label = GTK_WIDGET(g_object_get_data(G_OBJECT(box), "poster-info"));
+    
+    // The previous item's prefetch state does not carry over
+    cancel_poster_dwell(box);
+    g_object_set_data(G_OBJECT(box), "meta-prefetched", nullptr);
+    
+    if (meta.poster.has_value() && !meta.poster->empty()) {
+        gtk_widget_set_visible(picture, TRUE);
+        g_object_set_data_full(G_OBJECT(picture), "image-url", g_strdup(meta.poster->c_str()), g_free);
+        g_object_set_data(G_OBJECT(picture), "image-loaded", GINT_TO_POINTER(FALSE));
+        if (gtk_widget_get_mapped(picture)) {
+            g_object_set_data(G_OBJECT(picture), "image-loaded", GINT_TO_POINTER(TRUE));
+            madari_image_load(GTK_PICTURE(picture), *meta.poster, 160, 240);
+        } else {
+            // Don't flash the previous item's poster until the map handler loads this one
+            madari_image_cancel(GTK_PICTURE(picture));
+            gtk_picture_set_paintable(GTK_PICTURE(picture), nullptr);
+        }
+    } else {
+        madari_image_cancel(GTK_PICTURE(picture));
+        gtk_picture_set_paintable(GTK_PICTURE(picture), nullptr);
+        g_object_set_data(G_OBJECT(picture), "image-url", nullptr);
+        gtk_widget_set_visible(picture, FALSE);
+    }
+    
+    gtk_label_set_text(GTK_LABEL(title_label), meta.name.c_str());
+    
     std::string info;
     if (meta.release_info.has_value() && !meta.release_info->empty()) {
         info = *meta.release_info;
@@ -386,52 +560,34 @@ static GtkWidget* create_poster_item(const Stremio::MetaPreview& meta) {
         if (!info.empty()) info += " • ";
         info += "★ " + *meta.imdb_rating;
     }
-    if (!info.empty()) {
-        GtkWidget *info_label = gtk_label_new(info.c_str());
-        gtk_widget_add_css_class(info_label, "dim-label");
-        gtk_widget_add_css_class(info_label, "caption");
-        gtk_label_set_ellipsize(GTK_LABEL(info_label), PANGO_ELLIPSIZE_END);
-        gtk_widget_set_halign(info_label, GTK_ALIGN_START);
-        gtk_box_append(GTK_BOX(box), info_label);
-    }
+    gtk_label_set_text(GTK_LABEL(info_label), info.c_str());
+    gtk_widget_set_visible(info_label, !info.empty());
     
     // Store metadata for click handling
-    std::string *meta_id = new std::string(meta.id);
-    std::string *meta_type = new std::string(meta.type);
-    g_object_set_data_full(G_OBJECT(box), "meta-id", meta_id,
+    g_object_set_data_full(G_OBJECT(box), "meta-id", new std::string(meta.id),
                            [](gpointer data) { delete static_cast<std::string*>(data); });
-    g_object_set_data_full(G_OBJECT(box), "meta-type", meta_type,
+    g_object_set_data_full(G_OBJECT(box), "meta-type", new std::string(meta.type),
                            [](gpointer data) { delete static_cast<std::string*>(data); });
-    
-    // Make clickable
-    GtkGesture *click = gtk_gesture_click_new();
-    gtk_gesture_single_set_button(GTK_GESTURE_SINGLE(click), GDK_BUTTON_PRIMARY);
-    g_signal_connect(click, "pressed", G_CALLBACK(+[](GtkGestureClick *gesture, gint, gdouble, gdouble, gpointer user_data) {
-        GtkWidget *box = GTK_WIDGET(user_data);
-        const std::string *meta_id = static_cast<const std::string*>(g_object_get_data(G_OBJECT(box), "meta-id"));
-        const std::string *meta_type = static_cast<const std::string*>(g_object_get_data(G_OBJECT(box), "meta-type"));
-        
-        if (meta_id && meta_type) {
-            // Find the window
-            GtkWidget *widget = GTK_WIDGET(gtk_event_controller_get_widget(GTK_EVENT_CONTROLLER(gesture)));
-            GtkRoot *root = gtk_widget_get_root(widget);
-            if (MADARI_IS_WINDOW(root)) {
-                madari_window_show_detail(MADARI_WINDOW(root), meta_id->c_str(), meta_type->c_str());
-            }
-        }
-    }), box);
-    gtk_widget_add_controller(box, GTK_EVENT_CONTROLLER(click));
-    
-    // Hover effect
-    gtk_widget_set_cursor_from_name(box, "pointer");
-    
+}
+
+static GtkWidget* create_poster_item(const Stremio::MetaPreview& meta) {
+    GtkWidget *box = build_poster_item();
+    poster_set_meta(box, meta);
     return box;
 }
 
+GtkWidget *madari_window_poster_new(void) {
+    return build_poster_item();
+}
+
+void madari_window_poster_set_meta(GtkWidget *poster, const Stremio::MetaPreview& meta) {
+    poster_set_meta(poster, meta);
+}
+
 static GtkWidget* create_catalog_section(const std::string& title, 
-                                          [[maybe_unused]] const std::string& addon_id,
-                                          [[maybe_unused]] const std::string& catalog_id, 
-                                          [[maybe_unused]] const std::string& type) {
+                                          const std::string& addon_id,
+                                          const std::string& catalog_id, 
+                                          const std::string& type) {
     GtkWidget *section = gtk_box_new(GTK_ORIENTATION_VERTICAL, 12);
     
     // Header with title
@@ -443,9 +599,24 @@ static GtkWidget* create_catalog_section(const std::string& title,
     gtk_widget_set_hexpand(title_label, TRUE);
     gtk_box_append(GTK_BOX(header), title_label);
     
-    // "See All" button (for future navigation)
+    // "See All" opens the whole catalog as a paged grid
     GtkWidget *see_all = gtk_button_new_with_label("See All");
     gtk_widget_add_css_class(see_all, "flat");
+    struct CatalogTarget {
+        std::string addon_id, type, catalog_id, title;
+    };
+    g_object_set_data_full(G_OBJECT(see_all), "catalog-target",
+                           new CatalogTarget{addon_id, type, catalog_id, title},
+                           [](gpointer data) { delete static_cast<CatalogTarget*>(data); });
+    g_signal_connect(see_all, "clicked", G_CALLBACK(+[](GtkButton *button, gpointer) {
+        GtkRoot *root = gtk_widget_get_root(GTK_WIDGET(button));
+        const CatalogTarget *target = static_cast<const CatalogTarget*>(
+            g_object_get_data(G_OBJECT(button), "catalog-target"));
+        if (!MADARI_IS_WINDOW(root) || !target) return;
+        
+        madari_window_show_catalog(MADARI_WINDOW(root), target->addon_id.c_str(), target->type.c_str(),
+                                   target->catalog_id.c_str(), target->title.c_str());
+    }), nullptr);
     gtk_box_append(GTK_BOX(header), see_all);
     
     gtk_box_append(GTK_BOX(section), header);
@@ -469,6 +640,10 @@ static GtkWidget* create_catalog_section(const std::string& title,
     // Store items_box reference for loading content
     g_object_set_data(G_OBJECT(section), "items-box", items_box);
     
+    // Lets background refreshes find the row of a catalog
+    g_object_set_data_full(G_OBJECT(section), "catalog-key",
+                           g_strdup(Madari::CatalogRefresher::make_key(addon_id, type, catalog_id).c_str()), g_free);
+    
     // Add loading spinner initially
     GtkWidget *spinner_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
     gtk_widget_set_size_request(spinner_box, 150, 225);
@@ -485,6 +660,34 @@ static GtkWidget* create_catalog_section(const std::string& title,
     return section;
 }
 
+// Replace a row's posters (or spinner) with a catalog response
+static void fill_catalog_row(GtkBox *items_box, const std::optional<Stremio::CatalogResponse>& response,
+                             const std::string& error) {
+    Madari::ProfileSpan span("build catalog row", "ui");
+    
+    GtkWidget *child;
+    while ((child = gtk_widget_get_first_child(GTK_WIDGET(items_box))) != nullptr) {
+        gtk_box_remove(items_box, child);
+    }
+    
+    if (response && !response->metas.empty()) {
+        // Add poster items (limit to first 25 for performance)
+        int count = 0;
+        for (const auto& meta : response->metas) {
+            if (count >= 25) break;
+            GtkWidget *item = create_poster_item(meta);
+            gtk_box_append(items_box, item);
+            count++;
+        }
+    } else {
+        // Show error or empty state
+        GtkWidget *label = gtk_label_new(error.empty() ? "No content available" : error.c_str());
+        gtk_widget_add_css_class(label, "dim-label");
+        gtk_widget_set_margin_start(label, 24);
+        gtk_box_append(items_box, label);
+    }
+}
+
 static void load_catalog_content(MadariWindow *self, GtkBox *items_box,
                                   const std::string& addon_id, const std::string& type,
                                   const std::string& catalog_id) {
@@ -493,40 +696,27 @@ static void load_catalog_content(MadariWindow *self, GtkBox *items_box,
     
     Stremio::ExtraArgs extra;
     
-    // Store references for the callback
-    struct LoadData {
-        MadariWindow *window;
-        GtkBox *items_box;
-    };
-    LoadData *data = new LoadData{self, items_box};
-    
-    service->fetch_catalog(addon_id, type, catalog_id, extra,
-        [data](std::optional<Stremio::CatalogResponse> response, const std::string& error) {
-            // Clear the loading spinner
-            GtkWidget *child;
-            while ((child = gtk_widget_get_first_child(GTK_WIDGET(data->items_box))) != nullptr) {
-                gtk_box_remove(data->items_box, child);
+    // A cached page shows at once; if revalidating it brings a different
+    // page, the row is filled again. The box is kept alive for that second
+    // answer, which may come after the home screen was rebuilt.
+    std::shared_ptr<GtkBox> box(GTK_BOX(g_object_ref(items_box)), [](GtkBox *b) { g_object_unref(b); });
+    auto answered = std::make_shared<bool>(false);
+    gint64 fetch_started = Madari::Profiler::enabled() ? Madari::Profiler::now() : -1;
+    
+    service->fetch_catalog_cached(addon_id, type, catalog_id, extra,
+        [self, box, answered, fetch_started, addon_id, type, catalog_id](
+                std::optional<Stremio::CatalogResponse> response, const std::string& error, bool from_cache) {
+            if (fetch_started >= 0) {
+                Madari::Profiler::async(from_cache ? "catalog fetch (cached)" : "catalog fetch", "network",
+                                        fetch_started, addon_id + "/" + type + "/" + catalog_id);
             }
             
-            if (response && !response->metas.empty()) {
-                // Add poster items (limit to first 25 for performance)
-                int count = 0;
-                for (const auto& meta : response->metas) {
-                    if (count >= 25) break;
-                    GtkWidget *item = create_poster_item(meta);
-                    gtk_box_append(data->items_box, item);
-                    count++;
-                }
-            } else {
-                // Show error or empty state
-                GtkWidget *label = gtk_label_new(error.empty() ? "No content available" : error.c_str());
-                gtk_widget_add_css_class(label, "dim-label");
-                gtk_widget_set_margin_start(label, 24);
-                gtk_box_append(data->items_box, label);
-            }
+            fill_catalog_row(box.get(), response, error);
             
-            data->window->pending_catalogs--;
-            delete data;
+            if (!*answered) {
+                *answered = true;
+                self->pending_catalogs--;
+            }
         });
 }
 
@@ -772,6 +962,7 @@ static GtkWidget* create_continue_watching_section(MadariWindow *self) {
     // Create section
     GtkWidget *section = gtk_box_new(GTK_ORIENTATION_VERTICAL, 12);
     g_object_set_data(G_OBJECT(section), "window", self);
+    g_object_set_data(G_OBJECT(section), "continue-watching", GINT_TO_POINTER(TRUE));
     
     // Header
     GtkWidget *header = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
@@ -901,12 +1092,21 @@ static GtkWidget* create_continue_watching_section(MadariWindow *self) {
 }
 
 static void load_catalogs(MadariWindow *self) {
+    Madari::ProfileSpan span("load_catalogs", "ui");
+    cancel_meta_prefetches(self);
+    
     Stremio::AddonService *service = madari_application_get_addon_service(self->app);
     if (!service) {
         gtk_stack_set_visible_child_name(self->main_stack, "empty");
         return;
     }
     
+    // Still reading installed addons; loads again once they are in
+    if (!service->is_ready()) {
+        gtk_stack_set_visible_child_name(self->main_stack, "loading");
+        return;
+    }
+    
     std::vector<std::pair<Stremio::Manifest, Stremio::CatalogDefinition>> catalogs;
     
     // Get catalogs based on current filter
@@ -935,6 +1135,7 @@ static void load_catalogs(MadariWindow *self) {
     
     // Clear existing catalogs
     clear_catalogs_box(self);
+    self->home_images_released = FALSE;
     
     // Add Continue Watching section at the top (only when no filter is active)
     if (!self->current_filter || self->current_filter->empty()) {
@@ -945,6 +1146,7 @@ static void load_catalogs(MadariWindow *self) {
     }
     
     self->pending_catalogs = static_cast<int>(catalogs.size());
+    Madari::CatalogRefresher *refresher = madari_application_get_catalog_refresher(self->app);
     
     // Create sections for each catalog
     for (const auto& [manifest, catalog] : catalogs) {
@@ -958,12 +1160,67 @@ static void load_catalogs(MadariWindow *self) {
         // Get the items box and load content
         GtkBox *items_box = GTK_BOX(g_object_get_data(G_OBJECT(section), "items-box"));
         load_catalog_content(self, items_box, manifest.id, catalog.type, catalog.id);
+        if (refresher) refresher->track(manifest.id, catalog.type, catalog.id);
     }
     
     // Switch to content view
     gtk_stack_set_visible_child_name(self->main_stack, "content");
 }
 
+static void on_first_frame_painted(GdkFrameClock *clock, [[maybe_unused]] gpointer user_data) {
+    Madari::Profiler::instant("first frame", "ui");
+    Madari::Profiler::complete("startup to first frame", "startup", 0);
+    g_signal_handlers_disconnect_by_func(clock, (gpointer)on_first_frame_painted, nullptr);
+}
+
+static void profile_first_frame(GtkWidget *widget, [[maybe_unused]] gpointer user_data) {
+    g_signal_connect(gtk_widget_get_frame_clock(widget), "after-paint",
+                     G_CALLBACK(on_first_frame_painted), nullptr);
+}
+
+/**
+ * Rebuild just the Continue Watching row, for watch history or Trakt
+ * becoming ready after the catalogs were laid out
+ */
+static void refresh_continue_watching(MadariWindow *self) {
+    if (self->is_searching || (self->current_filter && !self->current_filter->empty())) return;
+    if (g_strcmp0(gtk_stack_get_visible_child_name(self->main_stack), "content") != 0) return;
+    
+    GtkWidget *first = gtk_widget_get_first_child(GTK_WIDGET(self->catalogs_box));
+    if (first && g_object_get_data(G_OBJECT(first), "continue-watching")) {
+        gtk_box_remove(self->catalogs_box, first);
+    }
+    
+    GtkWidget *section = create_continue_watching_section(self);
+    if (section) {
+        gtk_box_prepend(self->catalogs_box, section);
+    }
+}
+
+/**
+ * Weak reference to the window for callbacks held by longer-lived services
+ */
+static std::shared_ptr<GWeakRef> window_weak_ref(MadariWindow *self) {
+    auto ref = std::shared_ptr<GWeakRef>(new GWeakRef, [](GWeakRef *weak) {
+        g_weak_ref_clear(weak);
+        delete weak;
+    });
+    g_weak_ref_init(ref.get(), self);
+    return ref;
+}
+
+/**
+ * Wrap a window function as a service ready callback; services may become
+ * ready after the window is gone
+ */
+static std::function<void()> window_ready_callback(MadariWindow *self, void (*fn)(MadariWindow*)) {
+    auto ref = window_weak_ref(self);
+    return [ref, fn]() {
+        g_autoptr(MadariWindow) window = static_cast<MadariWindow*>(g_weak_ref_get(ref.get()));
+        if (window) fn(window);
+    };
+}
+
 void madari_window_refresh_catalogs(MadariWindow *self) {
     g_return_if_fail(MADARI_IS_WINDOW(self));
     load_catalogs(self);
@@ -979,6 +1236,107 @@ void madari_window_show_detail(MadariWindow *self, const char *meta_id, const ch
     adw_navigation_view_push(self->navigation_view, ADW_NAVIGATION_PAGE(detail));
 }
 
+void madari_window_show_catalog(MadariWindow *self, const char *addon_id, const char *type,
+                                const char *catalog_id, const char *title) {
+    g_return_if_fail(MADARI_IS_WINDOW(self));
+    
+    Stremio::AddonService *service = madari_application_get_addon_service(self->app);
+    if (!service) return;
+    
+    Madari::CatalogRefresher *refresher = madari_application_get_catalog_refresher(self->app);
+    if (refresher) refresher->track(addon_id, type, catalog_id);
+    
+    MadariCatalogView *view = madari_catalog_view_new(service, addon_id, type, catalog_id, title);
+    adw_navigation_view_push(self->navigation_view, ADW_NAVIGATION_PAGE(view));
+}
+
+// ============= Memory Pressure =============
+
+// Whether a home row overlaps the visible part of the home scroller
+static gboolean row_on_screen(MadariWindow *self, GtkWidget *row) {
+    graphene_rect_t bounds;
+    if (!gtk_widget_compute_bounds(row, GTK_WIDGET(self->content_scroll), &bounds)) return FALSE;
+    
+    float height = static_cast<float>(gtk_widget_get_height(GTK_WIDGET(self->content_scroll)));
+    return bounds.origin.y + bounds.size.height > 0 && bounds.origin.y < height;
+}
+
+// Bring back the posters of released home rows that scrolled into view;
+// once every row is back, scrolling stops checking
+static void restore_home_rows(MadariWindow *self) {
+    if (!self->home_images_released || madari_window_is_playing(self)) return;
+    
+    gboolean any_released = FALSE;
+    for (GtkWidget *row = gtk_widget_get_first_child(GTK_WIDGET(self->catalogs_box));
+         row != nullptr; row = gtk_widget_get_next_sibling(row)) {
+        if (!g_object_get_data(G_OBJECT(row), "images-released")) continue;
+        
+        if (row_on_screen(self, row)) {
+            madari_image_restore(row);
+            g_object_set_data(G_OBJECT(row), "images-released", nullptr);
+        } else {
+            any_released = TRUE;
+        }
+    }
+    self->home_images_released = any_released;
+}
+
+static gboolean is_home_page(MadariWindow *self, AdwNavigationPage *page) {
+    return gtk_widget_is_ancestor(GTK_WIDGET(self->catalogs_box), GTK_WIDGET(page));
+}
+
+static void on_page_showing_restore_images(AdwNavigationPage *page, MadariWindow *self) {
+    if (is_home_page(self, page)) {
+        restore_home_rows(self);
+    } else {
+        madari_image_restore(GTK_WIDGET(page));
+    }
+}
+
+gsize madari_window_release_hidden_images(MadariWindow *self) {
+    g_return_val_if_fail(MADARI_IS_WINDOW(self), 0);
+    
+    gsize released = 0;
+    gboolean playing = madari_window_is_playing(self);
+    AdwNavigationPage *visible = adw_navigation_view_get_visible_page(self->navigation_view);
+    
+    GListModel *stack = adw_navigation_view_get_navigation_stack(self->navigation_view);
+    guint n_pages = g_list_model_get_n_items(stack);
+    for (guint i = 0; i < n_pages; i++) {
+        AdwNavigationPage *page = ADW_NAVIGATION_PAGE(g_list_model_get_item(stack, i));
+        
+        if (!g_object_get_data(G_OBJECT(page), "restores-images")) {
+            g_signal_connect(page, "showing", G_CALLBACK(on_page_showing_restore_images), self);
+            g_object_set_data(G_OBJECT(page), "restores-images", GINT_TO_POINTER(TRUE));
+        }
+        
+        if (is_home_page(self, page)) {
+            // Rows in view stay unless the home page is hidden altogether
+            gboolean hidden = playing || page != visible;
+            for (GtkWidget *row = gtk_widget_get_first_child(GTK_WIDGET(self->catalogs_box));
+                 row != nullptr; row = gtk_widget_get_next_sibling(row)) {
+                if (hidden || !row_on_screen(self, row)) {
+                    released += madari_image_release(row);
+                    g_object_set_data(G_OBJECT(row), "images-released", GINT_TO_POINTER(TRUE));
+                    self->home_images_released = TRUE;
+                }
+            }
+        } else if (playing || page != visible) {
+            released += madari_image_release(GTK_WIDGET(page));
+        }
+        g_object_unref(page);
+    }
+    g_object_unref(stack);
+    
+    return released;
+}
+
+// Back from the player: the visible page gets its images again
+static void restore_visible_images(MadariWindow *self) {
+    AdwNavigationPage *visible = adw_navigation_view_get_visible_page(self->navigation_view);
+    if (visible) on_page_showing_restore_images(visible, self);
+}
+
 static void on_search_changed(GtkSearchEntry *entry, MadariWindow *self);
 static void on_search_activated(GtkSearchEntry *entry, MadariWindow *self);
 static void on_filter_toggled(GtkToggleButton *button, MadariWindow *self);
@@ -1010,8 +1368,25 @@ static void madari_window_class_init(MadariWindowClass *klass) {
 static void perform_search(MadariWindow *self, const char *query);
 static void clear_search(MadariWindow *self);
 
-static void on_search_changed([[maybe_unused]] GtkSearchEntry *entry, [[maybe_unused]] MadariWindow *self) {
-    // Live search as user types - with debounce could be added here
+// Quiet time after the last keystroke before addons are asked
+static const guint SEARCH_DEBOUNCE_MS = 300;
+
+// Shorter live queries match too much to be worth a request per catalog
+static const glong SEARCH_MIN_LIVE_CHARS = 2;
+
+// "search-changed" is delayed by the entry until typing pauses (see init)
+static void on_search_changed(GtkSearchEntry *entry, MadariWindow *self) {
+    const char *text = gtk_editable_get_text(GTK_EDITABLE(entry));
+    if (!text || strlen(text) == 0) {
+        if (self->is_searching) clear_search(self);
+        return;
+    }
+    
+    g_autofree gchar *query = g_strstrip(g_strdup(text));
+    if (g_utf8_strlen(query, -1) < SEARCH_MIN_LIVE_CHARS) return;
+    if (self->current_search_query && *self->current_search_query == query) return;
+    
+    perform_search(self, query);
 }
 
 static void on_search_activated(GtkSearchEntry *entry, MadariWindow *self) {
@@ -1022,7 +1397,11 @@ static void on_search_activated(GtkSearchEntry *entry, MadariWindow *self) {
         return;
     }
     
-    perform_search(self, text);
+    // Already running from the live search
+    g_autofree gchar *query = g_strstrip(g_strdup(text));
+    if (self->is_searching && self->current_search_query && *self->current_search_query == query) return;
+    
+    perform_search(self, query);
 }
 
 static void on_search_stopped([[maybe_unused]] GtkSearchEntry *entry, MadariWindow *self) {
@@ -1030,13 +1409,57 @@ static void on_search_stopped([[maybe_unused]] GtkSearchEntry *entry, MadariWind
     clear_search(self);
 }
 
+static void cancel_search_requests(MadariWindow *self) {
+    if (self->search_cancellable) {
+        g_cancellable_cancel(self->search_cancellable);
+        g_clear_object(&self->search_cancellable);
+    }
+}
+
 static void clear_search(MadariWindow *self) {
+    cancel_search_requests(self);
     self->is_searching = FALSE;
     delete self->current_search_query;
     self->current_search_query = nullptr;
+    g_clear_object(&self->search_results);
     load_catalogs(self);
 }
 
+/**
+ * Bring store in line with the ranked results, touching only the positions
+ * that changed so existing posters keep their widgets and loaded images
+ */
+static void sync_search_results(GListStore *store, const std::vector<const Stremio::SearchResult*>& results) {
+    GListModel *model = G_LIST_MODEL(store);
+    
+    for (guint i = 0; i < results.size(); i++) {
+        const Stremio::MetaPreview& want = results[i]->meta;
+        guint n = g_list_model_get_n_items(model);
+        
+        if (i < n) {
+            g_autoptr(MadariSearchItem) current = MADARI_SEARCH_ITEM(g_list_model_get_item(model, i));
+            // Same item, unless a later addon filled in the poster it lacked
+            if (current->meta->id == want.id && current->meta->poster == want.poster) continue;
+        }
+        
+        for (guint j = i; j < n; j++) {
+            g_autoptr(MadariSearchItem) other = MADARI_SEARCH_ITEM(g_list_model_get_item(model, j));
+            if (other->meta->id == want.id) {
+                g_list_store_remove(store, j);
+                break;
+            }
+        }
+        
+        g_autoptr(MadariSearchItem) item = madari_search_item_new(want);
+        g_list_store_insert(store, i, item);
+    }
+    
+    guint n = g_list_model_get_n_items(model);
+    if (n > results.size()) {
+        g_list_store_splice(store, results.size(), n - results.size(), nullptr, 0);
+    }
+}
+
 static void perform_search(MadariWindow *self, const char *query) {
     Stremio::AddonService *service = madari_application_get_addon_service(self->app);
     if (!service) return;
@@ -1046,101 +1469,87 @@ static void perform_search(MadariWindow *self, const char *query) {
     self->current_search_query = new std::string(query);
     self->is_searching = TRUE;
     
-    // Clear existing content
-    clear_catalogs_box(self);
-    
-    // Show loading
-    gtk_stack_set_visible_child_name(self->main_stack, "loading");
-    
-    // Create search results header
-    GtkWidget *header_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
-    gtk_widget_set_margin_bottom(header_box, 16);
-    
-    GtkWidget *back_btn = gtk_button_new_from_icon_name("go-previous-symbolic");
-    gtk_widget_add_css_class(back_btn, "flat");
-    g_signal_connect(back_btn, "clicked", G_CALLBACK(+[](GtkButton*, gpointer user_data) {
-        MadariWindow *self = MADARI_WINDOW(user_data);
-        gtk_editable_set_text(GTK_EDITABLE(self->search_entry), "");
-        gtk_search_bar_set_search_mode(self->search_bar, FALSE);
-        clear_search(self);
-    }), self);
-    gtk_box_append(GTK_BOX(header_box), back_btn);
+    // Drop requests still running for the previous query
+    cancel_search_requests(self);
+    self->search_cancellable = g_cancellable_new();
+    guint generation = ++self->search_generation;
     
     std::string title = "Search results for \"" + std::string(query) + "\"";
-    GtkWidget *title_label = gtk_label_new(title.c_str());
-    gtk_widget_add_css_class(title_label, "title-2");
-    gtk_widget_set_halign(title_label, GTK_ALIGN_START);
-    gtk_widget_set_hexpand(title_label, TRUE);
-    gtk_box_append(GTK_BOX(header_box), title_label);
-    
-    gtk_box_append(self->catalogs_box, header_box);
-    
-    // Create results container
-    GtkWidget *results_flow = gtk_flow_box_new();
-    gtk_flow_box_set_selection_mode(GTK_FLOW_BOX(results_flow), GTK_SELECTION_NONE);
-    gtk_flow_box_set_homogeneous(GTK_FLOW_BOX(results_flow), FALSE);
-    gtk_flow_box_set_column_spacing(GTK_FLOW_BOX(results_flow), 16);
-    gtk_flow_box_set_row_spacing(GTK_FLOW_BOX(results_flow), 16);
-    gtk_flow_box_set_min_children_per_line(GTK_FLOW_BOX(results_flow), 2);
-    gtk_flow_box_set_max_children_per_line(GTK_FLOW_BOX(results_flow), 10);
     
-    g_object_set_data(G_OBJECT(self->catalogs_box), "search-results", results_flow);
-    gtk_box_append(self->catalogs_box, results_flow);
+    if (self->search_flow) {
+        // Refining a live search: keep the page and the grid; posters that
+        // still match keep their widgets as the new results are synced in
+        gtk_label_set_text(self->search_title, title.c_str());
+    } else {
+        // Clear existing content
+        clear_catalogs_box(self);
+        
+        // Show loading
+        gtk_stack_set_visible_child_name(self->main_stack, "loading");
+        
+        // Create search results header
+        GtkWidget *header_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+        gtk_widget_set_margin_bottom(header_box, 16);
+        
+        GtkWidget *back_btn = gtk_button_new_from_icon_name("go-previous-symbolic");
+        gtk_widget_add_css_class(back_btn, "flat");
+        g_signal_connect(back_btn, "clicked", G_CALLBACK(+[](GtkButton*, gpointer user_data) {
+            MadariWindow *self = MADARI_WINDOW(user_data);
+            clear_search(self);
+            gtk_editable_set_text(GTK_EDITABLE(self->search_entry), "");
+            gtk_search_bar_set_search_mode(self->search_bar, FALSE);
+        }), self);
+        gtk_box_append(GTK_BOX(header_box), back_btn);
+        
+        GtkWidget *title_label = gtk_label_new(title.c_str());
+        gtk_widget_add_css_class(title_label, "title-2");
+        gtk_widget_set_halign(title_label, GTK_ALIGN_START);
+        gtk_widget_set_hexpand(title_label, TRUE);
+        gtk_box_append(GTK_BOX(header_box), title_label);
+        
+        gtk_box_append(self->catalogs_box, header_box);
+        
+        // One grid over the ranked model; rows are only rebuilt where the ranking moved
+        GtkWidget *results_flow = gtk_flow_box_new();
+        gtk_flow_box_set_selection_mode(GTK_FLOW_BOX(results_flow), GTK_SELECTION_NONE);
+        gtk_flow_box_set_homogeneous(GTK_FLOW_BOX(results_flow), FALSE);
+        gtk_flow_box_set_column_spacing(GTK_FLOW_BOX(results_flow), 16);
+        gtk_flow_box_set_row_spacing(GTK_FLOW_BOX(results_flow), 16);
+        gtk_flow_box_set_min_children_per_line(GTK_FLOW_BOX(results_flow), 2);
+        gtk_flow_box_set_max_children_per_line(GTK_FLOW_BOX(results_flow), 10);
+        gtk_box_append(self->catalogs_box, results_flow);
+        
+        self->search_title = GTK_LABEL(title_label);
+        self->search_flow = GTK_FLOW_BOX(results_flow);
+        
+        g_clear_object(&self->search_results);
+        self->search_results = g_list_store_new(MADARI_TYPE_SEARCH_ITEM);
+        gtk_flow_box_bind_model(self->search_flow, G_LIST_MODEL(self->search_results),
+            [](gpointer item, gpointer) -> GtkWidget* {
+                return create_poster_item(*MADARI_SEARCH_ITEM(item)->meta);
+            }, nullptr, nullptr);
+    }
     
     // Track if we got any results
     auto has_results = std::make_shared<bool>(false);
     
-    // Perform search
-    service->search(
+    Stremio::RequestOptions options;
+    options.cancellable = self->search_cancellable;
+    
+    service->search_ranked(
         query,
-        [self, results_flow, has_results](const Stremio::Manifest& addon, 
-                                           const Stremio::CatalogDefinition& catalog, 
-                                           const std::vector<Stremio::MetaPreview>& results) {
-            *has_results = true;
-            
-            // Add section header for this addon/catalog
-            std::string section_title = addon.name + " - " + 
-                (catalog.name.empty() ? catalog.type : catalog.name);
-            
-            GtkWidget *section_label = gtk_label_new(section_title.c_str());
-            gtk_widget_add_css_class(section_label, "title-4");
-            gtk_widget_add_css_class(section_label, "dim-label");
-            gtk_widget_set_halign(section_label, GTK_ALIGN_START);
-            gtk_widget_set_margin_top(section_label, 16);
-            gtk_widget_set_margin_bottom(section_label, 8);
-            
-            // Insert before results flow
-            GtkWidget *flow = GTK_WIDGET(g_object_get_data(G_OBJECT(self->catalogs_box), "search-results"));
-            if (flow) {
-                // Create a section box
-                GtkWidget *section_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
-                gtk_widget_set_margin_top(section_box, 8);
-                
-                for (const auto& meta : results) {
-                    GtkWidget *item = create_poster_item(meta);
-                    gtk_box_append(GTK_BOX(section_box), item);
-                }
-                
-                // Wrap in scrolled window
-                GtkWidget *section_scroll = gtk_scrolled_window_new();
-                gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(section_scroll), 
-                                               GTK_POLICY_AUTOMATIC, GTK_POLICY_NEVER);
-                gtk_widget_set_size_request(section_scroll, -1, 320);
-                gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(section_scroll), section_box);
-                
-                // Add to catalogs box before the flow
-                GtkWidget *container = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
-                gtk_box_append(GTK_BOX(container), section_label);
-                gtk_box_append(GTK_BOX(container), section_scroll);
-                
-                // Insert before flow box
-                gtk_box_insert_child_after(self->catalogs_box, container, 
-                    gtk_widget_get_prev_sibling(flow));
-            }
+        [self, generation, has_results](const std::vector<const Stremio::SearchResult*>& results) {
+            // Results of a superseded query must not land in this one's model
+            if (generation != self->search_generation || !self->search_results) return;
             
+            *has_results = true;
+            sync_search_results(self->search_results, results);
             gtk_stack_set_visible_child_name(self->main_stack, "content");
         },
-        [self, has_results]() {
+        [self, generation, has_results]() {
+            if (generation != self->search_generation || !self->search_results) return;
+            
+            // The grid may still show the previous query's results
             if (!*has_results) {
                 // Show no results message
                 clear_catalogs_box(self);
@@ -1156,7 +1565,8 @@ static void perform_search(MadariWindow *self, const char *query) {
             }
             
             gtk_stack_set_visible_child_name(self->main_stack, "content");
-        }
+        },
+        options
     );
 }
 
@@ -1183,12 +1593,23 @@ static void on_filter_toggled(GtkToggleButton *button, MadariWindow *self) {
 }
 
 static void madari_window_init(MadariWindow *self) {
-    gtk_widget_init_template(GTK_WIDGET(self));
+    {
+        Madari::ProfileSpan span("window template init", "ui");
+        gtk_widget_init_template(GTK_WIDGET(self));
+    }
     self->pending_catalogs = 0;
+    self->home_images_released = FALSE;
     self->soup_session = nullptr;
+    self->meta_prefetch_cancellable = nullptr;
+    self->meta_prefetch_budget = META_PREFETCH_BUDGET;
     self->current_filter = new std::string("");
     self->current_search_query = nullptr;
     self->is_searching = FALSE;
+    self->search_results = nullptr;
+    self->search_cancellable = nullptr;
+    self->search_generation = 0;
+    self->search_title = nullptr;
+    self->search_flow = nullptr;
     self->current_meta_id = nullptr;
     self->current_meta_type = nullptr;
     self->current_video_id = nullptr;
@@ -1197,6 +1618,11 @@ static void madari_window_init(MadariWindow *self) {
     self->current_season = 0;
     self->episode_list = nullptr;
     self->current_episode_index = -1;
+    self->prefetched_episode_index = -1;
+    self->next_episode_resolving = FALSE;
+    self->playback_generation = 0;
+    self->player_source = nullptr;
+    self->queued_source = nullptr;
     
     // Watch history tracking initialization
     self->current_poster_url = nullptr;
@@ -1226,6 +1652,9 @@ MadariWindow *madari_window_new(MadariApplication *app) {
     // Connect search bar to search entry
     gtk_search_bar_connect_entry(window->search_bar, GTK_EDITABLE(window->search_entry));
     
+    // Live search: wait for a pause in typing before asking addons
+    gtk_search_entry_set_search_delay(window->search_entry, SEARCH_DEBOUNCE_MS);
+    
     // Connect search signals
     g_signal_connect(window->search_entry, "search-changed",
                      G_CALLBACK(on_search_changed), window);
@@ -1244,6 +1673,10 @@ MadariWindow *madari_window_new(MadariApplication *app) {
     g_signal_connect(window->filter_channels, "toggled",
                      G_CALLBACK(on_filter_toggled), window);
     
+    // Posters of rows released under memory pressure come back into view
+    g_signal_connect_swapped(gtk_scrolled_window_get_vadjustment(window->content_scroll), "value-changed",
+                             G_CALLBACK(restore_home_rows), window);
+    
     // Subscribe to addon changes
     Stremio::AddonService *service = madari_application_get_addon_service(app);
     if (service) {
@@ -1252,8 +1685,56 @@ MadariWindow *madari_window_new(MadariApplication *app) {
         });
     }
     
-    // Initial load
-    load_catalogs(window);
+    // Catalogs that changed on a background refresh: update their home rows.
+    // The refresher belongs to the application and outlives this window.
+    Madari::CatalogRefresher *refresher = madari_application_get_catalog_refresher(app);
+    if (refresher) {
+        auto ref = window_weak_ref(window);
+        refresher->on_updated([ref](const std::string& key, const Stremio::CatalogResponse& response) {
+            g_autoptr(MadariWindow) window = static_cast<MadariWindow*>(g_weak_ref_get(ref.get()));
+            if (!window) return;
+            
+            for (GtkWidget *section = gtk_widget_get_first_child(GTK_WIDGET(window->catalogs_box));
+                 section != nullptr; section = gtk_widget_get_next_sibling(section)) {
+                const char *section_key = static_cast<const char*>(g_object_get_data(G_OBJECT(section), "catalog-key"));
+                if (section_key && key == section_key) {
+                    GtkBox *items_box = GTK_BOX(g_object_get_data(G_OBJECT(section), "items-box"));
+                    fill_catalog_row(items_box, response, "");
+                }
+            }
+        });
+    }
+    
+    // mpv filters its messages itself; tell it when our level changes
+    auto log_ref = window_weak_ref(window);
+    Madari::Log::on_level_changed([log_ref](Madari::LogLevel) {
+        g_autoptr(MadariWindow) window = static_cast<MadariWindow*>(g_weak_ref_get(log_ref.get()));
+        if (window && window->mpv) request_mpv_log_messages(window);
+    });
+    
+    // Mark the first frame in the trace, the end of startup as users see it
+    if (Madari::Profiler::enabled()) {
+        g_signal_connect(window, "realize", G_CALLBACK(profile_first_frame), nullptr);
+    }
+    
+    // Services load on worker threads; the home fills in as each is ready,
+    // catalogs first and Continue Watching again once history and Trakt are in
+    gtk_stack_set_visible_child_name(window->main_stack, "loading");
+    if (service) {
+        service->when_ready(window_ready_callback(window, load_catalogs));
+    } else {
+        load_catalogs(window);
+    }
+    
+    Madari::WatchHistoryService *history = madari_application_get_watch_history(app);
+    if (history && !history->is_ready()) {
+        history->when_ready(window_ready_callback(window, refresh_continue_watching));
+    }
+    
+    Trakt::TraktService *trakt = madari_application_get_trakt_service(app);
+    if (trakt && !trakt->is_ready()) {
+        trakt->when_ready(window_ready_callback(window, refresh_continue_watching));
+    }
     
     return window;
 }
@@ -1266,6 +1747,7 @@ static void update_player_ui(MadariWindow *self);
 static void show_player_controls(MadariWindow *self);
 static void schedule_hide_player_controls(MadariWindow *self);
 static void update_track_menus(MadariWindow *self);
+static void player_report_first_frame(MadariWindow *self);
 static void on_player_fullscreen(GtkButton *btn, MadariWindow *self);
 
 static void *player_get_proc_address([[maybe_unused]] void *ctx, const char *name) {
@@ -1385,6 +1867,86 @@ static void stop_history_save_timer(MadariWindow *self) {
 
 // ============= End Watch History Functions =============
 
+static void maybe_prefetch_next_episode(MadariWindow *self);
+static void advance_to_prefetched_episode(MadariWindow *self);
+
+// ============= Playback Outcomes =============
+
+// A source still loading after this long when it gets replaced or stopped
+// counts as failed - dead torrents rarely produce a proper error
+static const gint64 SOURCE_ABANDON_US = 15 * G_USEC_PER_SEC;
+
+static Madari::SourceStatsService* get_source_stats(MadariWindow *self) {
+    return self->app ? madari_application_get_source_stats(self->app) : nullptr;
+}
+
+/**
+ * Record how the current source ended up and forget it.
+ */
+static void player_finish_source(MadariWindow *self) {
+    if (!self->player_source) return;
+    
+    if (self->player_first_frame_pending &&
+        g_get_monotonic_time() - self->player_load_started > SOURCE_ABANDON_US) {
+        if (Madari::SourceStatsService *stats = get_source_stats(self)) {
+            stats->record_error(*self->player_source);
+        }
+    }
+    
+    delete self->player_source;
+    self->player_source = nullptr;
+}
+
+/**
+ * Remember which addon the file about to be loaded came from. Call before
+ * loading it; addon_id may be null when the origin isn't known.
+ */
+static void player_set_source(MadariWindow *self, const char *addon_id, const std::string& url,
+                              const char *binge_group) {
+    player_finish_source(self);
+    if (!addon_id || !*addon_id) return;
+    self->player_source = new Madari::PlaybackSource{addon_id, url, binge_group ? binge_group : ""};
+}
+
+static void player_clear_queued_source(MadariWindow *self) {
+    delete self->queued_source;
+    self->queued_source = nullptr;
+}
+
+/**
+ * The queued next episode became the playing file.
+ */
+static void player_promote_queued_source(MadariWindow *self) {
+    player_finish_source(self);
+    self->player_source = self->queued_source;
+    self->queued_source = nullptr;
+}
+
+static void player_record_error(MadariWindow *self) {
+    if (!self->player_source) return;
+    if (Madari::SourceStatsService *stats = get_source_stats(self)) {
+        stats->record_error(*self->player_source);
+    }
+    // Already counted, don't count it again as abandoned
+    delete self->player_source;
+    self->player_source = nullptr;
+}
+
+static void player_record_stall(MadariWindow *self) {
+    if (!self->player_source) return;
+    if (Madari::SourceStatsService *stats = get_source_stats(self)) {
+        stats->record_stall(*self->player_source);
+    }
+}
+
+static Madari::LogLevel player_log_level(mpv_log_level level) {
+    if (level <= MPV_LOG_LEVEL_ERROR) return Madari::LogLevel::Error;
+    if (level <= MPV_LOG_LEVEL_WARN) return Madari::LogLevel::Warning;
+    if (level <= MPV_LOG_LEVEL_INFO) return Madari::LogLevel::Info;
+    if (level <= MPV_LOG_LEVEL_V) return Madari::LogLevel::Debug;
+    return Madari::LogLevel::Trace;
+}
+
 static void on_player_mpv_events(MadariWindow *self) {
     if (!self->mpv) return;
     
@@ -1403,6 +1965,7 @@ static void on_player_mpv_events(MadariWindow *self) {
                     }
                     // Schedule watch history save (will be batched)
                     schedule_history_save(self);
+                    maybe_prefetch_next_episode(self);
                 } else if (strcmp(prop->name, "duration") == 0 && prop->format == MPV_FORMAT_DOUBLE) {
                     self->player_duration = *static_cast<double*>(prop->data);
                     update_player_ui(self);
@@ -1426,7 +1989,8 @@ static void on_player_mpv_events(MadariWindow *self) {
                         }
                     }
                 } else if (strcmp(prop->name, "eof-reached") == 0 && prop->format == MPV_FORMAT_FLAG) {
-                    if (*static_cast<int*>(prop->data)) {
+                    // With a next episode queued mpv advances the playlist on its own
+                    if (*static_cast<int*>(prop->data) && self->prefetched_episode_index < 0) {
                         // Trakt: Video ended - send stop scrobble with 100% progress
                         if (self->scrobble_started) {
                             self->player_position = self->player_duration;  // Ensure 100%
@@ -1440,6 +2004,11 @@ static void on_player_mpv_events(MadariWindow *self) {
                 } else if (strcmp(prop->name, "core-idle") == 0 && prop->format == MPV_FORMAT_FLAG) {
                     gboolean idle = *static_cast<int*>(prop->data);
                     gtk_widget_set_visible(self->player_loading, idle && self->player_is_playing);
+                } else if (strcmp(prop->name, "paused-for-cache") == 0 && prop->format == MPV_FORMAT_FLAG) {
+                    // Rebuffering after the first frame counts against the source
+                    if (*static_cast<int*>(prop->data) && !self->player_first_frame_pending) {
+                        player_record_stall(self);
+                    }
                 }
                 break;
             }
@@ -1456,14 +2025,31 @@ static void on_player_mpv_events(MadariWindow *self) {
             case MPV_EVENT_START_FILE:
                 gtk_widget_set_visible(self->player_loading, TRUE);
                 break;
+            case MPV_EVENT_PLAYBACK_RESTART:
+                player_report_first_frame(self);
+                break;
             case MPV_EVENT_END_FILE: {
                 mpv_event_end_file *end = static_cast<mpv_event_end_file*>(event->data);
                 if (end->reason == MPV_END_FILE_REASON_ERROR) {
                     g_warning("MPV playback error: %s", mpv_error_string(end->error));
+                    player_record_error(self);
+                } else if (end->reason == MPV_END_FILE_REASON_EOF && self->prefetched_episode_index >= 0) {
+                    advance_to_prefetched_episode(self);
                 }
                 gtk_widget_set_visible(self->player_loading, FALSE);
                 break;
             }
+            case MPV_EVENT_LOG_MESSAGE: {
+                mpv_event_log_message *msg = static_cast<mpv_event_log_message*>(event->data);
+                Madari::LogLevel level = player_log_level(msg->log_level);
+                if (Madari::Log::enabled(level)) {
+                    // mpv ends each message with a newline
+                    std::string text = msg->text;
+                    while (!text.empty() && text.back() == '\n') text.pop_back();
+                    Madari::Log::write(level, "mpv", text.c_str(), {{"module", msg->prefix}});
+                }
+                break;
+            }
             default:
                 break;
         }
@@ -1493,15 +2079,130 @@ static void player_mpv_wakeup(void *ctx) {
     }
 }
 
+/**
+ * Load a file into mpv, optionally starting at a resume point.
+ *
+ * start is passed as the per-file "start" option (same syntax as --start,
+ * e.g. "754.2" or "37.5%"), so the demuxer opens directly at the resume
+ * position instead of reading the beginning of the file and seeking later.
+ * Named arguments are used so this works on mpv builds with and without
+ * the positional index argument that 0.38 inserted before "options".
+ */
+static void player_loadfile(MadariWindow *self, const char *url, const char *flags, const char *start) {
+    if (!self->mpv || !url) return;
+    
+    // Replacing the file also clears mpv's playlist, so anything queued is gone
+    if (!flags || strcmp(flags, "replace") == 0) {
+        self->player_load_started = g_get_monotonic_time();
+        self->player_first_frame_pending = TRUE;
+        self->playback_generation++;
+        self->prefetched_episode_index = -1;
+        self->next_episode_resolving = FALSE;
+        player_clear_queued_source(self);
+    }
+    
+    if (!start || !*start) {
+        const char *cmd[] = {"loadfile", url, flags, nullptr};
+        mpv_command_async(self->mpv, 0, cmd);
+        return;
+    }
+    
+    char *option_keys[] = {const_cast<char*>("start")};
+    mpv_node option_values[1];
+    option_values[0].format = MPV_FORMAT_STRING;
+    option_values[0].u.string = const_cast<char*>(start);
+    mpv_node_list options = {1, option_values, option_keys};
+    
+    char *arg_keys[] = {
+        const_cast<char*>("name"), const_cast<char*>("url"),
+        const_cast<char*>("flags"), const_cast<char*>("options")
+    };
+    mpv_node arg_values[4];
+    arg_values[0].format = MPV_FORMAT_STRING;
+    arg_values[0].u.string = const_cast<char*>("loadfile");
+    arg_values[1].format = MPV_FORMAT_STRING;
+    arg_values[1].u.string = const_cast<char*>(url);
+    arg_values[2].format = MPV_FORMAT_STRING;
+    arg_values[2].u.string = const_cast<char*>(flags ? flags : "replace");
+    arg_values[3].format = MPV_FORMAT_NODE_MAP;
+    arg_values[3].u.list = &options;
+    mpv_node_list args = {4, arg_values, arg_keys};
+    
+    mpv_node cmd;
+    cmd.format = MPV_FORMAT_NODE_MAP;
+    cmd.u.list = &args;
+    mpv_command_node_async(self->mpv, 0, &cmd);
+}
+
+/**
+ * Load the URL stashed by madari_window_play_video once the GL area is ready,
+ * together with its pending start position.
+ */
+static void player_load_pending(MadariWindow *self) {
+    const char *pending_url = static_cast<const char*>(g_object_get_data(G_OBJECT(self), "pending-url"));
+    if (!pending_url) return;
+    
+    const char *pending_start = static_cast<const char*>(g_object_get_data(G_OBJECT(self), "pending-start"));
+    player_loadfile(self, pending_url, "replace", pending_start);
+    g_object_set_data(G_OBJECT(self), "pending-url", nullptr);
+    g_object_set_data(G_OBJECT(self), "pending-start", nullptr);
+}
+
+// Bytes in mpv's demuxer cache, -1 if unknown (no file loaded)
+static int64_t player_demuxer_cache_bytes(MadariWindow *self) {
+    int64_t cached_bytes = -1;
+    if (!self->mpv) return cached_bytes;
+    
+    mpv_node state;
+    if (mpv_get_property(self->mpv, "demuxer-cache-state", MPV_FORMAT_NODE, &state) >= 0) {
+        if (state.format == MPV_FORMAT_NODE_MAP) {
+            for (int i = 0; i < state.u.list->num; i++) {
+                if (strcmp(state.u.list->keys[i], "total-bytes") == 0 &&
+                    state.u.list->values[i].format == MPV_FORMAT_INT64) {
+                    cached_bytes = state.u.list->values[i].u.int64;
+                }
+            }
+        }
+        mpv_free_node_contents(&state);
+    }
+    return cached_bytes;
+}
+
+gint64 madari_window_get_demuxer_cache_bytes(MadariWindow *self) {
+    g_return_val_if_fail(MADARI_IS_WINDOW(self), -1);
+    return player_demuxer_cache_bytes(self);
+}
+
+/**
+ * Log how long it took from loadfile to the first decoded frame and how much
+ * the demuxer had buffered by then. Used to compare resume-at-load against
+ * the old play-then-seek behaviour.
+ */
+static void player_report_first_frame(MadariWindow *self) {
+    if (!self->player_first_frame_pending) return;
+    self->player_first_frame_pending = FALSE;
+    
+    double elapsed_ms = (g_get_monotonic_time() - self->player_load_started) / 1000.0;
+    int64_t cached_bytes = player_demuxer_cache_bytes(self);
+    
+    g_info("Player: first frame after %.0f ms at %.1fs (%" G_GINT64_FORMAT " bytes buffered)",
+           elapsed_ms, self->player_position, static_cast<gint64>(cached_bytes));
+    
+    if (self->player_source) {
+        if (Madari::SourceStatsService *stats = get_source_stats(self)) {
+            stats->record_start(*self->player_source, elapsed_ms);
+        }
+    }
+}
+
 static void on_video_realize([[maybe_unused]] GtkWidget *widget, gpointer user_data) {
     MadariWindow *self = MADARI_WINDOW(user_data);
     
-    g_print("on_video_realize called\n");
+    MADARI_LOG_DEBUG("player", "video area realized", {"mpv", self->mpv != nullptr},
+                     {"render_context", self->mpv_gl != nullptr});
     
     if (!self->mpv) {
-        g_print("  Setting up MPV...\n");
         setup_player_mpv(self);
-        g_print("  MPV setup done, mpv=%p\n", (void*)self->mpv);
     }
     
     gtk_gl_area_make_current(self->video_area);
@@ -1513,7 +2214,6 @@ static void on_video_realize([[maybe_unused]] GtkWidget *widget, gpointer user_d
     }
     
     if (self->mpv && !self->mpv_gl) {
-        g_print("  Creating MPV GL context...\n");
         mpv_opengl_init_params gl_init_params = {
             .get_proc_address = player_get_proc_address,
             .get_proc_address_ctx = nullptr,
@@ -1530,17 +2230,11 @@ static void on_video_realize([[maybe_unused]] GtkWidget *widget, gpointer user_d
             return;
         }
         
-        g_print("  MPV GL context created, mpv_gl=%p\n", (void*)self->mpv_gl);
+        MADARI_LOG_DEBUG("player", "render context created");
         mpv_render_context_set_update_callback(self->mpv_gl, on_player_render_update, self);
         
         // Check for pending URL
-        const char *pending_url = static_cast<const char*>(g_object_get_data(G_OBJECT(self), "pending-url"));
-        if (pending_url) {
-            g_print("  Playing pending URL: %s\n", pending_url);
-            const char *cmd[] = {"loadfile", pending_url, nullptr};
-            mpv_command_async(self->mpv, 0, cmd);
-            g_object_set_data(G_OBJECT(self), "pending-url", nullptr);
-        }
+        player_load_pending(self);
     }
 }
 
@@ -1597,6 +2291,9 @@ static void setup_player_mpv(MadariWindow *self) {
     mpv_set_option_string(self->mpv, "vo", "libmpv");
     mpv_set_option_string(self->mpv, "hwdec", "auto");
     mpv_set_option_string(self->mpv, "keep-open", "no");
+    // Start opening the next playlist entry (the queued next episode) while
+    // the current one is still playing
+    mpv_set_option_string(self->mpv, "prefetch-playlist", "yes");
     
     if (mpv_initialize(self->mpv) < 0) {
         g_warning("Failed to initialize MPV");
@@ -1610,11 +2307,27 @@ static void setup_player_mpv(MadariWindow *self) {
     mpv_observe_property(self->mpv, 0, "pause", MPV_FORMAT_FLAG);
     mpv_observe_property(self->mpv, 0, "eof-reached", MPV_FORMAT_FLAG);
     mpv_observe_property(self->mpv, 0, "core-idle", MPV_FORMAT_FLAG);
+    mpv_observe_property(self->mpv, 0, "paused-for-cache", MPV_FORMAT_FLAG);
     mpv_observe_property(self->mpv, 0, "track-list", MPV_FORMAT_NODE);
     
+    request_mpv_log_messages(self);
+    
     mpv_set_wakeup_callback(self->mpv, player_mpv_wakeup, self);
 }
 
+// mpv's own messages go to our log, at the level the log records
+static void request_mpv_log_messages(MadariWindow *self) {
+    const char *mpv_level = "warn";
+    if (MADARI_LOG_MAX_LEVEL >= 4 && Madari::Log::enabled(Madari::LogLevel::Trace)) {
+        mpv_level = "debug";
+    } else if (Madari::Log::enabled(Madari::LogLevel::Debug)) {
+        mpv_level = "v";
+    } else if (Madari::Log::enabled(Madari::LogLevel::Info)) {
+        mpv_level = "info";
+    }
+    mpv_request_log_messages(self->mpv, mpv_level);
+}
+
 static void cleanup_player_mpv(MadariWindow *self) {
     if (self->mpv_gl) {
         mpv_render_context_free(self->mpv_gl);
@@ -2109,7 +2822,7 @@ static void on_player_screenshot([[maybe_unused]] GtkButton *btn, MadariWindow *
     const char *cmd[] = {"screenshot-to-file", filename, "video", nullptr};
     mpv_command_async(self->mpv, 0, cmd);
     
-    g_print("Screenshot saved to: %s\n", filename);
+    MADARI_LOG_INFO("player", "screenshot requested", {"path", filename});
     
     g_date_time_unref(now);
     g_free(timestamp);
@@ -2187,20 +2900,174 @@ static void on_video_double_click([[maybe_unused]] GtkGestureClick *gesture,
 static void show_episode_streams_dialog(MadariWindow *self, const std::string& video_id, 
                                          const std::string& episode_title);
 
-static void play_episode_by_index(MadariWindow *self, int index) {
-    if (!self->episode_list || index < 0 || index >= (int)self->episode_list->size()) {
+/**
+ * Turn a stream into something mpv can open (direct URL or magnet link).
+ */
+static std::optional<std::string> stream_playback_url(const Stremio::Stream& stream) {
+    if (stream.url.has_value()) {
+        return *stream.url;
+    }
+    if (stream.info_hash.has_value()) {
+        // Build magnet URL for torrent
+        std::string stream_url = "magnet:?xt=urn:btih:" + *stream.info_hash;
+        for (const auto& src : stream.sources) {
+            stream_url += "&tr=" + src;
+        }
+        return stream_url;
+    }
+    return std::nullopt;
+}
+
+// After the first binge-group match, how long other addons get to offer the same group
+static const guint BINGE_COLLECT_GRACE_MS = 1500;
+
+// A faster probe only beats a source with a better playback record within this margin
+static const double BINGE_PREFERENCE_SLACK = 15.0;
+
+struct BingeCandidate {
+    std::string addon_id;
+    Stremio::Stream stream;
+    double preference = 0;
+};
+
+struct BingeMatch {
+    std::string url;
+    std::string addon_id;
+};
+
+struct BingeResolve {
+    MadariWindow *window;
+    std::string binge_group;
+    std::vector<BingeCandidate> candidates;
+    guint grace_id = 0;
+    bool decided = false;
+    std::function<void(std::optional<BingeMatch>)> callback;
+};
+
+static BingeMatch make_binge_match(const BingeCandidate& candidate) {
+    return BingeMatch{stream_playback_url(candidate.stream).value_or(""), candidate.addon_id};
+}
+
+/**
+ * Settle on one of the collected binge-group matches. Candidates are ordered
+ * by their playback record first; with several direct HTTP sources (e.g. the
+ * same release from two debrid addons) they are probed and the fastest one
+ * wins, unless its record is clearly worse.
+ */
+static void decide_binge_stream(const std::shared_ptr<BingeResolve>& state) {
+    if (state->decided) return;
+    state->decided = true;
+    if (state->grace_id > 0) {
+        g_source_remove(state->grace_id);
+        state->grace_id = 0;
+    }
+    
+    if (state->candidates.empty()) {
+        state->callback(std::nullopt);
         return;
     }
     
-    // Trakt: Stop scrobble for current episode before switching
-    if (self->scrobble_started) {
-        trigger_scrobble(self, "stop");
-        self->scrobble_started = FALSE;
+    if (Madari::SourceStatsService *stats = get_source_stats(state->window)) {
+        for (auto& candidate : state->candidates) {
+            candidate.preference = stats->preference(candidate.addon_id, candidate.stream);
+        }
+        std::stable_sort(state->candidates.begin(), state->candidates.end(),
+            [](const BingeCandidate& a, const BingeCandidate& b) {
+                return a.preference > b.preference;
+            });
+    }
+    
+    std::vector<Stremio::Stream> streams;
+    for (const auto& candidate : state->candidates) {
+        streams.push_back(candidate.stream);
+    }
+    
+    size_t probeable = std::count_if(streams.begin(), streams.end(), Stremio::StreamProbe::is_probeable);
+    Stremio::AddonService *service = madari_application_get_addon_service(state->window->app);
+    if (probeable < 2 || !service) {
+        state->callback(make_binge_match(state->candidates.front()));
+        return;
+    }
+    
+    Stremio::ProbeOptions options;
+    options.range_bytes = 256 * 1024;
+    options.timeout_ms = 2500;
+    service->probe_streams(streams, options, nullptr,
+        [state](const std::vector<Stremio::ProbeResult>& results) {
+            size_t pick = 0;
+            double best_preference = state->candidates.front().preference;
+            for (const auto& result : results) {
+                if (!result.ok) break;
+                if (state->candidates[result.index].preference >= best_preference - BINGE_PREFERENCE_SLACK) {
+                    pick = result.index;
+                    g_info("Player: picked binge stream %zu of %zu (%s)", pick + 1,
+                           state->candidates.size(), Stremio::StreamProbe::describe(result).c_str());
+                    break;
+                }
+            }
+            state->callback(make_binge_match(state->candidates[pick]));
+        });
+}
+
+/**
+ * Resolve the stream for video_id that continues the current binge group
+ * (same addon, quality and release). callback gets the URL and the addon
+ * offering it, or nullopt when no addon offered a match.
+ */
+static void resolve_binge_stream(MadariWindow *self, const std::string& video_id,
+                                 const std::string& binge_group,
+                                 std::function<void(std::optional<BingeMatch>)> callback) {
+    Stremio::AddonService *service = madari_application_get_addon_service(self->app);
+    if (!service || !self->current_meta_type || binge_group.empty()) {
+        callback(std::nullopt);
+        return;
     }
     
+    auto state = std::make_shared<BingeResolve>();
+    state->window = self;
+    state->binge_group = binge_group;
+    state->callback = std::move(callback);
+    
+    service->fetch_all_streams(
+        *self->current_meta_type,
+        video_id,
+        [state](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
+            if (state->decided) return;
+            
+            for (const auto& stream : streams) {
+                if (stream.behavior_hints.binge_group.has_value() &&
+                    *stream.behavior_hints.binge_group == state->binge_group &&
+                    stream_playback_url(stream)) {
+                    state->candidates.push_back(BingeCandidate{addon.id, stream});
+                }
+            }
+            
+            // Don't wait for slow addons once we have something to play
+            if (!state->candidates.empty() && state->grace_id == 0) {
+                state->grace_id = g_timeout_add_full(G_PRIORITY_DEFAULT, BINGE_COLLECT_GRACE_MS,
+                    [](gpointer user_data) -> gboolean {
+                        auto state = *static_cast<std::shared_ptr<BingeResolve>*>(user_data);
+                        state->grace_id = 0;
+                        decide_binge_stream(state);
+                        return G_SOURCE_REMOVE;
+                    },
+                    new std::shared_ptr<BingeResolve>(state),
+                    [](gpointer d) { delete static_cast<std::shared_ptr<BingeResolve>*>(d); });
+            }
+        },
+        [state]() {
+            decide_binge_stream(state);
+        }
+    );
+}
+
+/**
+ * Switch the player's episode context (index, title, video id) to the
+ * given entry of the episode list. Returns the formatted title.
+ */
+static std::string apply_episode_context(MadariWindow *self, int index) {
     // Get the episode info
     const auto& episode = (*self->episode_list)[index];
-    const std::string& video_id = episode.video_id;
     const std::string& episode_title = episode.title;
     int episode_num = episode.episode;
     
@@ -2219,122 +3086,214 @@ static void play_episode_by_index(MadariWindow *self, int index) {
     
     // Update current index
     self->current_episode_index = index;
+    self->current_episode_number = episode_num;
     update_episode_nav_buttons(self);
     
     // Update the current video ID
     if (self->current_video_id) delete self->current_video_id;
-    self->current_video_id = new std::string(video_id);
+    self->current_video_id = new std::string(episode.video_id);
     
-    // Show loading
+    *self->player_current_title = full_title;
+    
+    return full_title;
+}
+
+/**
+ * Reset the progress widgets before a different file starts playing.
+ */
+static void reset_player_progress(MadariWindow *self, const std::string& title) {
+    self->player_duration = 0;
+    self->player_position = 0;
+    gtk_range_set_value(GTK_RANGE(self->player_progress), 0);
+    gtk_range_set_range(GTK_RANGE(self->player_progress), 0, 100);
+    gtk_label_set_text(self->player_time_label, "0:00");
+    gtk_label_set_text(self->player_duration_label, "0:00");
+    
+    // Update title
+    gtk_label_set_text(self->player_title_label, title.c_str());
+    
+    // Show loading spinner
     gtk_widget_set_visible(self->player_loading, TRUE);
+}
+
+static void play_episode_by_index(MadariWindow *self, int index) {
+    if (!self->episode_list || index < 0 || index >= (int)self->episode_list->size()) {
+        return;
+    }
     
-    // Get addon service
-    Stremio::AddonService *service = madari_application_get_addon_service(self->app);
-    if (!service || !self->current_meta_type) {
-        gtk_widget_set_visible(self->player_loading, FALSE);
-        show_episode_streams_dialog(self, video_id, full_title);
+    // Trakt: Stop scrobble for current episode before switching
+    if (self->scrobble_started) {
+        trigger_scrobble(self, "stop");
+        self->scrobble_started = FALSE;
+    }
+    
+    // Next episode is already queued (and probably buffered) - just advance
+    if (index == self->prefetched_episode_index && self->mpv) {
+        if (self->history_needs_save) {
+            save_watch_progress(self);
+        }
+        // A new file for the prefetch to look ahead from
+        self->prefetched_episode_index = -1;
+        self->next_episode_resolving = FALSE;
+        self->playback_generation++;
+        player_promote_queued_source(self);
+        reset_player_progress(self, apply_episode_context(self, index));
+        const char *cmd[] = {"playlist-next", "force", nullptr};
+        mpv_command_async(self->mpv, 0, cmd);
         return;
     }
     
-    // Store data for callback
-    struct EpisodeData {
-        MadariWindow *window;
-        std::string video_id;
-        std::string full_title;  // Full formatted title
-        std::string binge_group;
-        bool found_match = false;
-    };
+    const std::string video_id = (*self->episode_list)[index].video_id;
+    std::string full_title = apply_episode_context(self, index);
     
-    EpisodeData *data = new EpisodeData{
-        self, 
-        video_id, 
-        full_title,
-        self->current_binge_group ? *self->current_binge_group : "",
-        false
-    };
+    // Switching elsewhere: drop the queued next episode and any lookup for it
+    if (self->prefetched_episode_index >= 0 && self->mpv) {
+        const char *cmd[] = {"playlist-clear", nullptr};
+        mpv_command_async(self->mpv, 0, cmd);
+    }
+    self->prefetched_episode_index = -1;
+    self->next_episode_resolving = FALSE;
+    player_clear_queued_source(self);
+    guint generation = ++self->playback_generation;
     
-    // Fetch streams for the episode
-    service->fetch_all_streams(
-        *self->current_meta_type,
-        video_id,
-        [data]([[maybe_unused]] const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
-            MadariWindow *self = data->window;
+    // Show loading
+    gtk_widget_set_visible(self->player_loading, TRUE);
+    
+    resolve_binge_stream(self, video_id,
+        self->current_binge_group ? *self->current_binge_group : "",
+        [self, video_id, full_title, generation](std::optional<BingeMatch> match) {
+            // The user moved on to another episode meanwhile
+            if (generation != self->playback_generation) return;
             
-            // If we have a binge_group, try to find matching stream
-            if (!data->binge_group.empty()) {
-                for (const auto& stream : streams) {
-                    if (stream.behavior_hints.binge_group.has_value() &&
-                        *stream.behavior_hints.binge_group == data->binge_group) {
-                        // Found matching stream! Get URL and play
-                        std::string stream_url;
-                        if (stream.url.has_value()) {
-                            stream_url = *stream.url;
-                        } else if (stream.info_hash.has_value()) {
-                            // Build magnet URL for torrent
-                            stream_url = "magnet:?xt=urn:btih:" + *stream.info_hash;
-                            for (const auto& src : stream.sources) {
-                                stream_url += "&tr=" + src;
-                            }
-                        }
-                        
-                        if (!stream_url.empty()) {
-                            // Play directly
-                            if (self->mpv) {
-                                // Reset player state
-                                self->player_duration = 0;
-                                self->player_position = 0;
-                                gtk_range_set_value(GTK_RANGE(self->player_progress), 0);
-                                gtk_range_set_range(GTK_RANGE(self->player_progress), 0, 100);
-                                gtk_label_set_text(self->player_time_label, "0:00");
-                                gtk_label_set_text(self->player_duration_label, "0:00");
-                                
-                                // Update title
-                                gtk_label_set_text(self->player_title_label, data->full_title.c_str());
-                                
-                                // Show loading spinner
-                                gtk_widget_set_visible(self->player_loading, TRUE);
-                                
-                                // Load the new file - use loadfile with replace mode
-                                const char *cmd[] = {"loadfile", stream_url.c_str(), "replace", nullptr};
-                                mpv_command_async(self->mpv, 0, cmd);
-                            }
-                            
-                            data->found_match = true;
-                            return;
-                        }
-                    }
-                }
+            if (!match) {
+                // No match, show stream selector
+                gtk_widget_set_visible(self->player_loading, FALSE);
+                show_episode_streams_dialog(self, video_id, full_title);
+                return;
             }
-        },
-        [data]() {
-            // Done callback - if no match found, show stream selector
-            if (!data->found_match) {
-                gtk_widget_set_visible(data->window->player_loading, FALSE);
-                show_episode_streams_dialog(data->window, data->video_id, data->full_title);
+            
+            // Play directly
+            if (self->mpv) {
+                reset_player_progress(self, full_title);
+                
+                // Load the new file - use loadfile with replace mode
+                player_set_source(self, match->addon_id.c_str(), match->url,
+                                  self->current_binge_group ? self->current_binge_group->c_str() : nullptr);
+                player_loadfile(self, match->url.c_str(), "replace", nullptr);
             }
-            delete data;
-        }
-    );
+        });
+}
+
+// ============= Gapless Next Episode =============
+
+// How long before the end of an episode the next one gets resolved and queued
+static const double NEXT_EPISODE_PREFETCH_SECONDS = 120.0;
+
+/**
+ * Called on every time-pos update. Near the end of an episode, resolve the
+ * next episode's stream in the background (same binge group as the current
+ * one) and append it to mpv's playlist. With prefetch-playlist enabled mpv
+ * opens and buffers it ahead of time, so EOF becomes a playlist advance
+ * instead of a full loadfile/replace.
+ */
+static void maybe_prefetch_next_episode(MadariWindow *self) {
+    if (!self->episode_list || !self->current_meta_type || !self->current_binge_group) return;
+    if (self->prefetched_episode_index >= 0 || self->next_episode_resolving) return;
+    if (self->player_duration <= 0) return;
+    if (self->player_duration - self->player_position > NEXT_EPISODE_PREFETCH_SECONDS) return;
+    
+    int next_index = self->current_episode_index + 1;
+    if (self->current_episode_index < 0 || next_index >= (int)self->episode_list->size()) return;
+    
+    Stremio::AddonService *service = madari_application_get_addon_service(self->app);
+    if (!service) return;
+    
+    self->next_episode_resolving = TRUE;
+    guint generation = self->playback_generation;
+    
+    resolve_binge_stream(self, (*self->episode_list)[next_index].video_id, *self->current_binge_group,
+        [self, next_index, generation](std::optional<BingeMatch> match) {
+            // Ignore results once something else started playing
+            if (generation != self->playback_generation) return;
+            
+            // Without a binge match we fall back to the regular flow at EOF
+            if (!match || !self->mpv) return;
+            
+            player_loadfile(self, match->url.c_str(), "append", nullptr);
+            self->prefetched_episode_index = next_index;
+            player_clear_queued_source(self);
+            self->queued_source = new Madari::PlaybackSource{
+                match->addon_id, match->url,
+                self->current_binge_group ? *self->current_binge_group : ""};
+        });
+}
+
+/**
+ * mpv finished the current episode and is moving on to the queued one.
+ * Close out history and scrobbling for the old episode and switch context.
+ */
+static void advance_to_prefetched_episode(MadariWindow *self) {
+    int index = self->prefetched_episode_index;
+    self->prefetched_episode_index = -1;
+    self->next_episode_resolving = FALSE;
+    if (!self->episode_list || index < 0 || index >= (int)self->episode_list->size()) return;
+    
+    // Mark the finished episode as fully watched
+    self->player_position = self->player_duration;
+    save_watch_progress(self);
+    
+    // Trakt: Video ended - send stop scrobble with 100% progress; the next
+    // file's FILE_LOADED starts a new scrobble
+    if (self->scrobble_started) {
+        trigger_scrobble(self, "stop");
+        self->scrobble_started = FALSE;
+    }
+    
+    player_promote_queued_source(self);
+    reset_player_progress(self, apply_episode_context(self, index));
+    self->player_load_started = g_get_monotonic_time();
+    self->player_first_frame_pending = TRUE;
 }
 
 // StreamsData struct for episode stream dialog
 struct EpisodeStreamsData {
     MadariWindow *window;
     GtkWidget *loading_box;
-    GtkListBox *streams_list;
+    MadariStreamList *stream_list;
     AdwDialog *dialog;
     std::string *episode_title;
+    Stremio::StreamRanker *ranker;
 };
 
-static void on_episode_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpointer user_data) {
-    const std::string *url = static_cast<const std::string*>(
-        g_object_get_data(G_OBJECT(btn), "stream-url"));
-    const std::string *title = static_cast<const std::string*>(
-        g_object_get_data(G_OBJECT(btn), "stream-title"));
-    const std::string *binge = static_cast<const std::string*>(
-        g_object_get_data(G_OBJECT(btn), "binge-group"));
-    EpisodeStreamsData *sdata = static_cast<EpisodeStreamsData*>(
-        g_object_get_data(G_OBJECT(btn), "streams-data"));
+// Best ranked streams first, whichever addon answered first
+static int compare_ranked_stream_rows(GtkListBoxRow *a, GtkListBoxRow *b, [[maybe_unused]] gpointer user_data) {
+    int score_a = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(a), "rank-score"));
+    int score_b = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(b), "rank-score"));
+    if (score_a != score_b) {
+        return score_b - score_a;
+    }
+    return GPOINTER_TO_INT(g_object_get_data(G_OBJECT(a), "rank-arrival")) -
+           GPOINTER_TO_INT(g_object_get_data(G_OBJECT(b), "rank-arrival"));
+}
+
+// Sources that played well before rise, ones that kept failing sink
+static void apply_source_preference(MadariWindow *self, Stremio::StreamRanker *ranker) {
+    Madari::SourceStatsService *stats = get_source_stats(self);
+    if (!stats) return;
+    ranker->set_preference([stats](const std::string& addon_id, const Stremio::Stream& stream) {
+        return stats->preference(addon_id, stream);
+    });
+}
+
+static void set_row_rank(GtkWidget *row, const Stremio::RankedStream *ranked) {
+    g_object_set_data(G_OBJECT(row), "rank-score", GINT_TO_POINTER(static_cast<int>(ranked->score * 100)));
+    g_object_set_data(G_OBJECT(row), "rank-arrival", GINT_TO_POINTER(static_cast<int>(ranked->arrival)));
+}
+
+static void play_episode_stream_item(EpisodeStreamsData *sdata, MadariStreamItem *item) {
+    const Stremio::RankedStream& ranked = madari_stream_item_get_ranked(item);
+    std::optional<std::string> url = stream_playback_url(ranked.stream);
+    const std::optional<std::string>& binge = ranked.stream.behavior_hints.binge_group;
     
     if (url && sdata && sdata->window) {
         MadariWindow *window = sdata->window;
@@ -2347,12 +3306,9 @@ static void on_episode_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpoi
         
         // Update title
         std::string full_title = sdata->episode_title ? 
-            *sdata->episode_title : (title ? *title : "Playing");
+            *sdata->episode_title : madari_stream_item_get_title(item);
         gtk_label_set_text(window->player_title_label, full_title.c_str());
         
-        // Close dialog
-        adw_dialog_close(sdata->dialog);
-        
         // Play
         if (window->mpv) {
             // Reset player state
@@ -2366,9 +3322,12 @@ static void on_episode_stream_play_clicked(GtkButton *btn, [[maybe_unused]] gpoi
             // Show loading spinner
             gtk_widget_set_visible(window->player_loading, TRUE);
             
-            const char *cmd[] = {"loadfile", url->c_str(), "replace", nullptr};
-            mpv_command_async(window->mpv, 0, cmd);
+            player_set_source(window, ranked.addon_id.c_str(), *url, binge ? binge->c_str() : nullptr);
+            player_loadfile(window, url->c_str(), "replace", nullptr);
         }
+        
+        // Close dialog last, it owns sdata
+        adw_dialog_close(sdata->dialog);
     }
 }
 
@@ -2385,9 +3344,6 @@ static void show_episode_streams_dialog(MadariWindow *self, const std::string& v
     GtkWidget *header = adw_header_bar_new();
     adw_toolbar_view_add_top_bar(ADW_TOOLBAR_VIEW(toolbar_view), header);
     
-    GtkWidget *scroll = gtk_scrolled_window_new();
-    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroll), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
-    
     GtkWidget *content_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 8);
     gtk_widget_set_margin_start(content_box, 16);
     gtk_widget_set_margin_end(content_box, 16);
@@ -2411,24 +3367,29 @@ static void show_episode_streams_dialog(MadariWindow *self, const std::string& v
     
     gtk_box_append(GTK_BOX(content_box), loading_box);
     
-    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroll), content_box);
-    adw_toolbar_view_set_content(ADW_TOOLBAR_VIEW(toolbar_view), scroll);
+    // The stream list scrolls on its own so only visible rows get widgets
+    adw_toolbar_view_set_content(ADW_TOOLBAR_VIEW(toolbar_view), content_box);
     adw_dialog_set_child(dialog, toolbar_view);
     
-    // Streams list
-    GtkWidget *streams_list = gtk_list_box_new();
-    gtk_list_box_set_selection_mode(GTK_LIST_BOX(streams_list), GTK_SELECTION_NONE);
-    gtk_widget_add_css_class(streams_list, "boxed-list");
-    gtk_widget_set_visible(streams_list, FALSE);
-    gtk_box_append(GTK_BOX(content_box), streams_list);
-    
     std::string *title_copy = new std::string(episode_title);
-    EpisodeStreamsData *data = new EpisodeStreamsData{self, loading_box, GTK_LIST_BOX(streams_list), dialog, title_copy};
+    EpisodeStreamsData *data = new EpisodeStreamsData{self, loading_box, nullptr, dialog, title_copy,
+                                                      new Stremio::StreamRanker()};
+    apply_source_preference(self, data->ranker);
+    
+    // Streams list
+    data->stream_list = madari_stream_list_new([data](MadariStreamItem *item) {
+        play_episode_stream_item(data, item);
+    });
+    gtk_widget_set_visible(data->stream_list->scroll, FALSE);
+    gtk_box_append(GTK_BOX(content_box), data->stream_list->scroll);
     
     g_object_set_data_full(G_OBJECT(dialog), "streams-data", data,
         (GDestroyNotify)+[](gpointer d) { 
             EpisodeStreamsData *sd = static_cast<EpisodeStreamsData*>(d);
             delete sd->episode_title;
+            // Items point into the ranker
+            madari_stream_list_free(sd->stream_list);
+            delete sd->ranker;
             delete sd; 
         });
     
@@ -2440,94 +3401,25 @@ static void show_episode_streams_dialog(MadariWindow *self, const std::string& v
             video_id,
             [data](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
                 gtk_widget_set_visible(data->loading_box, FALSE);
-                gtk_widget_set_visible(GTK_WIDGET(data->streams_list), TRUE);
+                gtk_widget_set_visible(data->stream_list->scroll, TRUE);
                 
-                for (const auto& stream : streams) {
-                    GtkWidget *row = adw_action_row_new();
-                    
-                    // Build stream title
-                    std::string title;
-                    if (stream.name.has_value() && !stream.name->empty()) {
-                        title = *stream.name;
-                        size_t pos;
-                        while ((pos = title.find('\n')) != std::string::npos) {
-                            title.replace(pos, 1, " • ");
-                        }
-                    } else if (stream.title.has_value() && !stream.title->empty()) {
-                        title = *stream.title;
-                    } else {
-                        title = "Stream";
-                    }
-                    
-                    gchar *escaped_title = g_markup_escape_text(title.c_str(), -1);
-                    adw_preferences_row_set_title(ADW_PREFERENCES_ROW(row), escaped_title);
-                    g_free(escaped_title);
-                    
-                    // Subtitle
-                    std::string subtitle = addon.name;
-                    if (stream.description.has_value() && !stream.description->empty()) {
-                        subtitle = *stream.description + "\n" + subtitle;
-                    }
-                    gchar *escaped_subtitle = g_markup_escape_text(subtitle.c_str(), -1);
-                    adw_action_row_set_subtitle(ADW_ACTION_ROW(row), escaped_subtitle);
-                    g_free(escaped_subtitle);
-                    adw_action_row_set_subtitle_lines(ADW_ACTION_ROW(row), 3);
-                    
-                    // Play button
-                    GtkWidget *play_btn = gtk_button_new_from_icon_name("media-playback-start-symbolic");
-                    gtk_widget_add_css_class(play_btn, "flat");
-                    gtk_widget_set_valign(play_btn, GTK_ALIGN_CENTER);
-                    
-                    // Get stream URL
-                    std::string *stream_url = nullptr;
-                    std::string *binge_group = nullptr;
-                    
-                    if (stream.url.has_value()) {
-                        stream_url = new std::string(*stream.url);
-                    } else if (stream.info_hash.has_value()) {
-                        std::string magnet = "magnet:?xt=urn:btih:" + *stream.info_hash;
-                        for (const auto& src : stream.sources) {
-                            magnet += "&tr=" + src;
-                        }
-                        stream_url = new std::string(magnet);
-                    }
-                    
-                    if (stream.behavior_hints.binge_group.has_value()) {
-                        binge_group = new std::string(*stream.behavior_hints.binge_group);
-                    }
-                    
-                    if (stream_url) {
-                        g_object_set_data_full(G_OBJECT(play_btn), "stream-url", stream_url,
-                            (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
-                        g_object_set_data_full(G_OBJECT(play_btn), "stream-title", 
-                            new std::string(title),
-                            (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
-                        if (binge_group) {
-                            g_object_set_data_full(G_OBJECT(play_btn), "binge-group", binge_group,
-                                (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
-                        }
-                        g_object_set_data(G_OBJECT(play_btn), "streams-data", data);
-                        
-                        g_signal_connect(play_btn, "clicked", 
-                            G_CALLBACK(on_episode_stream_play_clicked), nullptr);
-                    }
-                    
-                    adw_action_row_add_suffix(ADW_ACTION_ROW(row), play_btn);
-                    adw_action_row_set_activatable_widget(ADW_ACTION_ROW(row), play_btn);
+                // Streams another addon already offered are folded away
+                std::vector<const Stremio::RankedStream*> folded;
+                auto added = data->ranker->add_batch(addon, streams, &folded);
+                madari_stream_list_append(data->stream_list, added, folded);
+            },
+            [data, content_box]() {
+                // Show empty state if no addon had streams
+                if (madari_stream_list_get_n_items(data->stream_list) == 0) {
+                    gtk_widget_set_visible(data->loading_box, FALSE);
                     
-                    gtk_list_box_append(data->streams_list, row);
-                }
-                
-                // Show empty state if no streams
-                if (streams.empty()) {
                     GtkWidget *empty = adw_status_page_new();
                     adw_status_page_set_icon_name(ADW_STATUS_PAGE(empty), "media-playback-stop-symbolic");
                     adw_status_page_set_title(ADW_STATUS_PAGE(empty), "No Streams Found");
                     gtk_widget_set_vexpand(empty, TRUE);
-                    gtk_box_append(GTK_BOX(gtk_widget_get_parent(GTK_WIDGET(data->streams_list))), empty);
+                    gtk_box_append(GTK_BOX(content_box), empty);
                 }
-            },
-            []() { /* done callback */ }
+            }
         );
     }
     
@@ -3146,6 +4038,7 @@ static void on_resume_stream_play(GtkButton *btn, gpointer user_data) {
         g_object_get_data(G_OBJECT(btn), "stream-url"));
     const std::string *binge = static_cast<const std::string*>(
         g_object_get_data(G_OBJECT(btn), "binge-group"));
+    const char *addon_id = static_cast<const char*>(g_object_get_data(G_OBJECT(btn), "addon-id"));
     gboolean from_start = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(btn), "from-start"));
     
     if (!url || !data) return;
@@ -3182,55 +4075,25 @@ static void on_resume_stream_play(GtkButton *btn, gpointer user_data) {
     // Build title
     std::string title = entry.title;
     
-    // Play video
-    madari_window_play_video(window, url->c_str(), title.c_str());
-    
-    // Seek to resume position if not starting from beginning
+    // Resume point is handed to mpv as the per-file start option so the
+    // demuxer opens there directly instead of playing from zero and seeking
+    std::string start;
     if (!from_start) {
+        char buf[G_ASCII_DTOSTR_BUF_SIZE];
         if (data->use_percent && data->resume_percent > 1.0) {
-            // Percentage-based seeking (for Trakt items)
-            // Store percentage and seek after we know the duration
-            double *seek_pct = new double(data->resume_percent);
-            g_object_set_data_full(G_OBJECT(window), "pending-seek-percent", seek_pct,
-                [](gpointer d) { delete static_cast<double*>(d); });
-            
-            // Wait for file to load and get duration, then seek
-            g_timeout_add(1000, [](gpointer user_data) -> gboolean {
-                MadariWindow *window = MADARI_WINDOW(user_data);
-                double *pct = static_cast<double*>(g_object_get_data(G_OBJECT(window), "pending-seek-percent"));
-                if (pct && window->mpv) {
-                    // Get duration
-                    double duration = 0;
-                    mpv_get_property(window->mpv, "duration", MPV_FORMAT_DOUBLE, &duration);
-                    if (duration > 0) {
-                        double pos = (duration * (*pct)) / 100.0;
-                        mpv_set_property_async(window->mpv, 0, "time-pos", MPV_FORMAT_DOUBLE, &pos);
-                        g_object_set_data(G_OBJECT(window), "pending-seek-percent", nullptr);
-                    } else {
-                        // Duration not ready yet, retry
-                        return G_SOURCE_CONTINUE;
-                    }
-                }
-                return G_SOURCE_REMOVE;
-            }, window);
+            // Percentage-based resume (for Trakt items)
+            start = std::string(g_ascii_formatd(buf, sizeof(buf), "%.3f", data->resume_percent)) + "%";
         } else if (data->resume_position > 30) {
-            // Time-based seeking (for local items)
-            double *seek_pos = new double(data->resume_position);
-            g_object_set_data_full(G_OBJECT(window), "pending-seek", seek_pos,
-                [](gpointer d) { delete static_cast<double*>(d); });
-            
-            // Wait a bit for the file to load then seek
-            g_timeout_add(500, [](gpointer user_data) -> gboolean {
-                MadariWindow *window = MADARI_WINDOW(user_data);
-                double *pos = static_cast<double*>(g_object_get_data(G_OBJECT(window), "pending-seek"));
-                if (pos && window->mpv) {
-                    mpv_set_property_async(window->mpv, 0, "time-pos", MPV_FORMAT_DOUBLE, pos);
-                    g_object_set_data(G_OBJECT(window), "pending-seek", nullptr);
-                }
-                return G_SOURCE_REMOVE;
-            }, window);
+            // Time-based resume (for local items)
+            start = g_ascii_formatd(buf, sizeof(buf), "%.3f", data->resume_position);
         }
     }
+    
+    // Play video
+    player_set_source(window, addon_id, *url,
+                      window->current_binge_group ? window->current_binge_group->c_str() : nullptr);
+    madari_window_play_video(window, url->c_str(), title.c_str(),
+                             start.empty() ? nullptr : start.c_str());
 }
 
 static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEntry& entry) {
@@ -3299,6 +4162,7 @@ static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEnt
     gtk_list_box_set_selection_mode(GTK_LIST_BOX(streams_list), GTK_SELECTION_NONE);
     gtk_widget_add_css_class(streams_list, "boxed-list");
     gtk_widget_set_visible(streams_list, FALSE);
+    gtk_list_box_set_sort_func(GTK_LIST_BOX(streams_list), compare_ranked_stream_rows, nullptr, nullptr);
     gtk_box_append(GTK_BOX(content_box), streams_list);
     
     gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroll), content_box);
@@ -3322,15 +4186,19 @@ static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEnt
     // Fetch streams for the video
     Stremio::AddonService *service = madari_application_get_addon_service(self->app);
     if (service) {
+        auto ranker = std::make_shared<Stremio::StreamRanker>();
+        apply_source_preference(self, ranker.get());
         service->fetch_all_streams(
             entry.meta_type,
             entry.video_id,
-            [data, loading_box, streams_list](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
+            [data, loading_box, streams_list, ranker](const Stremio::Manifest& addon, const std::vector<Stremio::Stream>& streams) {
                 gtk_widget_set_visible(loading_box, FALSE);
                 gtk_widget_set_visible(streams_list, TRUE);
                 
-                for (const auto& stream : streams) {
+                for (const Stremio::RankedStream *ranked : ranker->add_batch(addon, streams)) {
+                    const Stremio::Stream& stream = ranked->stream;
                     GtkWidget *row = adw_action_row_new();
+                    set_row_rank(row, ranked);
                     
                     // Build stream title - prefer name, then title (matches detail_view.cpp)
                     std::string title;
@@ -3377,6 +4245,10 @@ static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEnt
                         subtitle = details;
                     }
                     subtitle += (subtitle.empty() ? "" : "\n") + addon.name;
+                    std::string traits = Stremio::StreamRanker::describe(ranked->traits);
+                    if (!traits.empty()) {
+                        subtitle += "\n" + traits;
+                    }
                     
                     gchar *escaped_subtitle = g_markup_escape_text(subtitle.c_str(), -1);
                     adw_action_row_set_subtitle(ADW_ACTION_ROW(row), escaped_subtitle);
@@ -3440,6 +4312,7 @@ static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEnt
                                 new std::string(*binge_group),
                                 (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
                         }
+                        g_object_set_data_full(G_OBJECT(resume_btn), "addon-id", g_strdup(addon.id.c_str()), g_free);
                         g_object_set_data(G_OBJECT(resume_btn), "from-start", GINT_TO_POINTER(FALSE));
                         g_signal_connect(resume_btn, "clicked", G_CALLBACK(on_resume_stream_play), data);
                     }
@@ -3458,6 +4331,7 @@ static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEnt
                                 new std::string(*binge_group),
                                 (GDestroyNotify)+[](gpointer d) { delete static_cast<std::string*>(d); });
                         }
+                        g_object_set_data_full(G_OBJECT(start_btn), "addon-id", g_strdup(addon.id.c_str()), g_free);
                         g_object_set_data(G_OBJECT(start_btn), "from-start", GINT_TO_POINTER(TRUE));
                         g_signal_connect(start_btn, "clicked", G_CALLBACK(on_resume_stream_play), data);
                     }
@@ -3490,14 +4364,9 @@ static void show_resume_dialog(MadariWindow *self, const Madari::WatchHistoryEnt
 
 // ============= End Resume Dialog =============
 
-void madari_window_play_video(MadariWindow *self, const char *url, const char *title) {
-    g_print("madari_window_play_video called\n");
-    g_print("  player_page=%p\n", (void*)self->player_page);
-    
+void madari_window_play_video(MadariWindow *self, const char *url, const char *title, const char *start) {
     if (!self->player_page) {
-        g_print("  Creating player UI...\n");
         create_player_ui(self);
-        g_print("  Player UI created, player_page=%p\n", (void*)self->player_page);
     }
     
     *self->player_current_title = title ? title : "Playing";
@@ -3509,65 +4378,40 @@ void madari_window_play_video(MadariWindow *self, const char *url, const char *t
     self->player_is_playing = FALSE;
     update_player_ui(self);
     
-    // Store URL for playback
+    // Store URL and resume point for playback
     g_object_set_data_full(G_OBJECT(self), "pending-url", g_strdup(url), g_free);
+    g_object_set_data_full(G_OBJECT(self), "pending-start", g_strdup(start), g_free);
     
     // Show player
-    g_print("  Switching to player view...\n");
-    g_print("  root_stack=%p\n", (void*)self->root_stack);
     gtk_stack_set_visible_child_name(self->root_stack, "player");
-    g_print("  Stack switched\n");
+    
+    // Background catalog refreshes would compete with the stream
+    Madari::CatalogRefresher *refresher = madari_application_get_catalog_refresher(self->app);
+    if (refresher) refresher->set_paused(true);
     
     gtk_widget_set_visible(self->player_loading, TRUE);
     show_player_controls(self);
     schedule_hide_player_controls(self);
     
-    // If MPV is already ready, play immediately, otherwise wait for realize
-    g_print("  mpv=%p, mpv_gl=%p\n", (void*)self->mpv, (void*)self->mpv_gl);
+    MADARI_LOG_DEBUG("player", "play", {"title", *self->player_current_title},
+                     {"ready", self->mpv_gl != nullptr});
+    
+    // If MPV is already ready, play immediately. Otherwise the GL area's
+    // realize handler sets it up and loads the pending URL; this used to be
+    // an idle callback polling for realize, spinning until the first frame.
     if (self->mpv && self->mpv_gl) {
-        g_print("  Starting playback immediately...\n");
-        const char *cmd[] = {"loadfile", url, nullptr};
-        mpv_command_async(self->mpv, 0, cmd);
-        g_object_set_data(G_OBJECT(self), "pending-url", nullptr);
-    } else {
-        // Wait for the widget to be mapped and realized, then initialize
-        g_print("  MPV not ready, scheduling initialization...\n");
-        g_idle_add([](gpointer data) -> gboolean {
-            MadariWindow *self = MADARI_WINDOW(data);
-            g_print("Idle callback: checking video_area state\n");
-            g_print("  realized=%d, mapped=%d\n", 
-                    gtk_widget_get_realized(GTK_WIDGET(self->video_area)),
-                    gtk_widget_get_mapped(GTK_WIDGET(self->video_area)));
-            
-            if (!gtk_widget_get_realized(GTK_WIDGET(self->video_area))) {
-                g_print("  Not realized yet, waiting...\n");
-                return G_SOURCE_CONTINUE;
-            }
-            
-            // Widget is realized, try to initialize MPV
-            if (!self->mpv || !self->mpv_gl) {
-                g_print("  Calling on_video_realize...\n");
-                on_video_realize(GTK_WIDGET(self->video_area), self);
-            }
-            
-            // Check if we have a pending URL to play
-            const char *pending_url = static_cast<const char*>(g_object_get_data(G_OBJECT(self), "pending-url"));
-            if (pending_url && self->mpv && self->mpv_gl) {
-                g_print("  Playing pending URL: %s\n", pending_url);
-                const char *cmd[] = {"loadfile", pending_url, nullptr};
-                mpv_command_async(self->mpv, 0, cmd);
-                g_object_set_data(G_OBJECT(self), "pending-url", nullptr);
-            }
-            
-            return G_SOURCE_REMOVE;
-        }, self);
+        player_load_pending(self);
+    } else if (gtk_widget_get_realized(GTK_WIDGET(self->video_area))) {
+        // Realized earlier but MPV isn't set up yet; realize won't fire again
+        on_video_realize(GTK_WIDGET(self->video_area), self);
     }
 }
 
 void madari_window_play_episode(MadariWindow *self, const char *url, const char *title,
                                  const char *meta_id, const char *meta_type,
                                  const char *video_id, const char *binge_group,
-                                 const char *poster_url, int episode_num) {
+                                 const char *poster_url, int episode_num,
+                                 const char *addon_id) {
     // Store episode context for episode navigation
     if (self->current_meta_id) delete self->current_meta_id;
     if (self->current_meta_type) delete self->current_meta_type;
@@ -3590,6 +4434,7 @@ void madari_window_play_episode(MadariWindow *self, const char *url, const char
     update_episode_nav_buttons(self);
     
     // Play the video
+    player_set_source(self, addon_id, url ? url : "", binge_group);
     madari_window_play_video(self, url, title);
 }
 
@@ -3634,6 +4479,13 @@ void madari_window_stop_video(MadariWindow *self) {
         mpv_command_async(self->mpv, 0, cmd);
     }
     
+    // "stop" also clears the playlist, drop any queued next episode
+    self->playback_generation++;
+    self->prefetched_episode_index = -1;
+    self->next_episode_resolving = FALSE;
+    player_clear_queued_source(self);
+    player_finish_source(self);
+    
     // Clear track lists
     if (self->audio_tracks) self->audio_tracks->clear();
     if (self->subtitle_tracks) self->subtitle_tracks->clear();
@@ -3695,6 +4547,10 @@ void madari_window_stop_video(MadariWindow *self) {
     // Switch back to browse view
     gtk_stack_set_visible_child_name(self->root_stack, "browse");
     
+    Madari::CatalogRefresher *refresher = madari_application_get_catalog_refresher(self->app);
+    if (refresher) refresher->set_paused(false);
+    restore_visible_images(self);
+    
     // Refresh catalogs to update Continue Watching section
     load_catalogs(self);
 }
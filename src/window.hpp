@@ -6,6 +6,8 @@
 #include <utility>
 #include "application.hpp"
 
+namespace Stremio { struct MetaPreview; }
+
 G_BEGIN_DECLS
 
 #define MADARI_TYPE_WINDOW (madari_window_get_type())
@@ -18,12 +20,23 @@ void madari_window_refresh_catalogs(MadariWindow *self);
 
 void madari_window_show_detail(MadariWindow *self, const char *meta_id, const char *meta_type);
 
+// Push the full-catalog grid page for one addon catalog
+void madari_window_show_catalog(MadariWindow *self, const char *addon_id, const char *type,
+                                const char *catalog_id, const char *title);
+
+// Empty poster card as used in the home rows (click opens details, hover
+// prefetches); set_meta fills it and may be called again to reuse it
+GtkWidget *madari_window_poster_new(void);
+void madari_window_poster_set_meta(GtkWidget *poster, const Stremio::MetaPreview& meta);
+
 // Player functions
-void madari_window_play_video(MadariWindow *self, const char *url, const char *title);
+void madari_window_play_video(MadariWindow *self, const char *url, const char *title,
+                              const char *start = nullptr);
 void madari_window_play_episode(MadariWindow *self, const char *url, const char *title, 
                                  const char *meta_id, const char *meta_type,
                                  const char *video_id, const char *binge_group,
-                                 const char *poster_url = nullptr, int episode_num = 0);
+                                 const char *poster_url = nullptr, int episode_num = 0,
+                                 const char *addon_id = nullptr);
 // EpisodeInfo structure for episode navigation
 struct MadariEpisodeInfo {
     std::string video_id;
@@ -37,6 +50,13 @@ void madari_window_set_episode_list(MadariWindow *self,
                                      const char *series_title,
                                      int season);
 void madari_window_stop_video(MadariWindow *self);
+
+// Drop the textures of pages and home rows that are not on screen (low
+// memory); they reload when shown again. Returns approximate bytes released.
+gsize madari_window_release_hidden_images(MadariWindow *self);
+
+// Bytes in the player's demuxer cache, -1 when nothing is loaded
+gint64 madari_window_get_demuxer_cache_bytes(MadariWindow *self);
 gboolean madari_window_is_playing(MadariWindow *self);
 
 G_END_DECLS